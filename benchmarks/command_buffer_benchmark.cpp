@@ -0,0 +1,102 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "command_buffer.h"
+#include "core/JobSystem.h"
+#include "gl_context.h"
+#include "scene.h"
+#include "shader/std140.h"
+#include "uniform_ring.h"
+
+namespace
+{
+    constexpr std::size_t kBuffers = 16;
+    constexpr std::size_t kDrawsPerBuffer = 512;
+
+    struct PerDraw
+    {
+        glm::mat4 transform;
+        glm::vec4 color;
+    };
+    STD140_ASSERT(PerDraw, STD140_FIELD(PerDraw, transform), STD140_FIELD(PerDraw, color));
+
+    void record(CommandBuffer& commands, const std::size_t buffer)
+    {
+        const BenchmarkScene& scene = BenchmarkScene::get();
+
+        commands.reset();
+        commands.bindProgram(scene.programs[buffer % BenchmarkScene::kPrograms]);
+        commands.bindGeometry(scene.arena);
+        for (std::size_t i = 0; i < kDrawsPerBuffer; ++i)
+        {
+            const float   offset = static_cast<float>(i) / kDrawsPerBuffer;
+            const PerDraw perDraw {glm::mat4(offset), glm::vec4(offset, 0.5f, 1.0f - offset, 1.0f)};
+            commands.setUniforms(0, &perDraw, sizeof(perDraw));
+            commands.draw(scene.quad);
+        }
+    }
+
+    /**
+     * A frame of kBuffers command buffers recorded in parallel on 1..16
+     * threads, then replayed in order on this thread. record_ms and
+     * replay_ms split the frame; only the recording side can scale.
+     */
+    void BM_CommandBufferRecordReplay(benchmark::State& state)
+    {
+        if (!requireGLContext(state))
+        {
+            return;
+        }
+        BenchmarkScene::get();
+
+        Core::JobSystemConfig config;
+        config.workerThreads = static_cast<int>(state.range(0)) - 1;
+        Core::JobSystem jobs(config);
+
+        std::vector<CommandBuffer>  buffers(kBuffers);
+        std::vector<CommandBuffer*> ordered;
+        for (CommandBuffer& buffer : buffers)
+        {
+            ordered.push_back(&buffer);
+        }
+        UniformRing ring(kBuffers * kDrawsPerBuffer * 256);
+
+        using Clock = std::chrono::steady_clock;
+        double recordMs = 0.0;
+        double replayMs = 0.0;
+        for (auto _ : state)
+        {
+            const Clock::time_point start = Clock::now();
+            jobs.parallelFor(0, kBuffers,
+                             [&](const std::size_t first, const std::size_t last)
+                             {
+                                 for (std::size_t i = first; i < last; ++i)
+                                 {
+                                     record(buffers[i], i);
+                                 }
+                             });
+            const Clock::time_point recorded = Clock::now();
+
+            ring.beginFrame();
+            const CommandBuffer::Stats stats = CommandBuffer::execute(ordered, &ring);
+            ring.endFrame();
+            benchmark::DoNotOptimize(stats);
+            const Clock::time_point replayed = Clock::now();
+
+            recordMs += std::chrono::duration<double, std::milli>(recorded - start).count();
+            replayMs += std::chrono::duration<double, std::milli>(replayed - recorded).count();
+        }
+        glFinish();
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kBuffers * kDrawsPerBuffer));
+        state.counters["record_ms"] = benchmark::Counter(recordMs, benchmark::Counter::kAvgIterations);
+        state.counters["replay_ms"] = benchmark::Counter(replayMs, benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_CommandBufferRecordReplay)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+} // namespace
@@ -0,0 +1,118 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+#include "core/JobSystem.h"
+
+namespace
+{
+    // Thread counts include the calling thread; past the hardware thread
+    // count the numbers only show oversubscription
+    Core::JobSystemConfig withThreads(const benchmark::State& state)
+    {
+        Core::JobSystemConfig config;
+        config.workerThreads = static_cast<int>(state.range(0)) - 1;
+        return config;
+    }
+
+    /**
+     * Cost of spawning and waiting on a batch of empty jobs, per job.
+     */
+    void BM_SpawnWait(benchmark::State& state)
+    {
+        Core::JobSystem jobs(withThreads(state));
+        const auto      batch = static_cast<int>(state.range(1));
+
+        for (auto _ : state)
+        {
+            Core::JobSystem::Counter counter;
+            for (int i = 0; i < batch; ++i)
+            {
+                jobs.run([] {}, &counter);
+            }
+            jobs.wait(counter);
+        }
+
+        const Core::JobSystem::Stats stats = jobs.getStats();
+        state.SetItemsProcessed(state.iterations() * batch);
+        state.counters["stolen"] = benchmark::Counter(static_cast<double>(stats.stolen) / stats.executed);
+        state.counters["pooled"] = static_cast<double>(stats.pooled);
+    }
+    BENCHMARK(BM_SpawnWait)->ArgsProduct({{1, 2, 4, 8, 16}, {1, 64, 1024}})->UseRealTime();
+
+    /**
+     * A dependent chain: each job is queued with runAfter() on the previous one.
+     */
+    void BM_RunAfterChain(benchmark::State& state)
+    {
+        Core::JobSystem jobs(withThreads(state));
+        constexpr int   kLength = 64;
+
+        for (auto _ : state)
+        {
+            std::vector<Core::JobSystem::Counter> counters(kLength);
+            jobs.run([] {}, &counters[0]);
+            for (int i = 1; i < kLength; ++i)
+            {
+                jobs.runAfter(counters[i - 1], [] {}, &counters[i]);
+            }
+            jobs.wait(counters.back());
+        }
+        state.SetItemsProcessed(state.iterations() * kLength);
+    }
+    BENCHMARK(BM_RunAfterChain)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+    float work(const float value)
+    {
+        return std::sqrt(value) * std::sin(value) + std::cos(value);
+    }
+
+    /**
+     * parallelFor() over a million elements of moderate work; compare the
+     * 1-thread row to BM_SerialBaseline for the fixed overhead and the rows
+     * above it for the scaling.
+     */
+    void BM_ParallelForScaling(benchmark::State& state)
+    {
+        Core::JobSystem    jobs(withThreads(state));
+        std::vector<float> values(1 << 20, 1.5f);
+
+        for (auto _ : state)
+        {
+            jobs.parallelFor(0, values.size(),
+                             [&](const std::size_t first, const std::size_t last)
+                             {
+                                 for (std::size_t i = first; i < last; ++i)
+                                 {
+                                     values[i] = work(values[i]);
+                                 }
+                             },
+                             nullptr, static_cast<std::size_t>(state.range(1)));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+        state.counters["stolen"] = static_cast<double>(jobs.getStats().stolen) / state.iterations();
+    }
+    BENCHMARK(BM_ParallelForScaling)->ArgsProduct({{1, 2, 4, 8, 16}, {256, 4096}})->UseRealTime();
+
+    void BM_SerialBaseline(benchmark::State& state)
+    {
+        std::vector<float> values(1 << 20, 1.5f);
+        for (auto _ : state)
+        {
+            for (float& value : values)
+            {
+                value = work(value);
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_SerialBaseline)->UseRealTime();
+} // namespace
@@ -0,0 +1,109 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "gl_context.h"
+
+#include <iostream>
+
+#include "platform/GLExtensions.h"
+
+#ifdef __linux__
+#    include <EGL/egl.h>
+#    include <EGL/eglext.h>
+#else
+#    include "graphics.h"
+#endif
+
+namespace
+{
+    constexpr GLsizei kFramebufferSize = 64;
+
+    GLADloadproc createContext()
+    {
+#ifdef __linux__
+        EGLDisplay display = EGL_NO_DISPLAY;
+        const auto getPlatformDisplay =
+            reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay)
+        {
+            display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+        if (display == EGL_NO_DISPLAY)
+        {
+            display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        }
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr) || !eglBindAPI(EGL_OPENGL_API))
+        {
+            return nullptr;
+        }
+
+        // Newest core version first; anything from 3.3 runs the fallback paths
+        constexpr EGLint kVersions[][2] = {{4, 6}, {4, 5}, {4, 3}, {4, 1}, {3, 3}};
+        for (const auto& version : kVersions)
+        {
+            const EGLint attributes[] = {EGL_CONTEXT_MAJOR_VERSION,
+                                         version[0],
+                                         EGL_CONTEXT_MINOR_VERSION,
+                                         version[1],
+                                         EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                                         EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                         EGL_NONE};
+            const EGLContext context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attributes);
+            if (context != EGL_NO_CONTEXT && eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+            {
+                return reinterpret_cast<GLADloadproc>(eglGetProcAddress);
+            }
+        }
+        return nullptr;
+#else
+        if (!glfwInit())
+        {
+            return nullptr;
+        }
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#    ifdef __APPLE__
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#    endif
+
+        GLFWwindow* window = glfwCreateWindow(64, 64, "benchmarks", nullptr, nullptr);
+        if (!window)
+        {
+            return nullptr;
+        }
+        glfwMakeContextCurrent(window);
+        return reinterpret_cast<GLADloadproc>(glfwGetProcAddress);
+#endif
+    }
+} // namespace
+
+bool ensureGLContext()
+{
+    static const bool available = []
+    {
+        const GLADloadproc load = createContext();
+        if (!load || !gladLoadGLLoader(load))
+        {
+            std::cerr << "[benchmarks] no OpenGL context, GL benchmarks are skipped\n";
+            return false;
+        }
+        Platform::loadGLExtensions(load);
+
+        // A surfaceless context has no default framebuffer; draw into a small offscreen one
+        GLuint framebuffer = 0;
+        GLuint color = 0;
+        glGenFramebuffers(1, &framebuffer);
+        glGenRenderbuffers(1, &color);
+        glBindRenderbuffer(GL_RENDERBUFFER, color);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, kFramebufferSize, kFramebufferSize);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+        glViewport(0, 0, kFramebufferSize, kFramebufferSize);
+        std::cerr << "[benchmarks] " << glGetString(GL_VERSION) << " on " << glGetString(GL_RENDERER) << "\n";
+        return true;
+    }();
+    return available;
+}
@@ -0,0 +1,39 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_BENCHMARK_GL_CONTEXT_H
+#define LEARNOPENGL_BENCHMARK_GL_CONTEXT_H
+
+#include <benchmark/benchmark.h>
+
+/**
+ * @brief Makes a hidden GL core context current on the calling thread the
+ *        first time it is called, and loads glad and Platform::GLExtensions.
+ *
+ * Linux uses a surfaceless EGL context, so the benchmarks also run without
+ * a display (Mesa's llvmpipe included); other platforms open a hidden GLFW
+ * window. Numbers from a software rasterizer only compare CPU-side costs.
+ *
+ * @return false if no context could be created.
+ */
+bool ensureGLContext();
+
+/**
+ * @brief For the top of a GL benchmark: skips it when there is no context.
+ * @code
+ *   if (!requireGLContext(state))
+ *       return;
+ * @endcode
+ */
+inline bool requireGLContext(benchmark::State& state)
+{
+    if (ensureGLContext())
+    {
+        return true;
+    }
+    state.SkipWithError("no OpenGL context");
+    return false;
+}
+
+#endif // LEARNOPENGL_BENCHMARK_GL_CONTEXT_H
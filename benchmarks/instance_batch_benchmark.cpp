@@ -0,0 +1,191 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gl_context.h"
+#include "instance_batch.h"
+#include "scene.h"
+#include "shader/program.h"
+#include "shader/stage.h"
+#include "shader/std140.h"
+#include "uniform_ring.h"
+
+namespace
+{
+    // Per-object path: one std140 block and one draw per object
+    constexpr const char* kObjectVertex = R"(#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(std140) uniform ObjectBlock
+{
+    mat4 uTransform;
+    vec4 uColor;
+};
+out vec4 vColor;
+void main()
+{
+    vColor = uColor;
+    gl_Position = uTransform * vec4(aPos, 1.0);
+}
+)";
+
+    // Instanced path; the attributes match shaders/instance_data.glsl
+    constexpr const char* kInstancedVertex = R"(#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(location = 4) in mat4 aInstanceTransform;
+layout(location = 8) in vec4 aInstanceColor;
+out vec4 vColor;
+void main()
+{
+    vColor = aInstanceColor;
+    gl_Position = aInstanceTransform * vec4(aPos, 1.0);
+}
+)";
+
+    constexpr const char* kFragment = R"(#version 330 core
+in vec4 vColor;
+out vec4 FragColor;
+void main()
+{
+    FragColor = vColor;
+}
+)";
+
+    struct ObjectBlock
+    {
+        glm::mat4 transform;
+        glm::vec4 color;
+    };
+    STD140_ASSERT(ObjectBlock, STD140_FIELD(ObjectBlock, transform), STD140_FIELD(ObjectBlock, color));
+
+    struct Programs
+    {
+        ShaderProgram perObject;
+        ShaderProgram instanced;
+
+        static Programs& get()
+        {
+            // Leaked like BenchmarkScene
+            static Programs* programs = new Programs();
+            return *programs;
+        }
+
+      private:
+        Programs()
+        {
+            ShaderProgram::registerBlockBinding("ObjectBlock", 0);
+            link(perObject, "benchmarks/object.vert", kObjectVertex);
+            link(instanced, "benchmarks/instanced.vert", kInstancedVertex);
+        }
+
+        static void link(ShaderProgram& program, const char* name, const char* vertexSource)
+        {
+            const ShaderStage vertex(name, GL_VERTEX_SHADER, {}, vertexSource);
+            const ShaderStage fragment("benchmarks/color.frag", GL_FRAGMENT_SHADER, {}, kFragment);
+            program.attach(vertex);
+            program.attach(fragment);
+            if (!program.link())
+            {
+                throw std::runtime_error(std::string("failed to link ") + name);
+            }
+        }
+    };
+
+    // Small quads on a grid, so the rasterizer's share of the frame stays small
+    std::vector<InstanceData> makeObjects(const std::size_t count)
+    {
+        std::vector<InstanceData> objects(count);
+        const auto                side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const glm::vec3 position(-1.0f + 2.0f * static_cast<float>(i % side) / static_cast<float>(side),
+                                     -1.0f + 2.0f * static_cast<float>(i / side) / static_cast<float>(side), 0.0f);
+            objects[i].transform = glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(0.01f));
+            objects[i].color = glm::vec4(static_cast<float>(i) / static_cast<float>(count), 0.5f, 0.5f, 1.0f);
+        }
+        return objects;
+    }
+
+    /**
+     * Baseline: every object pushes its block into a UniformRing, binds it
+     * and issues its own draw.
+     */
+    void BM_PerObjectDraws(benchmark::State& state)
+    {
+        if (!requireGLContext(state))
+        {
+            return;
+        }
+        const BenchmarkScene&           scene = BenchmarkScene::get();
+        const ShaderProgram&            program = Programs::get().perObject;
+        const std::vector<InstanceData> objects = makeObjects(static_cast<std::size_t>(state.range(0)));
+
+        UniformRing ring(objects.size() * 256);
+        for (auto _ : state)
+        {
+            ring.beginFrame();
+            std::vector<UniformRing::Allocation> blocks;
+            blocks.reserve(objects.size());
+            for (const InstanceData& object : objects)
+            {
+                blocks.push_back(ring.push(ObjectBlock {object.transform, object.color}));
+            }
+            ring.flush();
+
+            program.bind();
+            scene.arena.bind();
+            for (const UniformRing::Allocation& block : blocks)
+            {
+                ring.bind(0, block);
+                scene.arena.draw(scene.quad);
+            }
+            ring.endFrame();
+        }
+        glFinish();
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(objects.size()));
+        state.counters["draw_calls"] = static_cast<double>(objects.size());
+    }
+    BENCHMARK(BM_PerObjectDraws)->RangeMultiplier(4)->Range(64, 16384);
+
+    /**
+     * The same objects written into an InstanceBatch and drawn with one call.
+     */
+    void BM_InstancedDraws(benchmark::State& state)
+    {
+        if (!requireGLContext(state))
+        {
+            return;
+        }
+        const BenchmarkScene&           scene = BenchmarkScene::get();
+        const ShaderProgram&            program = Programs::get().instanced;
+        const std::vector<InstanceData> objects = makeObjects(static_cast<std::size_t>(state.range(0)));
+
+        Core::InstanceBatchConfig config;
+        config.maxInstances = static_cast<std::uint32_t>(objects.size());
+        InstanceBatch batch(config);
+        for (auto _ : state)
+        {
+            batch.beginFrame();
+            const InstanceBatch::Range range = batch.write(objects.data(), static_cast<std::uint32_t>(objects.size()));
+            batch.flush();
+
+            program.bind();
+            batch.draw(scene.arena, scene.quad, range);
+            batch.endFrame();
+        }
+        glFinish();
+
+        // Stats cover the last frame only
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(objects.size()));
+        state.counters["draw_calls"] = batch.getStats().drawCalls;
+    }
+    BENCHMARK(BM_InstancedDraws)->RangeMultiplier(4)->Range(64, 16384);
+} // namespace
@@ -0,0 +1,202 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gl_context.h"
+#include "mesh_registry.h"
+#include "platform/GLExtensions.h"
+#include "scene.h"
+#include "shader/program.h"
+#include "shader/sources.h"
+#include "shader/stage.h"
+#include "shader/std140.h"
+
+// The per-object baseline is BM_PerObjectDraws in instance_batch_benchmark.cpp, over the same objects:
+//   LearnOpenGLBenchmarks --benchmark_filter='PerObject|Registry'
+namespace
+{
+    // Mirrors `struct DrawRecord` in the vertex shader below
+    struct DrawRecord
+    {
+        glm::mat4 transform;
+        glm::vec4 color;
+    };
+    STD140_ASSERT(DrawRecord, STD140_FIELD(DrawRecord, transform), STD140_FIELD(DrawRecord, color));
+
+    constexpr const char* kDrawRecord = R"(
+struct DrawRecord
+{
+    mat4 transform;
+    vec4 color;
+};
+)";
+
+    constexpr const char* kVertexMain = R"(
+layout(location = 0) in vec3 aPos;
+out vec4 vColor;
+void main()
+{
+    vColor = DRAW.color;
+    gl_Position = DRAW.transform * vec4(aPos, 1.0);
+}
+)";
+
+    constexpr const char* kFragment = R"(#version 330 core
+in vec4 vColor;
+out vec4 FragColor;
+void main()
+{
+    FragColor = vColor;
+}
+)";
+
+    /**
+     * @brief One program per registry path, both reading their record
+     *        through shaders/draw_data.glsl.
+     */
+    struct Programs
+    {
+        ShaderProgram multiDrawIndirect;
+        ShaderProgram uniformRanges;
+
+        static Programs& get()
+        {
+            // Leaked like BenchmarkScene
+            static Programs* programs = new Programs();
+            return *programs;
+        }
+
+      private:
+        Programs()
+        {
+            // The fallback registry registers the same binding, but only once it exists
+            ShaderProgram::registerBlockBinding(MeshRegistry::kBlockName, 0);
+            if (Platform::glExtensions().multiDrawIndirect)
+            {
+                link(multiDrawIndirect, true);
+            }
+            link(uniformRanges, false);
+        }
+
+        static void link(ShaderProgram& program, const bool multiDraw)
+        {
+            std::string source = "#version 330 core\n";
+            if (multiDraw)
+            {
+                source += std::string("#define ") + MeshRegistry::kDefine + "\n"
+                          "#extension GL_ARB_shader_storage_buffer_object : require\n"
+                          "#extension GL_ARB_shader_draw_parameters : require\n"
+                          "#extension GL_ARB_shading_language_420pack : require\n";
+            }
+            source += kDrawRecord + ShaderSources::load("shaders/draw_data.glsl", {}) + kVertexMain;
+
+            const char*       name = multiDraw ? "benchmarks/registry_mdi.vert" : "benchmarks/registry_ubo.vert";
+            const ShaderStage vertex(name, GL_VERTEX_SHADER, {}, source);
+            const ShaderStage fragment("benchmarks/registry.frag", GL_FRAGMENT_SHADER, {}, kFragment);
+            program.attach(vertex);
+            program.attach(fragment);
+            if (!program.link())
+            {
+                throw std::runtime_error(std::string("failed to link ") + name);
+            }
+        }
+    };
+
+    // Same grid of small quads as BM_PerObjectDraws in instance_batch_benchmark.cpp
+    std::vector<DrawRecord> makeRecords(const std::size_t count)
+    {
+        std::vector<DrawRecord> records(count);
+        const auto              side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const glm::vec3 position(-1.0f + 2.0f * static_cast<float>(i % side) / static_cast<float>(side),
+                                     -1.0f + 2.0f * static_cast<float>(i / side) / static_cast<float>(side), 0.0f);
+            records[i].transform = glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(0.01f));
+            records[i].color = glm::vec4(static_cast<float>(i) / static_cast<float>(count), 0.5f, 0.5f, 1.0f);
+        }
+        return records;
+    }
+
+    /**
+     * Registers every object once, then renders the bucket each frame. With
+     * updates on, every record is rewritten first, as BM_PerObjectDraws
+     * pushes every block, so the bucket is re-uploaded each frame.
+     */
+    void renderRegistry(benchmark::State& state, const bool multiDraw)
+    {
+        BenchmarkScene&         scene = BenchmarkScene::get();
+        const ShaderProgram&    program = multiDraw ? Programs::get().multiDrawIndirect : Programs::get().uniformRanges;
+        std::vector<DrawRecord> records = makeRecords(static_cast<std::size_t>(state.range(0)));
+        const bool              updates = state.range(1) != 0;
+
+        MeshRegistry                      registry(scene.arena, sizeof(DrawRecord), 0, multiDraw);
+        std::vector<MeshRegistry::Handle> handles;
+        handles.reserve(records.size());
+        for (const DrawRecord& record : records)
+        {
+            handles.push_back(registry.add(scene.quad, 0, &record));
+        }
+
+        for (auto _ : state)
+        {
+            if (updates)
+            {
+                for (std::size_t i = 0; i < records.size(); ++i)
+                {
+                    records[i].color.g = records[i].color.g > 0.5f ? 0.4f : 0.6f;
+                    registry.update(handles[i], &records[i]);
+                }
+            }
+            program.bind();
+            registry.render(0);
+        }
+        glFinish();
+
+        const MeshRegistry::Stats& stats = registry.getStats();
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(records.size()));
+        state.counters["draw_calls"] = benchmark::Counter(stats.submissions, benchmark::Counter::kAvgIterations);
+        state.counters["uploads"] = benchmark::Counter(stats.uploads, benchmark::Counter::kAvgIterations);
+    }
+
+    /**
+     * One glMultiDrawElementsIndirect per frame, records read from an SSBO
+     * at gl_DrawIDARB.
+     */
+    void BM_RegistryMultiDrawIndirect(benchmark::State& state)
+    {
+        if (!requireGLContext(state))
+        {
+            return;
+        }
+        if (!Platform::glExtensions().multiDrawIndirect)
+        {
+            state.SkipWithError("multi-draw indirect is not available");
+            return;
+        }
+        renderRegistry(state, true);
+    }
+    BENCHMARK(BM_RegistryMultiDrawIndirect)->ArgsProduct({benchmark::CreateRange(64, 16384, 4), {0, 1}});
+
+    /**
+     * The GL 3.3 fallback: one glBindBufferRange + draw per object from the
+     * same bucket buffer.
+     */
+    void BM_RegistryUniformRanges(benchmark::State& state)
+    {
+        if (!requireGLContext(state))
+        {
+            return;
+        }
+        renderRegistry(state, false);
+    }
+    BENCHMARK(BM_RegistryUniformRanges)->ArgsProduct({benchmark::CreateRange(64, 16384, 4), {0, 1}});
+} // namespace
@@ -0,0 +1,135 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <random>
+#include <vector>
+
+#include "command_buffer.h"
+#include "gl_context.h"
+#include "platform/GLState.h"
+#include "render_queue.h"
+#include "scene.h"
+#include "uniform_ring.h"
+
+namespace
+{
+    constexpr std::uint32_t kMaterials = 16;
+
+    struct Draw
+    {
+        const ShaderProgram* program;
+        std::uint32_t        material;
+        float                depth;
+    };
+
+    std::vector<Draw> makeDraws(const std::size_t count)
+    {
+        const BenchmarkScene& scene = BenchmarkScene::get();
+
+        // Submission order is random, as it is after visibility culling
+        std::mt19937                          random(42);
+        std::uniform_int_distribution<int>    program(0, BenchmarkScene::kPrograms - 1);
+        std::uniform_int_distribution<int>    material(0, kMaterials - 1);
+        std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+
+        std::vector<Draw> draws(count);
+        for (Draw& draw : draws)
+        {
+            draw = {&scene.programs[program(random)], static_cast<std::uint32_t>(material(random)), depth(random)};
+        }
+        return draws;
+    }
+
+    /**
+     * One frame of random opaque draws pushed into a RenderQueue, recorded
+     * and replayed. Sorted frames use real keys; unsorted ones give every
+     * draw the same key, which the stable sort leaves in submission order,
+     * so the two rows compare state changes per frame before and after
+     * sorting. gl_calls counts the calls GLState actually issued.
+     */
+    void BM_RenderQueueFrame(benchmark::State& state)
+    {
+        if (!requireGLContext(state))
+        {
+            return;
+        }
+        const BenchmarkScene&   scene = BenchmarkScene::get();
+        const std::size_t       count = static_cast<std::size_t>(state.range(0));
+        const bool              sorted = state.range(1) != 0;
+        const std::vector<Draw> draws = makeDraws(count);
+
+        std::vector<glm::vec4> materials(kMaterials);
+        for (std::uint32_t i = 0; i < kMaterials; ++i)
+        {
+            materials[i] = glm::vec4(static_cast<float>(i) / kMaterials, 0.5f, 0.5f, 1.0f);
+        }
+
+        RenderQueue   queue;
+        CommandBuffer commands;
+        UniformRing   ring(count * 256);
+        const auto    recordMaterial = [&](CommandBuffer& buffer, const std::uint32_t material)
+        { buffer.setUniforms(1, &materials[material], sizeof(glm::vec4)); };
+
+        Platform::GLState& glState = Platform::glState();
+        glState.resetStats();
+        for (auto _ : state)
+        {
+            queue.clear();
+            for (const Draw& draw : draws)
+            {
+                const std::uint64_t key =
+                    sorted ? RenderQueue::makeKey(0, false, draw.program->getId(), draw.material, draw.depth) : 0;
+                queue.push(key, {draw.program, &scene.arena, scene.quad, draw.material});
+            }
+
+            commands.reset();
+            queue.record(commands, recordMaterial);
+            ring.beginFrame();
+            CommandBuffer::execute({&commands}, &ring);
+            ring.endFrame();
+        }
+        glFinish();
+
+        const RenderQueue::Stats stats = queue.getStats();
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+        state.counters["program_changes"] = stats.programChanges;
+        state.counters["material_changes"] = stats.materialChanges;
+        state.counters["gl_calls"] =
+            benchmark::Counter(static_cast<double>(glState.getStats().issued), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_RenderQueueFrame)->ArgsProduct({{256, 4096}, {0, 1}})->ArgNames({"draws", "sorted"});
+
+    /**
+     * The sort alone, across the comparison-sort threshold.
+     */
+    void BM_RenderQueueSort(benchmark::State& state)
+    {
+        if (!requireGLContext(state))
+        {
+            return;
+        }
+        const BenchmarkScene&   scene = BenchmarkScene::get();
+        const std::size_t       count = static_cast<std::size_t>(state.range(0));
+        const std::vector<Draw> draws = makeDraws(count);
+
+        RenderQueue   queue;
+        CommandBuffer commands;
+        for (auto _ : state)
+        {
+            queue.clear();
+            for (const Draw& draw : draws)
+            {
+                queue.push(RenderQueue::makeKey(0, false, draw.program->getId(), draw.material, draw.depth),
+                           {draw.program, &scene.arena, scene.quad, draw.material});
+            }
+            commands.reset();
+            queue.record(commands);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+        state.counters["sort_passes"] = queue.getStats().sortPasses;
+    }
+    BENCHMARK(BM_RenderQueueSort)->RangeMultiplier(4)->Range(16, 16384);
+} // namespace
@@ -0,0 +1,38 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "scene.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "shader/stage.h"
+
+BenchmarkScene::BenchmarkScene()
+    : arena({{VertexAttribute::make(0, VertexFormat::Float3, 0)}, 3 * sizeof(float)}, vertexArrays)
+{
+    const float         vertices[] = {-0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f, 0.5f, 0.5f, 0.0f, -0.5f, 0.5f, 0.0f};
+    const std::uint32_t indices[] = {0, 1, 2, 0, 2, 3};
+    quad = arena.add(vertices, 4, indices, 6);
+
+    // The define only makes each link a distinct program
+    for (unsigned i = 0; i < kPrograms; ++i)
+    {
+        const ShaderStage vertex("shaders/basic.vert", GL_VERTEX_SHADER, {"VARIANT " + std::to_string(i)});
+        const ShaderStage fragment("shaders/basic.frag", GL_FRAGMENT_SHADER);
+        programs[i].attach(vertex);
+        programs[i].attach(fragment);
+        if (!programs[i].link())
+        {
+            throw std::runtime_error("BenchmarkScene: failed to link the basic program");
+        }
+    }
+}
+
+BenchmarkScene& BenchmarkScene::get()
+{
+    // Leaked on purpose: destroying GL objects after the thread-local GLState is gone is not safe
+    static BenchmarkScene* scene = new BenchmarkScene();
+    return *scene;
+}
@@ -0,0 +1,37 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_BENCHMARK_SCENE_H
+#define LEARNOPENGL_BENCHMARK_SCENE_H
+
+#include <array>
+
+#include "geometry_arena.h"
+#include "shader/program.h"
+#include "vertex_array_cache.h"
+
+/**
+ * @brief GL objects shared by the rendering benchmarks: a quad in a
+ *        GeometryArena and a few distinct programs built from the embedded
+ *        basic shaders.
+ *
+ * Built on first use, after ensureGLContext(), and never destroyed: the
+ * context outlives every benchmark.
+ */
+struct BenchmarkScene
+{
+    static constexpr unsigned kPrograms = 4;
+
+    VertexArrayCache                     vertexArrays;
+    GeometryArena                        arena;
+    GeometryArena::Mesh                  quad;
+    std::array<ShaderProgram, kPrograms> programs;
+
+    static BenchmarkScene& get();
+
+  private:
+    BenchmarkScene();
+};
+
+#endif // LEARNOPENGL_BENCHMARK_SCENE_H
@@ -0,0 +1,330 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/Config.h"
+#include "geometry_arena.h"
+#include "gl_context.h"
+#include "shader/program.h"
+#include "shader/stage.h"
+#include "vertex_array_cache.h"
+#include "vertex_quantizer.h"
+
+namespace
+{
+    // 256 × 256 vertices, large enough that vertex fetch outweighs the per-draw cost
+    constexpr std::uint32_t kGridSide = 256;
+    constexpr std::uint32_t kGridVertices = kGridSide * kGridSide;
+    constexpr std::uint32_t kGridIndices = (kGridSide - 1) * (kGridSide - 1) * 6;
+
+    // Enough draws per frame for vertex fetch to dominate the small benchmark target
+    constexpr int kDrawsPerFrame = 4;
+
+    struct FloatVertex
+    {
+        glm::vec3 position;
+        glm::vec3 normal;
+        glm::vec2 uv;
+    };
+
+    constexpr const char* kFloatVertex = R"(#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aUV;
+out vec3 vColor;
+void main()
+{
+    vColor = aNormal * 0.5 + 0.5 + vec3(aUV, 0.0) * 0.01;
+    gl_Position = vec4(aPos, 1.0);
+}
+)";
+
+    // Reads QuantizedVertex; octDecode is the one from shaders/quantized.glsl
+    constexpr const char* kQuantizedVertex = R"(#version 330 core
+layout(location = 0) in vec4 aPos;
+layout(location = 1) in vec2 aNormal;
+layout(location = 2) in vec2 aUV;
+uniform mat4 uDequantize;
+out vec3 vColor;
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+void main()
+{
+    vColor = octDecode(aNormal) * 0.5 + 0.5 + vec3(aUV, 0.0) * 0.01;
+    gl_Position = uDequantize * aPos;
+}
+)";
+
+    constexpr const char* kFragment = R"(#version 330 core
+in vec3 vColor;
+out vec4 FragColor;
+void main()
+{
+    FragColor = vec4(vColor, 1.0);
+}
+)";
+
+    /**
+     * @brief The same wavy grid as float streams, covering clip space.
+     */
+    struct Grid
+    {
+        std::vector<float>         positions;
+        std::vector<float>         normals;
+        std::vector<float>         uvs;
+        std::vector<std::uint32_t> indices;
+
+        static const Grid& get()
+        {
+            static const Grid grid;
+            return grid;
+        }
+
+      private:
+        Grid()
+            : positions(kGridVertices * 3)
+            , normals(kGridVertices * 3)
+            , uvs(kGridVertices * 2)
+        {
+            for (std::uint32_t y = 0; y < kGridSide; ++y)
+            {
+                for (std::uint32_t x = 0; x < kGridSide; ++x)
+                {
+                    const std::uint32_t i = y * kGridSide + x;
+                    const float         u = static_cast<float>(x) / (kGridSide - 1);
+                    const float         v = static_cast<float>(y) / (kGridSide - 1);
+                    const float         height = 0.1f * std::sin(u * 12.0f) * std::cos(v * 12.0f);
+                    const float         dx = -1.2f * std::cos(u * 12.0f) * std::cos(v * 12.0f);
+                    const float         dy = 1.2f * std::sin(u * 12.0f) * std::sin(v * 12.0f);
+                    const glm::vec3     normal = glm::normalize(glm::vec3(dx, dy, 1.0f));
+
+                    positions[i * 3] = u * 2.0f - 1.0f;
+                    positions[i * 3 + 1] = v * 2.0f - 1.0f;
+                    positions[i * 3 + 2] = height;
+                    normals[i * 3] = normal.x;
+                    normals[i * 3 + 1] = normal.y;
+                    normals[i * 3 + 2] = normal.z;
+                    uvs[i * 2] = u;
+                    uvs[i * 2 + 1] = v;
+                }
+            }
+
+            indices.reserve(kGridIndices);
+            for (std::uint32_t y = 0; y + 1 < kGridSide; ++y)
+            {
+                for (std::uint32_t x = 0; x + 1 < kGridSide; ++x)
+                {
+                    const std::uint32_t i = y * kGridSide + x;
+                    indices.insert(indices.end(), {i, i + 1, i + kGridSide + 1, i, i + kGridSide + 1, i + kGridSide});
+                }
+            }
+        }
+    };
+
+    /**
+     * The scalar reference the SIMD paths are checked against: one glm pack
+     * per attribute and vertex.
+     */
+    void quantizeReference(const Grid& grid, const VertexQuantizer::Bounds& bounds, std::vector<QuantizedVertex>& out)
+    {
+        const glm::vec3 center = bounds.center();
+        const glm::vec3 scale = 1.0f / bounds.extent();
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            const glm::vec3 p(grid.positions[i * 3], grid.positions[i * 3 + 1], grid.positions[i * 3 + 2]);
+            glm::vec3       n(grid.normals[i * 3], grid.normals[i * 3 + 1], grid.normals[i * 3 + 2]);
+            n /= std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+            const glm::vec2 e = n.z >= 0.0f ? glm::vec2(n)
+                                            : glm::vec2((1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                                                        (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+
+            const std::uint64_t position = glm::packSnorm4x16(glm::vec4((p - center) * scale, 1.0f));
+            const std::uint32_t normal = glm::packSnorm2x16(e);
+            const std::uint32_t uv = glm::packHalf2x16(glm::vec2(grid.uvs[i * 2], grid.uvs[i * 2 + 1]));
+            std::memcpy(out[i].position, &position, sizeof(position));
+            std::memcpy(out[i].normal, &normal, sizeof(normal));
+            std::memcpy(out[i].uv, &uv, sizeof(uv));
+        }
+    }
+
+    void BM_QuantizeReference(benchmark::State& state)
+    {
+        const Grid&                   grid = Grid::get();
+        const VertexQuantizer::Bounds bounds = VertexQuantizer::computeBounds(grid.positions.data(), kGridVertices);
+        std::vector<QuantizedVertex>  vertices(kGridVertices);
+        for (auto _ : state)
+        {
+            quantizeReference(grid, bounds, vertices);
+            benchmark::DoNotOptimize(vertices.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetLabel("scalar");
+        state.SetItemsProcessed(state.iterations() * kGridVertices);
+    }
+    BENCHMARK(BM_QuantizeReference);
+
+    /**
+     * The path compiled into this build: SSE2 by default, AVX2 + F16C when
+     * configured with -DLEARNOPENGL_AVX2=ON. The label names it.
+     */
+    void BM_QuantizeKernels(benchmark::State& state)
+    {
+        const Grid&                  grid = Grid::get();
+        std::vector<QuantizedVertex> vertices(kGridVertices);
+        for (auto _ : state)
+        {
+            VertexQuantizer::quantize(grid.positions.data(), grid.normals.data(), grid.uvs.data(), kGridVertices,
+                                      vertices.data());
+            benchmark::DoNotOptimize(vertices.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetLabel(VertexQuantizer::simdPath());
+        state.SetItemsProcessed(state.iterations() * kGridVertices);
+    }
+    BENCHMARK(BM_QuantizeKernels);
+
+    /**
+     * @brief One arena and program per vertex format, built on first use.
+     */
+    struct DrawSetup
+    {
+        VertexArrayCache        vertexArrays;
+        GeometryArena           floatArena;
+        GeometryArena           quantizedArena;
+        GeometryArena::Mesh     floatMesh;
+        GeometryArena::Mesh     quantizedMesh;
+        VertexQuantizer::Bounds bounds;
+        ShaderProgram           floatProgram;
+        ShaderProgram           quantizedProgram;
+
+        static DrawSetup& get()
+        {
+            // Leaked like BenchmarkScene
+            static DrawSetup* setup = new DrawSetup();
+            return *setup;
+        }
+
+      private:
+        static Core::GeometryArenaConfig arenaConfig()
+        {
+            // Headroom: the allocator's size bins round a request up, so an exact fit can fail
+            Core::GeometryArenaConfig config;
+            config.vertexCapacity = kGridVertices * 2;
+            config.indexCapacity = kGridIndices * 2;
+            config.maxMeshes = 1;
+            return config;
+        }
+
+        DrawSetup()
+            : floatArena({{VertexAttribute::make(0, VertexFormat::Float3, offsetof(FloatVertex, position)),
+                           VertexAttribute::make(1, VertexFormat::Float3, offsetof(FloatVertex, normal)),
+                           VertexAttribute::make(2, VertexFormat::Float2, offsetof(FloatVertex, uv))},
+                          sizeof(FloatVertex)},
+                         vertexArrays, arenaConfig())
+            , quantizedArena(VertexQuantizer::layout(), vertexArrays, arenaConfig())
+        {
+            const Grid& grid = Grid::get();
+
+            std::vector<FloatVertex> floats(kGridVertices);
+            for (std::size_t i = 0; i < floats.size(); ++i)
+            {
+                floats[i] = {{grid.positions[i * 3], grid.positions[i * 3 + 1], grid.positions[i * 3 + 2]},
+                             {grid.normals[i * 3], grid.normals[i * 3 + 1], grid.normals[i * 3 + 2]},
+                             {grid.uvs[i * 2], grid.uvs[i * 2 + 1]}};
+            }
+            floatMesh = floatArena.add(floats.data(), kGridVertices, grid.indices.data(), kGridIndices);
+
+            std::vector<QuantizedVertex> quantized(kGridVertices);
+            bounds = VertexQuantizer::quantize(grid.positions.data(), grid.normals.data(), grid.uvs.data(),
+                                               kGridVertices, quantized.data());
+            quantizedMesh = quantizedArena.add(quantized.data(), kGridVertices, grid.indices.data(), kGridIndices);
+
+            link(floatProgram, "benchmarks/float_vertex.vert", kFloatVertex);
+            link(quantizedProgram, "benchmarks/quantized_vertex.vert", kQuantizedVertex);
+        }
+
+        static void link(ShaderProgram& program, const char* name, const char* vertexSource)
+        {
+            const ShaderStage vertex(name, GL_VERTEX_SHADER, {}, vertexSource);
+            const ShaderStage fragment("benchmarks/normal.frag", GL_FRAGMENT_SHADER, {}, kFragment);
+            program.attach(vertex);
+            program.attach(fragment);
+            if (!program.link())
+            {
+                throw std::runtime_error(std::string("failed to link ") + name);
+            }
+        }
+    };
+
+    void drawFrames(benchmark::State& state, const GeometryArena& arena, const GeometryArena::Mesh& mesh)
+    {
+        if (!mesh.isValid())
+        {
+            state.SkipWithError("the grid did not fit in its arena");
+            return;
+        }
+        arena.bind();
+        for (auto _ : state)
+        {
+            for (int i = 0; i < kDrawsPerFrame; ++i)
+            {
+                arena.draw(mesh);
+            }
+            // Time the GPU's vertex fetch, not just the command submission
+            glFinish();
+        }
+
+        const std::size_t vertexBytes = static_cast<std::size_t>(kGridVertices) * arena.getLayout().stride;
+        state.SetItemsProcessed(state.iterations() * kDrawsPerFrame * kGridVertices);
+        state.counters["vertex_bytes"] = static_cast<double>(vertexBytes);
+    }
+
+    /**
+     * Baseline: 32-byte float vertices.
+     */
+    void BM_DrawFloatVertices(benchmark::State& state)
+    {
+        if (!requireGLContext(state))
+        {
+            return;
+        }
+        DrawSetup& setup = DrawSetup::get();
+        setup.floatProgram.bind();
+        drawFrames(state, setup.floatArena, setup.floatMesh);
+    }
+    BENCHMARK(BM_DrawFloatVertices)->Unit(benchmark::kMillisecond);
+
+    /**
+     * The same grid as 16-byte QuantizedVertex records: half the vertex
+     * memory, decoded by the vertex fetch and octDecode.
+     */
+    void BM_DrawQuantizedVertices(benchmark::State& state)
+    {
+        if (!requireGLContext(state))
+        {
+            return;
+        }
+        DrawSetup& setup = DrawSetup::get();
+        setup.quantizedProgram.bind();
+        setup.quantizedProgram.setUniform("uDequantize", setup.bounds.dequantizeMatrix());
+        drawFrames(state, setup.quantizedArena, setup.quantizedMesh);
+    }
+    BENCHMARK(BM_DrawQuantizedVertices)->Unit(benchmark::kMillisecond);
+} // namespace
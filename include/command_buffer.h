@@ -0,0 +1,158 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_COMMAND_BUFFER_H
+#define LEARNOPENGL_COMMAND_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glad/glad.h>
+#include <vector>
+
+#include "core/LinearAllocator.h"
+#include "geometry_arena.h"
+#include "uniform_ring.h"
+
+class ShaderProgram;
+
+/**
+ * @brief A list of draw commands recorded without touching GL, replayed
+ *        later on the thread that owns the context.
+ *
+ * Only the context thread may call GL, but culling, sorting and uniform
+ * packing need none of it: worker threads each fill their own buffer in
+ * parallel, and the context thread replays them with execute(). Commands
+ * and the uniform data they carry live in the buffer's Core::LinearAllocator,
+ * so recording allocates nothing from the heap once the blocks have grown
+ * to a frame's worth.
+ *
+ * Recording a buffer is single-threaded; separate buffers need no locking.
+ * execute() replays the buffers in the order given and each buffer in the
+ * order it was recorded, so the output never depends on which worker
+ * finished first.
+ * @code
+ *   // on worker i
+ *   buffers[i].reset();
+ *   buffers[i].bindProgram(program);
+ *   buffers[i].bindGeometry(arena);
+ *   buffers[i].setUniforms(0, &perDraw, sizeof(perDraw));
+ *   buffers[i].draw(mesh);
+ *
+ *   // on the context thread, once every worker is done
+ *   ring.beginFrame();
+ *   CommandBuffer::execute(bufferPointers, &ring);
+ *   ring.endFrame();
+ * @endcode
+ */
+class CommandBuffer
+{
+  public:
+    struct Stats
+    {
+        std::uint32_t commands     = 0; ///< Commands replayed.
+        std::uint32_t draws        = 0;
+        std::size_t   uniformBytes = 0; ///< Staged into the UniformRing.
+    };
+
+    explicit CommandBuffer(std::size_t blockSize = Core::LinearAllocator::kDefaultBlockSize);
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+    CommandBuffer(CommandBuffer&& other) noexcept;
+    CommandBuffer& operator=(CommandBuffer&& other) noexcept;
+
+    void bindProgram(const ShaderProgram& program);
+
+    /**
+     * @brief Binds the arena's VAO for the draws that follow.
+     */
+    void bindGeometry(const GeometryArena& arena);
+
+    /**
+     * @brief Draws @p mesh from the last bound arena.
+     */
+    void draw(const GeometryArena::Mesh& mesh, GLenum mode = GL_TRIANGLES);
+
+    /**
+     * @brief Copies @p size bytes of std140 data, bound to uniform block
+     *        @p binding for the draws that follow.
+     */
+    void setUniforms(GLuint binding, const void* data, std::size_t size);
+
+    void setViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    void setBlend(bool enabled);
+    void setDepthTest(bool enabled);
+    void setCullFace(bool enabled);
+
+    /**
+     * @brief Scratch memory that lives as long as the recorded commands.
+     */
+    template <typename T>
+    T* allocate(const std::size_t count = 1)
+    {
+        return m_allocator.create<T>(count);
+    }
+
+    /**
+     * @brief Drops every command and rewinds the allocator.
+     */
+    void reset();
+
+    /**
+     * @brief Replays @p buffers in order on the calling thread, which must
+     *        own the context.
+     *
+     * Uniform data of every buffer is first copied into @p uniforms, which
+     * is then flushed, so the caller wraps the call in the ring's
+     * beginFrame() / endFrame(). @p uniforms may be null when no buffer
+     * recorded setUniforms().
+     *
+     * @throws std::logic_error if uniforms are recorded but @p uniforms is null,
+     *         or a draw precedes every bindGeometry().
+     */
+    static Stats execute(const std::vector<CommandBuffer*>& buffers, UniformRing* uniforms);
+
+    /**
+     * @brief Commands recorded since the last reset().
+     */
+    std::size_t size() const
+    {
+        return m_count;
+    }
+
+    bool isEmpty() const
+    {
+        return m_count == 0;
+    }
+
+    const Core::LinearAllocator& getAllocator() const
+    {
+        return m_allocator;
+    }
+
+  private:
+    enum class Type : std::uint8_t
+    {
+        BindProgram,
+        BindGeometry,
+        Draw,
+        Uniforms,
+        Viewport,
+        Blend,
+        DepthTest,
+        CullFace,
+    };
+
+    struct Command; ///< Defined in the .cpp; fixed size, linked in record order.
+
+    Core::LinearAllocator m_allocator;
+    Command*              m_first;
+    Command*              m_last;
+    std::size_t           m_count;
+    bool                  m_hasUniforms;
+
+    Command& push(Type type);
+};
+
+#endif // LEARNOPENGL_COMMAND_BUFFER_H
@@ -5,6 +5,8 @@
 #ifndef LEARNOPENGL_CONFIG_H
 #define LEARNOPENGL_CONFIG_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace Core
@@ -39,6 +41,99 @@ namespace Core
         float a = 1.0f;
     };
 
+    /**
+     * @brief On-disk program binary cache settings.
+     *
+     * Entries beyond maxBytes are evicted least-recently-used first.
+     * An empty directory disables the cache.
+     */
+    struct ShaderCacheConfig
+    {
+        std::string directory = "shader_cache";
+        std::size_t maxBytes  = 64u * 1024u * 1024u;
+    };
+
+    /**
+     * @brief Where shader sources come from at runtime.
+     *
+     * Shaders are embedded into the executable at build time. When
+     * overrideRoot is set, a stage path that exists under it is read from
+     * disk instead, which keeps edits and hot reload working during
+     * development. Debug builds point it at the source tree, as does any
+     * build configured with -DLEARNOPENGL_SHADER_OVERRIDE=ON.
+     */
+    struct ShaderSourceConfig
+    {
+#ifdef LEARNOPENGL_SHADER_OVERRIDE_ROOT
+        std::string overrideRoot = LEARNOPENGL_SHADER_OVERRIDE_ROOT;
+#else
+        std::string overrideRoot;
+#endif
+    };
+
+    /**
+     * @brief Shader compile / link telemetry written at shutdown.
+     *
+     * An empty reportPath skips the JSON report; a slowestCount of 0 skips
+     * the table printed to stdout.
+     */
+    struct ShaderTelemetryConfig
+    {
+        std::string reportPath   = "shader_telemetry.json";
+        std::size_t slowestCount = 10;
+    };
+
+    /**
+     * @brief Capacity of one GeometryArena.
+     *
+     * Capacities are in vertices and indices; both buffers are allocated in
+     * full up front, with 16-bit indices when vertexCapacity is at most
+     * 65536. maxMeshes bounds the allocator's bookkeeping, not the storage.
+     */
+    struct GeometryArenaConfig
+    {
+        std::uint32_t vertexCapacity = 256u * 1024u;
+        std::uint32_t indexCapacity  = 1024u * 1024u;
+        std::uint32_t maxMeshes      = 16u * 1024u;
+    };
+
+    /**
+     * @brief Per-frame budget of the UploadQueue.
+     *
+     * Each frame in flight gets a staging region of bytesPerFrame, so the
+     * staging buffer holds bytesPerFrame × frames bytes.
+     */
+    struct UploadQueueConfig
+    {
+        std::size_t bytesPerFrame = 4u * 1024u * 1024u;
+        unsigned    frames        = 3;
+    };
+
+    /**
+     * @brief Capacity of an InstanceBatch.
+     *
+     * The instance buffer holds maxInstances instances per frame in flight.
+     */
+    struct InstanceBatchConfig
+    {
+        std::uint32_t maxInstances = 16u * 1024u;
+        unsigned      frames       = 3;
+    };
+
+    /**
+     * @brief Size of the Core::JobSystem pool.
+     *
+     * A negative workerThreads starts one worker per hardware thread, minus
+     * the main thread, which takes part while it waits; 0 runs every job on
+     * the main thread. queueCapacity bounds each thread's deque; a job
+     * spawned into a full deque runs immediately.
+     */
+    struct JobSystemConfig
+    {
+        int         workerThreads = -1;
+        std::size_t queueCapacity = 4096;
+    };
+
     /**
      * @brief Aggregated runtime application configuration.
      *
@@ -53,9 +148,16 @@ namespace Core
      */
     struct AppConfig
     {
-        WindowConfig     window;
-        OpenGLConfig     openGL;
-        ClearColorConfig clearColor;
+        WindowConfig          window;
+        OpenGLConfig          openGL;
+        ClearColorConfig      clearColor;
+        ShaderCacheConfig     shaderCache;
+        ShaderSourceConfig    shaderSources;
+        ShaderTelemetryConfig shaderTelemetry;
+        GeometryArenaConfig   geometry;
+        UploadQueueConfig     uploads;
+        InstanceBatchConfig   instances;
+        JobSystemConfig       jobs;
     };
 
     /**
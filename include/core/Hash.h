@@ -0,0 +1,52 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_HASH_H
+#define LEARNOPENGL_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Core
+{
+    inline constexpr std::uint64_t kFnv1aOffset = 0xcbf29ce484222325ull;
+    inline constexpr std::uint64_t kFnv1aPrime  = 0x100000001b3ull;
+
+    /**
+     * @brief 64-bit FNV-1a hash of a string, usable in constant expressions.
+     *
+     * Pass a previous result as @p seed to hash several strings as one stream.
+     */
+    constexpr std::uint64_t fnv1a(std::string_view text, std::uint64_t seed = kFnv1aOffset)
+    {
+        std::uint64_t hash = seed;
+        for (const char c : text)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= kFnv1aPrime;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief 64-bit FNV-1a hash of a raw byte range.
+     *
+     * A string literal followed by a seed binds here, not to the string
+     * overload; wrap it in std::string_view.
+     */
+    inline std::uint64_t fnv1a(const void* data, std::size_t size, std::uint64_t seed = kFnv1aOffset)
+    {
+        const auto*   bytes = static_cast<const std::uint8_t*>(data);
+        std::uint64_t hash  = seed;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= kFnv1aPrime;
+        }
+        return hash;
+    }
+} // namespace Core
+
+#endif // LEARNOPENGL_HASH_H
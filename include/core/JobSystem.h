@@ -0,0 +1,334 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_JOB_SYSTEM_H
+#define LEARNOPENGL_JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/Config.h"
+#include "core/WorkStealingDeque.h"
+
+namespace Core
+{
+    /**
+     * @brief Fixed pool of worker threads running small jobs, with one
+     *        Chase-Lev deque per thread.
+     *
+     * A thread pushes the jobs it spawns onto its own deque and pops them
+     * back newest first; idle threads steal the oldest job of a random
+     * victim. The thread that built the system is a member too: wait()
+     * runs jobs instead of blocking, so it helps until the counter drains.
+     *
+     * Completion is tracked with Counters rather than futures: each job run
+     * with a counter raises it by one and lowers it when done. runAfter()
+     * holds a job back until a counter reaches zero, which is how
+     * dependencies are expressed.
+     * @code
+     *   Core::JobSystem::Counter culled;
+     *   jobs.parallelFor(0, objects.size(), [&](std::size_t first, std::size_t last) { cull(first, last); },
+     *                    &culled);
+     *   Core::JobSystem::Counter recorded;
+     *   jobs.runAfter(culled, [&] { queue.record(commands); }, &recorded);
+     *   jobs.wait(recorded);
+     * @endcode
+     * Job callables are stored inline, so captures must fit in
+     * kJobStorageSize bytes — capture by reference. Jobs may only be spawned
+     * from the building thread or from inside jobs.
+     */
+    class JobSystem
+    {
+      public:
+        static constexpr std::size_t kJobStorageSize = 64;
+
+        class Counter;
+
+        struct Stats
+        {
+            std::uint64_t executed = 0;
+            std::uint64_t stolen   = 0; ///< Jobs run by a thread other than the one that spawned them.
+            std::uint64_t inlined  = 0; ///< Jobs run at once because the spawning deque was full.
+            std::uint64_t pooled   = 0; ///< Job slots allocated across every thread; stops growing once warm.
+        };
+
+        /**
+         * @brief Starts config.workerThreads workers, or one less than the
+         *        hardware thread count when it is negative.
+         */
+        explicit JobSystem(const JobSystemConfig& config = {});
+
+        /**
+         * @brief Stops and joins the workers. Wait for outstanding work first:
+         *        jobs still queued are dropped.
+         */
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * @brief Queues @p function; @p counter, if any, drops back when it has run.
+         */
+        template <typename Function>
+        void run(Function&& function, Counter* counter = nullptr);
+
+        /**
+         * @brief Queues @p function once @p dependency reaches zero, or at
+         *        once if it already has.
+         */
+        template <typename Function>
+        void runAfter(Counter& dependency, Function&& function, Counter* counter = nullptr);
+
+        /**
+         * @brief Calls body(first, last) over sub-ranges of [begin, end) in parallel.
+         *
+         * The range starts in chunks of about a sixteenth of it per thread,
+         * and a chunk larger than @p grain halves itself, queueing the upper
+         * half, whenever its own deque is empty — idle threads then have
+         * something to steal, while busy ones run big chunks without splitting.
+         *
+         * The chunks share a copy of @p body, freed after the last one has
+         * run, so a temporary lambda is fine even when this returns early.
+         *
+         * @param counter Signalled when every chunk has run; null waits here.
+         */
+        template <typename Body>
+        void parallelFor(std::size_t begin, std::size_t end, Body&& body, Counter* counter = nullptr,
+                         std::size_t grain = 1);
+
+        /**
+         * @brief Runs queued jobs until @p counter reaches zero.
+         */
+        void wait(const Counter& counter);
+
+        /**
+         * @brief Workers plus the building thread.
+         */
+        unsigned getThreadCount() const
+        {
+            return static_cast<unsigned>(m_threads.size());
+        }
+
+        Stats getStats() const;
+
+      private:
+        struct Job
+        {
+            void (*invoke)(Job& job)  = nullptr;
+            void (*destroy)(Job& job) = nullptr;
+            Counter* counter          = nullptr;
+            Job*     next             = nullptr; ///< Free list or continuation list.
+            unsigned owner            = 0;       ///< Index of the spawning thread.
+
+            alignas(std::max_align_t) unsigned char storage[kJobStorageSize];
+        };
+
+        template <typename Body>
+        struct RangeTask;
+
+        struct alignas(64) Thread
+        {
+            explicit Thread(std::size_t capacity)
+                : deque(capacity)
+            {}
+
+            WorkStealingDeque<Job>              deque;
+            std::vector<std::unique_ptr<Job[]>> pool;
+            Job*                                freeJobs = nullptr; ///< Touched by the owning thread only.
+            std::atomic<Job*>                   returned {nullptr}; ///< Jobs other threads ran, pushed back lock-free.
+            std::uint64_t                       random   = 0;
+            std::thread                         thread;
+        };
+
+        std::vector<std::unique_ptr<Thread>> m_threads;
+
+        std::atomic<bool>          m_stopping;
+        std::atomic<std::int64_t>  m_queued;   ///< Jobs pushed and not yet taken.
+        std::atomic<std::uint32_t> m_sleeping; ///< Workers blocked on m_wake.
+        std::mutex                 m_mutex;
+        std::condition_variable    m_wake;
+
+        std::atomic<std::uint64_t> m_executed;
+        std::atomic<std::uint64_t> m_stolen;
+        std::atomic<std::uint64_t> m_inlined;
+        std::atomic<std::uint64_t> m_pooled;
+
+        template <typename Function>
+        Job* create(Function&& function, Counter* counter);
+
+        /**
+         * @brief Pushes @p job onto the calling thread's deque and wakes a sleeper.
+         */
+        void submit(Job* job);
+
+        void execute(Job* job);
+        void complete(Counter& counter);
+
+        /**
+         * @brief Hands @p job back to the free list of the thread that spawned it.
+         */
+        void release(Job* job);
+
+        /**
+         * @brief Pops a local job or steals one; returns false if none was found.
+         */
+        bool runOne(unsigned self);
+        void workerLoop(unsigned self);
+
+        unsigned currentThread() const;
+        Job*     allocateJob();
+
+        template <typename Body>
+        void splitRange(std::size_t begin, std::size_t end, RangeTask<Body>* task, std::size_t grain);
+    };
+
+    /**
+     * @brief Number of outstanding jobs that signal it; jobs queued on it
+     *        with runAfter() start when it drops to zero.
+     *
+     * Must outlive every job that signals it: destroy it only after
+     * JobSystem::wait() has returned, not merely once isDone() reads true.
+     */
+    class JobSystem::Counter
+    {
+      public:
+        Counter() = default;
+
+        Counter(const Counter&) = delete;
+        Counter& operator=(const Counter&) = delete;
+
+        bool isDone() const
+        {
+            return m_pending.load(std::memory_order_acquire) == 0;
+        }
+
+      private:
+        friend class JobSystem;
+
+        std::atomic<std::uint32_t> m_pending {0};
+        mutable std::mutex         m_mutex; ///< Held while the count drops to zero.
+        Job*                       m_continuations = nullptr; ///< Guarded by m_mutex.
+    };
+
+    /**
+     * @brief A parallelFor() body owned by its chunks; the chunks signal
+     *        `chunks`, and a continuation on it frees the task.
+     */
+    template <typename Body>
+    struct JobSystem::RangeTask
+    {
+        template <typename Function>
+        explicit RangeTask(Function&& function)
+            : body(std::forward<Function>(function))
+        {}
+
+        Body    body;
+        Counter chunks;
+    };
+
+    template <typename Function>
+    void JobSystem::run(Function&& function, Counter* counter)
+    {
+        submit(create(std::forward<Function>(function), counter));
+    }
+
+    template <typename Function>
+    void JobSystem::runAfter(Counter& dependency, Function&& function, Counter* counter)
+    {
+        Job* job = create(std::forward<Function>(function), counter);
+        {
+            std::lock_guard lock(dependency.m_mutex);
+            if (!dependency.isDone())
+            {
+                job->next = dependency.m_continuations;
+                dependency.m_continuations = job;
+                return;
+            }
+        }
+        submit(job);
+    }
+
+    template <typename Body>
+    void JobSystem::parallelFor(const std::size_t begin, const std::size_t end, Body&& body, Counter* counter,
+                                const std::size_t grain)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+
+        Counter  local;
+        Counter* done = counter ? counter : &local;
+
+        // Start from a few chunks per thread; splitRange() refines them on demand
+        const std::size_t chunks = std::size_t {getThreadCount()} * 16;
+        const std::size_t chunk = std::max({grain, std::size_t {1}, (end - begin + chunks - 1) / chunks});
+
+        using Task = RangeTask<std::decay_t<Body>>;
+        auto  owned = std::make_unique<Task>(std::forward<Body>(body));
+        Task* task = owned.get();
+        for (std::size_t first = begin; first < end; first += chunk)
+        {
+            const std::size_t last = std::min(end, first + chunk);
+            run([this, task, first, last, grain] { splitRange(first, last, task, grain); }, &task->chunks);
+        }
+
+        // The caller's counter drops only once the task is gone
+        runAfter(task->chunks, [task] { delete task; }, done);
+        owned.release();
+
+        if (!counter)
+        {
+            wait(local);
+        }
+    }
+
+    template <typename Body>
+    void JobSystem::splitRange(std::size_t begin, std::size_t end, RangeTask<Body>* task, const std::size_t grain)
+    {
+        // Lazy binary splitting: only split while nothing local is left for thieves to take
+        Thread& self = *m_threads[currentThread()];
+        while (end - begin > grain && self.deque.size() == 0)
+        {
+            const std::size_t middle = begin + (end - begin) / 2;
+            run([this, task, middle, end, grain] { splitRange(middle, end, task, grain); }, &task->chunks);
+            end = middle;
+        }
+        task->body(begin, end);
+    }
+
+    template <typename Function>
+    JobSystem::Job* JobSystem::create(Function&& function, Counter* counter)
+    {
+        using Stored = std::decay_t<Function>;
+        static_assert(sizeof(Stored) <= kJobStorageSize, "Job captures too large: capture by reference");
+        static_assert(alignof(Stored) <= alignof(std::max_align_t), "Job captures over-aligned");
+
+        Job* job = allocateJob();
+        new (job->storage) Stored(std::forward<Function>(function));
+        job->invoke = [](Job& self) { (*std::launder(reinterpret_cast<Stored*>(self.storage)))(); };
+        job->destroy = [](Job& self) { std::launder(reinterpret_cast<Stored*>(self.storage))->~Stored(); };
+        job->counter = counter;
+        job->next = nullptr;
+
+        if (counter)
+        {
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+} // namespace Core
+
+#endif // LEARNOPENGL_JOB_SYSTEM_H
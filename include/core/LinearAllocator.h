@@ -0,0 +1,98 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_LINEAR_ALLOCATOR_H
+#define LEARNOPENGL_LINEAR_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Core
+{
+    /**
+     * @brief Bump allocator for memory that lives until the next reset().
+     *
+     * Memory comes from fixed-size blocks; an allocation is a pointer bump
+     * in the current block, and a new block is only taken when it is full.
+     * reset() rewinds to the first block but keeps them all, so after the
+     * first few frames a frame allocates nothing from the heap.
+     *
+     * Nothing is destroyed: only store trivially destructible objects.
+     * Not thread-safe; give each thread its own allocator.
+     */
+    class LinearAllocator
+    {
+      public:
+        static constexpr std::size_t kDefaultBlockSize = 64u * 1024u;
+
+        explicit LinearAllocator(std::size_t blockSize = kDefaultBlockSize);
+
+        LinearAllocator(const LinearAllocator&) = delete;
+        LinearAllocator& operator=(const LinearAllocator&) = delete;
+        LinearAllocator(LinearAllocator&&) noexcept = default;
+        LinearAllocator& operator=(LinearAllocator&&) noexcept = default;
+
+        /**
+         * @brief Returns @p size bytes aligned to @p alignment, a power of two.
+         *
+         * Requests larger than the block size get a block of their own.
+         */
+        void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Allocates and value-initializes @p count objects of T.
+         */
+        template <typename T>
+        T* create(const std::size_t count = 1)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "LinearAllocator never runs destructors");
+            T* objects = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                new (objects + i) T {};
+            }
+            return objects;
+        }
+
+        /**
+         * @brief Makes every allocation invalid and reuses the blocks.
+         */
+        void reset();
+
+        /**
+         * @brief Bytes handed out since the last reset(), padding included.
+         */
+        std::size_t getUsedBytes() const
+        {
+            return m_used;
+        }
+
+        /**
+         * @brief Bytes held in blocks.
+         */
+        std::size_t getCapacity() const
+        {
+            return m_capacity;
+        }
+
+      private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> memory;
+            std::size_t                  size = 0;
+        };
+
+        std::vector<Block> m_blocks;
+        std::size_t        m_blockSize;
+        std::size_t        m_block;  ///< Index of the block being filled.
+        std::size_t        m_cursor; ///< Offset in that block.
+        std::size_t        m_used;
+        std::size_t        m_capacity;
+    };
+} // namespace Core
+
+#endif // LEARNOPENGL_LINEAR_ALLOCATOR_H
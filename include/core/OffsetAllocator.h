@@ -0,0 +1,140 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_OFFSET_ALLOCATOR_H
+#define LEARNOPENGL_OFFSET_ALLOCATOR_H
+
+#include <cstdint>
+#include <vector>
+
+namespace Core
+{
+    /**
+     * @brief Hands out ranges of an abstract [0, size) space, e.g. the
+     *        elements of a large GPU buffer, with O(1) allocate and free.
+     *
+     * A two-level segregated fit (TLSF) scheme: free ranges are kept in 256
+     * bins indexed by a small floating-point encoding of their size (5 bits
+     * of exponent, 3 of mantissa), so bin sizes grow by at most 12.5% from
+     * one to the next. A 32-bit mask of non-empty top bins and one 8-bit mask
+     * per top bin find the first bin that is large enough with two bit scans.
+     * A larger range is split and the remainder goes back into its bin; a
+     * freed range is merged with free neighbours at once, so the space never
+     * holds two adjacent free ranges.
+     *
+     * Only the bookkeeping lives here: the allocator never touches the memory
+     * it describes. Not thread-safe.
+     */
+    class OffsetAllocator
+    {
+      public:
+        static constexpr std::uint32_t kNoSpace = 0xffffffffu;
+
+        struct Allocation
+        {
+            std::uint32_t offset   = kNoSpace;
+            std::uint32_t metadata = kNoSpace; ///< Node index, needed by free().
+
+            bool isValid() const
+            {
+                return offset != kNoSpace;
+            }
+        };
+
+        struct Stats
+        {
+            std::uint32_t size        = 0;
+            std::uint32_t used        = 0;
+            std::uint32_t free        = 0;
+            std::uint32_t largestFree = 0;
+            std::uint32_t freeRegions = 0;
+            std::uint32_t allocations = 0;
+
+            /**
+             * @brief 0 when all free space is one range, approaching 1 as it
+             *        splinters into many small ones.
+             */
+            float fragmentation() const
+            {
+                return free == 0 ? 0.0f : 1.0f - static_cast<float>(largestFree) / static_cast<float>(free);
+            }
+
+            /**
+             * @brief Fraction of the space handed out.
+             */
+            float occupancy() const
+            {
+                return size == 0 ? 0.0f : static_cast<float>(used) / static_cast<float>(size);
+            }
+        };
+
+        /**
+         * @param size      Extent of the managed space, in caller-defined units.
+         * @param maxAllocs Upper bound on live allocations plus free ranges.
+         */
+        explicit OffsetAllocator(std::uint32_t size, std::uint32_t maxAllocs = 128 * 1024);
+
+        /**
+         * @brief Reserves @p size contiguous units.
+         *
+         * @return An invalid allocation if no free range is large enough or
+         *         the node pool is exhausted.
+         */
+        Allocation allocate(std::uint32_t size);
+
+        /**
+         * @brief Returns a range obtained from allocate(). Invalid allocations are ignored.
+         */
+        void free(Allocation allocation);
+
+        /**
+         * @brief Frees everything at once.
+         */
+        void reset();
+
+        /**
+         * @brief Size of a live allocation.
+         */
+        std::uint32_t allocationSize(Allocation allocation) const;
+
+        /**
+         * @brief Walks the bins; meant for debug overlays and logs, not per-draw use.
+         */
+        Stats getStats() const;
+
+      private:
+        static constexpr std::uint32_t kTopBins     = 32;
+        static constexpr std::uint32_t kBinsPerLeaf = 8;
+        static constexpr std::uint32_t kLeafBins    = kTopBins * kBinsPerLeaf;
+        static constexpr std::uint32_t kUnused      = 0xffffffffu;
+
+        struct Node
+        {
+            std::uint32_t offset       = 0;
+            std::uint32_t size         = 0;
+            std::uint32_t binListPrev  = kUnused;
+            std::uint32_t binListNext  = kUnused;
+            std::uint32_t neighborPrev = kUnused;
+            std::uint32_t neighborNext = kUnused;
+            bool          used         = false;
+        };
+
+        std::uint32_t m_size;
+        std::uint32_t m_maxAllocs;
+        std::uint32_t m_freeStorage;
+        std::uint32_t m_allocations;
+
+        std::uint32_t              m_usedBinsTop;
+        std::uint8_t               m_usedBins[kTopBins];
+        std::uint32_t              m_binIndices[kLeafBins];
+        std::vector<Node>          m_nodes;
+        std::vector<std::uint32_t> m_freeNodes; ///< Stack of unused node indices.
+        std::uint32_t              m_freeCount;
+
+        std::uint32_t insertNodeIntoBin(std::uint32_t size, std::uint32_t offset);
+        void removeNodeFromBin(std::uint32_t nodeIndex);
+    };
+} // namespace Core
+
+#endif // LEARNOPENGL_OFFSET_ALLOCATOR_H
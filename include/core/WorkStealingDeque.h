@@ -0,0 +1,153 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_WORK_STEALING_DEQUE_H
+#define LEARNOPENGL_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Core
+{
+    /**
+     * @brief Fixed-capacity Chase-Lev deque of pointers.
+     *
+     * The owning thread pushes and pops at the bottom, LIFO, so it keeps
+     * working on the data it just touched; any other thread steals from the
+     * top, FIFO, taking the oldest and usually largest piece of work. Only
+     * the last element is contended, and that race is settled with a single
+     * CAS on top. Memory orderings follow Lê et al., "Correct and Efficient
+     * Work-Stealing for Weak Memory Models" (PPoPP 2013).
+     *
+     * The ring does not grow, so no stealer can ever read a freed buffer;
+     * push() fails instead and the caller runs the work itself.
+     */
+    template <typename T>
+    class WorkStealingDeque
+    {
+      public:
+        /**
+         * @param capacity Rounded up to a power of two.
+         */
+        explicit WorkStealingDeque(std::size_t capacity = 4096)
+            : m_capacity(roundUp(capacity))
+            , m_mask(static_cast<std::int64_t>(m_capacity) - 1)
+            , m_items(std::make_unique<std::atomic<T*>[]>(m_capacity))
+            , m_top(0)
+            , m_bottom(0)
+        {}
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        /**
+         * @brief Owner only. Returns false when the deque is full.
+         */
+        bool push(T* item)
+        {
+            const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            const std::int64_t top = m_top.load(std::memory_order_acquire);
+            if (bottom - top >= static_cast<std::int64_t>(m_capacity))
+            {
+                return false;
+            }
+
+            // Publishes the item to stealers that acquire bottom
+            m_items[bottom & m_mask].store(item, std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Owner only. Returns the newest item, or null when empty.
+         */
+        T* pop()
+        {
+            const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* item = m_items[bottom & m_mask].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // Last item: race the stealers for it
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        /**
+         * @brief Any thread. Returns the oldest item, or null when empty or
+         *        when another thread won the race for it.
+         */
+        T* steal()
+        {
+            std::int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+
+            T* item = m_items[top & m_mask].load(std::memory_order_relaxed);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return item;
+        }
+
+        /**
+         * @brief Approximate when other threads are pushing or stealing.
+         */
+        std::size_t size() const
+        {
+            const std::int64_t count = m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed);
+            return count > 0 ? static_cast<std::size_t>(count) : 0;
+        }
+
+        std::size_t capacity() const
+        {
+            return m_capacity;
+        }
+
+      private:
+        // Owner-written bottom and stealer-written top on separate cache lines
+        static constexpr std::size_t kCacheLine = 64;
+
+        std::size_t                        m_capacity;
+        std::int64_t                       m_mask;
+        std::unique_ptr<std::atomic<T*>[]> m_items;
+        alignas(kCacheLine) std::atomic<std::int64_t> m_top;
+        alignas(kCacheLine) std::atomic<std::int64_t> m_bottom;
+
+        static std::size_t roundUp(const std::size_t capacity)
+        {
+            std::size_t size = 2;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+            return size;
+        }
+    };
+} // namespace Core
+
+#endif // LEARNOPENGL_WORK_STEALING_DEQUE_H
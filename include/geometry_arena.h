@@ -0,0 +1,153 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_GEOMETRY_ARENA_H
+#define LEARNOPENGL_GEOMETRY_ARENA_H
+
+#include <cstdint>
+#include <glad/glad.h>
+
+#include "core/Config.h"
+#include "core/OffsetAllocator.h"
+#include "index_buffer.h"
+#include "vertex_array_cache.h"
+#include "vertex_buffer.h"
+#include "vertex_layout.h"
+
+/**
+ * @brief Shared vertex and index storage for every mesh of one vertex layout.
+ *
+ * Instead of a VBO, an IBO and a VAO per mesh, the arena owns one large
+ * vertex buffer and one large index buffer, drawn through a VAO from a
+ * VertexArrayCache, which arenas of the same layout share when direct state
+ * access is available. Indices are 16-bit when the vertex capacity allows
+ * it and 32-bit otherwise.
+ * Ranges of each are handed out by a Core::OffsetAllocator, so meshes can
+ * be added and removed in any order and freed space is reused. Drawing a
+ * mesh is a glDrawElementsBaseVertex into its ranges: indices stay local to
+ * the mesh and the base vertex shifts them to where its vertices landed.
+ * @code
+ *   GeometryArena arena {layout, vertexArrays, config.geometry};
+ *   const GeometryArena::Mesh quad = arena.add(vertices, 4, indices, 6);
+ *   arena.bind();
+ *   arena.draw(quad);
+ * @endcode
+ * Switching between meshes of the same arena needs no buffer or VAO bind.
+ */
+class GeometryArena
+{
+  public:
+    /**
+     * @brief Handle to one mesh's ranges in the arena.
+     */
+    struct Mesh
+    {
+        GLint   baseVertex  = 0; ///< First vertex, in vertices.
+        GLuint  vertexCount = 0;
+        GLuint  firstIndex  = 0; ///< First index, in indices.
+        GLsizei indexCount  = 0;
+
+        Core::OffsetAllocator::Allocation vertexAllocation;
+        Core::OffsetAllocator::Allocation indexAllocation;
+
+        bool isValid() const
+        {
+            return vertexAllocation.isValid() && indexAllocation.isValid();
+        }
+    };
+
+    struct Stats
+    {
+        Core::OffsetAllocator::Stats vertices; ///< In vertices.
+        Core::OffsetAllocator::Stats indices;  ///< In indices.
+        std::uint32_t                meshes = 0;
+    };
+
+    /**
+     * @brief Allocates both buffers at full capacity.
+     *
+     * @param layout       Attributes of every vertex stored in the arena.
+     * @param vertexArrays Supplies the VAO; must outlive the arena.
+     */
+    GeometryArena(VertexLayout layout, VertexArrayCache& vertexArrays, const Core::GeometryArenaConfig& config = {});
+
+    ~GeometryArena();
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    /**
+     * @brief Copies a mesh into the arena.
+     *
+     * @param vertices vertexCount vertices laid out as getLayout() describes.
+     * @param indices  indexCount indices, relative to the mesh's first vertex;
+     *                 narrowed to 16 bits when the arena stores 16-bit indices.
+     *
+     * @return An invalid handle when either buffer has no free range large enough.
+     */
+    Mesh add(const void* vertices, std::uint32_t vertexCount, const std::uint32_t* indices, std::uint32_t indexCount);
+
+    /**
+     * @brief Returns a mesh's ranges for reuse. The GPU may still be reading
+     *        them, so only remove meshes whose last draw has completed or
+     *        overwrite them after the frame's fence.
+     */
+    void remove(Mesh& mesh);
+
+    /**
+     * @brief Binds a VAO reading the arena's buffers.
+     */
+    void bind() const;
+
+    /**
+     * @brief Binds a VAO reading the arena's buffers per vertex and
+     *        @p instanceLayout per instance from @p instanceBuffer.
+     */
+    void bindInstanced(const VertexLayout& instanceLayout, GLuint instanceBuffer, GLintptr instanceOffset) const;
+
+    /**
+     * @brief Draws one mesh. The arena must be bound.
+     */
+    void draw(const Mesh& mesh, GLenum mode = GL_TRIANGLES) const;
+
+    /**
+     * @brief Draws @p instanceCount copies of one mesh. The arena must be
+     *        bound with bindInstanced().
+     */
+    void drawInstanced(const Mesh& mesh, GLsizei instanceCount, GLenum mode = GL_TRIANGLES) const;
+
+    /**
+     * @brief Occupancy and fragmentation of both buffers.
+     */
+    Stats getStats() const;
+
+    const VertexLayout& getLayout() const
+    {
+        return m_layout;
+    }
+
+    /**
+     * @brief GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, for draws issued outside draw().
+     */
+    GLenum getIndexType() const
+    {
+        return m_indices.getType();
+    }
+
+    size_t getIndexSize() const
+    {
+        return m_indices.getIndexSize();
+    }
+
+  private:
+    VertexLayout          m_layout;
+    VertexBuffer          m_vertices;
+    IndexBuffer           m_indices;
+    VertexArrayCache&     m_vertexArrays;
+    Core::OffsetAllocator m_vertexAllocator;
+    Core::OffsetAllocator m_indexAllocator;
+    std::uint32_t         m_meshes;
+};
+
+#endif // LEARNOPENGL_GEOMETRY_ARENA_H
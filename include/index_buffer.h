@@ -0,0 +1,118 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_INDEX_BUFFER_H
+#define LEARNOPENGL_INDEX_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glad/glad.h>
+#include <vector>
+
+/**
+ * @brief RAII wrapper for an OpenGL element array buffer (IBO).
+ *
+ * Indices are stored as GL_UNSIGNED_SHORT whenever every index fits in
+ * 16 bits, halving the buffer and the index fetch bandwidth, and as
+ * GL_UNSIGNED_INT otherwise. Draw with getType():
+ * @code
+ *   const IndexBuffer ibo {indices, vertexCount};
+ *   ibo.bind();                                       // with the VAO bound
+ *   glDrawElements(GL_TRIANGLES, ibo.getCount(), ibo.getType(), nullptr);
+ * @endcode
+ */
+class IndexBuffer
+{
+  public:
+    /**
+     * @brief The smallest index type that can address @p vertexCount vertices.
+     */
+    static GLenum typeFor(size_t vertexCount);
+
+    /**
+     * @brief Size in bytes of one index of @p type.
+     */
+    static size_t sizeOf(GLenum type);
+
+    /**
+     * @brief Uploads @p indices, narrowed to 16 bits when they allow it.
+     *
+     * @param vertexCount Vertices the indices refer to; 0 derives it from the largest index.
+     * @param usage       OpenGL buffer usage hint (e.g., GL_STATIC_DRAW).
+     */
+    explicit IndexBuffer(const std::vector<std::uint32_t>& indices, size_t vertexCount = 0,
+                         GLenum usage = GL_STATIC_DRAW);
+
+    /**
+     * @brief Allocates uninitialized storage for @p count indices of @p type,
+     *        to be filled with updateData().
+     */
+    IndexBuffer(size_t count, GLenum type, GLenum usage = GL_STATIC_DRAW);
+
+    IndexBuffer(const IndexBuffer&) = delete;
+    IndexBuffer& operator=(const IndexBuffer&) = delete;
+
+    IndexBuffer(IndexBuffer&& other) noexcept;
+    IndexBuffer& operator=(IndexBuffer&& other) noexcept;
+
+    /**
+     * @brief Destructor. Automatically deletes the OpenGL buffer.
+     */
+    ~IndexBuffer();
+
+    /**
+     * @brief Binds the buffer to GL_ELEMENT_ARRAY_BUFFER, which the bound VAO records.
+     */
+    void bind() const;
+
+    /**
+     * @brief Writes @p count indices of getType() starting at index @p first.
+     *
+     * Goes through GL_COPY_WRITE_BUFFER, so the element array binding of the
+     * current VAO is left alone.
+     */
+    void updateData(const void* indices, size_t count, size_t first = 0);
+
+    /**
+     * @brief Returns the OpenGL buffer ID.
+     */
+    unsigned int getID() const
+    {
+        return m_id;
+    }
+
+    /**
+     * @brief Number of indices the buffer holds.
+     */
+    GLsizei getCount() const
+    {
+        return static_cast<GLsizei>(m_count);
+    }
+
+    /**
+     * @brief GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+     */
+    GLenum getType() const
+    {
+        return m_type;
+    }
+
+    /**
+     * @brief Size in bytes of one index.
+     */
+    size_t getIndexSize() const
+    {
+        return sizeOf(m_type);
+    }
+
+  private:
+    unsigned int m_id;
+    size_t       m_count;
+    GLenum       m_type;
+
+    void createBuffer(const void* data, size_t size, GLenum usage);
+    void release();
+};
+
+#endif // LEARNOPENGL_INDEX_BUFFER_H
@@ -0,0 +1,152 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_INSTANCE_BATCH_H
+#define LEARNOPENGL_INSTANCE_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "core/Config.h"
+#include "geometry_arena.h"
+#include "vertex_buffer.h"
+#include "vertex_layout.h"
+
+/**
+ * @brief Per-instance attributes read by InstanceBatch draws, at locations
+ *        4-9 so they never collide with a mesh's own vertex attributes.
+ *
+ * See shaders/instance_data.glsl for the matching declarations.
+ */
+struct InstanceData
+{
+    glm::mat4 transform; ///< Locations 4-7, one column each.
+    glm::vec4 color;     ///< Location 8.
+    glm::vec4 custom;    ///< Location 9, free for the shader to interpret.
+};
+
+static_assert(sizeof(InstanceData) == 96, "InstanceData must stay tightly packed");
+
+template <>
+struct VertexTraits<InstanceData>
+{
+    static constexpr auto layout = makeVertexLayout<InstanceData>(
+        VertexAttribute::make(4, VertexFormat::Float4, offsetof(InstanceData, transform) + 0 * sizeof(glm::vec4)),
+        VertexAttribute::make(5, VertexFormat::Float4, offsetof(InstanceData, transform) + 1 * sizeof(glm::vec4)),
+        VertexAttribute::make(6, VertexFormat::Float4, offsetof(InstanceData, transform) + 2 * sizeof(glm::vec4)),
+        VertexAttribute::make(7, VertexFormat::Float4, offsetof(InstanceData, transform) + 3 * sizeof(glm::vec4)),
+        VERTEX_ATTRIBUTE(InstanceData, color, 8),
+        VERTEX_ATTRIBUTE(InstanceData, custom, 9));
+    static_assert(layout.isValid());
+};
+
+/**
+ * @brief Draws many copies of a GeometryArena mesh with one
+ *        glDrawElementsInstancedBaseVertex each.
+ *
+ * Instances are written every frame into a streaming VertexBuffer —
+ * persistently mapped when the driver allows it — and fed to the vertex
+ * shader as attributes with a divisor of 1, so a thousand copies cost one
+ * draw call instead of a thousand uniform updates and draws.
+ * @code
+ *   batch.beginFrame();
+ *   const InstanceBatch::Range trees = batch.write(treeInstances.data(), treeCount);
+ *   batch.flush();
+ *   program.bind();
+ *   batch.draw(arena, treeMesh, trees);
+ *   batch.endFrame();
+ * @endcode
+ * The instance attributes are sourced at the range's byte offset, so no
+ * base instance (GL 4.2) is needed; with direct state access moving to the
+ * next range is a single glVertexArrayVertexBuffer.
+ */
+class InstanceBatch
+{
+  public:
+    /**
+     * @brief Instances written by one write() call.
+     */
+    struct Range
+    {
+        GLintptr offset = 0; ///< Absolute byte offset in the instance buffer.
+        GLsizei  count  = 0;
+    };
+
+    /**
+     * @brief Draws of the current frame; beginFrame() clears them.
+     */
+    struct Stats
+    {
+        std::uint32_t instances = 0; ///< Instances drawn.
+        std::uint32_t drawCalls = 0;
+    };
+
+    /**
+     * @brief Allocates room for config.maxInstances per frame in flight.
+     */
+    explicit InstanceBatch(const Core::InstanceBatchConfig& config = {});
+
+    InstanceBatch(const InstanceBatch&) = delete;
+    InstanceBatch& operator=(const InstanceBatch&) = delete;
+
+    /**
+     * @brief Waits until the GPU released the next region; see VertexBuffer::beginFrame().
+     *
+     * Also resets the stats, so getStats() always describes one frame.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Copies @p count instances into the current frame.
+     *
+     * @throws std::runtime_error if the frame already holds maxInstances.
+     */
+    Range write(const InstanceData* instances, std::uint32_t count);
+
+    /**
+     * @brief Makes the frame's writes visible. Call before the first draw().
+     */
+    void flush();
+
+    /**
+     * @brief Draws one copy of @p mesh per instance in @p range; leaves the
+     *        instanced VAO bound.
+     */
+    void draw(const GeometryArena& arena, const GeometryArena::Mesh& mesh, const Range& range,
+              GLenum mode = GL_TRIANGLES);
+
+    /**
+     * @brief Fences the frame's region. Call after the frame's last draw().
+     */
+    void endFrame();
+
+    /**
+     * @brief The per-instance layout, for VAOs built outside draw().
+     */
+    static const VertexLayout& layout();
+
+    GLuint getBufferID() const
+    {
+        return m_buffer.getID();
+    }
+
+    std::uint32_t getCapacity() const
+    {
+        return m_capacity;
+    }
+
+    const Stats& getStats() const
+    {
+        return m_stats;
+    }
+
+  private:
+    VertexBuffer  m_buffer;
+    std::uint32_t m_capacity;
+    Stats         m_stats;
+};
+
+#endif // LEARNOPENGL_INSTANCE_BATCH_H
@@ -0,0 +1,82 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_MESH_OPTIMIZER_H
+#define LEARNOPENGL_MESH_OPTIMIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Load-time passes that make indexed triangle lists cheaper to draw.
+ *
+ * Run in this order, which optimize() does:
+ *  1. weld() merges bit-identical vertices, so a vertex shared by several
+ *     triangles is shaded once instead of once per triangle;
+ *  2. optimizeVertexCache() reorders triangles (Forsyth's linear-speed
+ *     algorithm) so consecutive triangles reuse the vertices still in the
+ *     GPU's post-transform cache;
+ *  3. optimizeVertexFetch() reorders vertices into first-use order, so the
+ *     vertex fetch walks memory mostly sequentially.
+ *
+ * Vertices are opaque records of `stride` bytes and are rewritten in place;
+ * only triangle lists are handled. The average cache miss ratio (ACMR,
+ * transformed vertices per triangle: 3 for an unindexed list, about 0.5 for
+ * an ideal regular grid) measures the result.
+ */
+class MeshOptimizer
+{
+  public:
+    /// FIFO size assumed by the reordering and by acmr().
+    static constexpr unsigned kCacheSize = 32;
+
+    struct Report
+    {
+        std::size_t vertexCountBefore = 0;
+        std::size_t vertexCountAfter  = 0;
+        float       acmrBefore        = 0.0f;
+        float       acmrAfter         = 0.0f;
+    };
+
+    /**
+     * @brief Runs every pass.
+     *
+     * @param indices     Triangle list; an empty list treats the vertices as unindexed.
+     * @param vertexCount Updated to the number of vertices left.
+     */
+    static Report optimize(std::vector<std::uint32_t>& indices, void* vertices, std::size_t& vertexCount,
+                           std::size_t stride);
+
+    /**
+     * @brief Merges vertices whose bytes are identical and remaps @p indices.
+     *
+     * @return The number of unique vertices, now packed at the front.
+     */
+    static std::size_t weld(std::vector<std::uint32_t>& indices, void* vertices, std::size_t vertexCount,
+                            std::size_t stride);
+
+    /**
+     * @brief Reorders triangles for post-transform cache reuse.
+     */
+    static void optimizeVertexCache(std::vector<std::uint32_t>& indices, std::size_t vertexCount);
+
+    /**
+     * @brief Reorders vertices in order of first use and drops unreferenced ones.
+     *
+     * @return The number of vertices left.
+     */
+    static std::size_t optimizeVertexFetch(std::vector<std::uint32_t>& indices, void* vertices,
+                                           std::size_t vertexCount, std::size_t stride);
+
+    /**
+     * @brief Simulates a FIFO post-transform cache of @p cacheSize entries.
+     *
+     * @return Cache misses per triangle.
+     */
+    static float acmr(const std::vector<std::uint32_t>& indices, std::size_t vertexCount,
+                      unsigned cacheSize = kCacheSize);
+};
+
+#endif // LEARNOPENGL_MESH_OPTIMIZER_H
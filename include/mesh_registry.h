@@ -0,0 +1,175 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_MESH_REGISTRY_H
+#define LEARNOPENGL_MESH_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glad/glad.h>
+#include <unordered_map>
+#include <vector>
+
+#include "geometry_arena.h"
+
+/**
+ * @brief Persistent draw list for meshes of one GeometryArena, submitted a
+ *        whole material bucket at a time.
+ *
+ * Every registered draw keeps its parameters as a DrawElementsIndirectCommand
+ * and a fixed-size per-draw record (transform, material index...) in its
+ * bucket. Buckets are uploaded only after they change; rendering one is a
+ * single glMultiDrawElementsIndirect call, the shader reading its record
+ * from an SSBO at gl_DrawIDARB. See shaders/draw_data.glsl; programs must be
+ * built with kDefine when usesMultiDrawIndirect() is true.
+ *
+ * Without Platform::glExtensions().multiDrawIndirect (a plain GL 3.3
+ * context), or when the constructor is told not to use it, the same bucket
+ * is drawn by a CPU loop: one
+ * glDrawElementsBaseVertex per draw, with its record bound as the
+ * kBlockName uniform block via glBindBufferRange. The constructor registers
+ * that block's binding, so it must run before the programs are linked.
+ * The C++ mirror of the record is read as std140, so check it with
+ * STD140_ASSERT (see shader/std140.h).
+ * @code
+ *   MeshRegistry registry {arena, sizeof(DrawRecord)};
+ *   const MeshRegistry::Handle h = registry.add(mesh, materialId, &record);
+ *   program.bind();
+ *   registry.render(materialId);
+ * @endcode
+ */
+class MeshRegistry
+{
+  public:
+    using Handle = std::uint32_t;
+
+    static constexpr Handle      kInvalidHandle = 0xffffffffu;
+    static constexpr const char* kDefine        = "MULTI_DRAW_INDIRECT";
+    static constexpr const char* kBlockName     = "DrawDataBlock";
+
+    /**
+     * @brief The layout glMultiDrawElementsIndirect reads.
+     */
+    struct DrawElementsIndirectCommand
+    {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint  baseVertex;
+        GLuint baseInstance;
+    };
+    static_assert(sizeof(DrawElementsIndirectCommand) == 20,
+                  "glMultiDrawElementsIndirect reads 5 tightly packed words");
+
+    struct Stats
+    {
+        std::uint32_t draws       = 0; ///< Draws rendered.
+        std::uint32_t submissions = 0; ///< GL draw calls issued for them.
+        std::uint32_t uploads     = 0; ///< Bucket re-uploads.
+    };
+
+    /**
+     * @param drawDataSize           Bytes of one per-draw record, a multiple of 16.
+     * @param binding                SSBO / uniform block binding point of the records.
+     * @param allowMultiDrawIndirect False forces the glBindBufferRange loop even
+     *                               when multi-draw indirect is available.
+     *
+     * @throws std::logic_error if @p drawDataSize is 0 or not a multiple of 16.
+     */
+    MeshRegistry(GeometryArena& arena, std::size_t drawDataSize, GLuint binding = 0,
+                 bool allowMultiDrawIndirect = true);
+
+    /**
+     * @brief Deletes every bucket's buffers.
+     */
+    ~MeshRegistry();
+
+    MeshRegistry(const MeshRegistry&) = delete;
+    MeshRegistry& operator=(const MeshRegistry&) = delete;
+
+    /**
+     * @brief Registers one draw of @p mesh in @p bucket.
+     *
+     * @param drawData drawDataSize bytes, copied.
+     */
+    Handle add(const GeometryArena::Mesh& mesh, std::uint32_t bucket, const void* drawData,
+               GLuint instanceCount = 1);
+
+    /**
+     * @brief Replaces the per-draw record of @p handle.
+     *
+     * @throws std::logic_error if @p handle is not registered.
+     */
+    void update(Handle handle, const void* drawData);
+
+    /**
+     * @brief Unregisters a draw. The last draw of its bucket takes its slot
+     *        and the handle is recycled by a later add().
+     *
+     * @throws std::logic_error if @p handle is not registered.
+     */
+    void remove(Handle handle);
+
+    /**
+     * @brief Draws every draw of @p bucket with the currently bound program.
+     */
+    void render(std::uint32_t bucket);
+
+    bool usesMultiDrawIndirect() const
+    {
+        return m_multiDrawIndirect;
+    }
+
+    /**
+     * @brief Number of registered draws across all buckets.
+     */
+    std::size_t size() const
+    {
+        return m_handles.size() - m_freeHandles.size();
+    }
+
+    const Stats& getStats() const
+    {
+        return m_stats;
+    }
+
+  private:
+    struct Bucket
+    {
+        std::vector<DrawElementsIndirectCommand> commands;
+        std::vector<unsigned char>               data; ///< One m_dataStride slot per command.
+        std::vector<Handle>                      owners;
+
+        GLuint      commandBuffer   = 0;
+        GLuint      dataBuffer      = 0;
+        std::size_t commandCapacity = 0; ///< Bytes.
+        std::size_t dataCapacity    = 0; ///< Bytes.
+        bool        dirty           = false;
+    };
+
+    /// Location::index of a removed handle.
+    static constexpr std::uint32_t kRemoved = 0xffffffffu;
+
+    struct Location
+    {
+        std::uint32_t bucket = 0;
+        std::uint32_t index  = kRemoved;
+    };
+
+    GeometryArena& m_arena;
+    std::size_t    m_drawDataSize;
+    std::size_t    m_dataStride; ///< Record size, padded to the UBO offset alignment on the fallback path.
+    GLuint         m_binding;
+    bool           m_multiDrawIndirect;
+
+    std::unordered_map<std::uint32_t, Bucket> m_buckets;
+    std::vector<Location>                     m_handles;
+    std::vector<Handle>                       m_freeHandles;
+    Stats                                     m_stats;
+
+    const Location& locate(Handle handle) const;
+    void            upload(Bucket& bucket);
+};
+
+#endif // LEARNOPENGL_MESH_REGISTRY_H
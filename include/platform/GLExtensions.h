@@ -0,0 +1,106 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_GLEXTENSIONS_H
+#define LEARNOPENGL_GLEXTENSIONS_H
+
+#include <string_view>
+
+#include "glad/glad.h"
+
+// -------------------------------------------------------
+// Entry points and enums beyond the generated GL 4.1 glad loader.
+// Declared the same way glad declares its own, so call sites read like
+// plain GL. Only valid when the matching GLExtensions flag is set.
+// -------------------------------------------------------
+
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void(APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glad_glMaxShaderCompilerThreadsKHR;
+#define glMaxShaderCompilerThreadsKHR glad_glMaxShaderCompilerThreadsKHR
+
+// GL_ARB_buffer_storage (core in 4.4)
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_CLIENT_STORAGE_BIT 0x0200
+#define GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT 0x00004000
+#define GL_BUFFER_IMMUTABLE_STORAGE 0x821F
+#define GL_BUFFER_STORAGE_FLAGS 0x8220
+typedef void(APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+extern PFNGLBUFFERSTORAGEPROC glad_glBufferStorage;
+#define glBufferStorage glad_glBufferStorage
+
+// GL_ARB_direct_state_access (core in 4.5), vertex array subset; needs GL_ARB_vertex_attrib_binding
+typedef void(APIENTRYP PFNGLCREATEVERTEXARRAYSPROC)(GLsizei n, GLuint* arrays);
+typedef void(APIENTRYP PFNGLENABLEVERTEXARRAYATTRIBPROC)(GLuint vaobj, GLuint index);
+typedef void(APIENTRYP PFNGLVERTEXARRAYATTRIBFORMATPROC)(GLuint vaobj, GLuint attribindex, GLint size, GLenum type,
+                                                         GLboolean normalized, GLuint relativeoffset);
+typedef void(APIENTRYP PFNGLVERTEXARRAYATTRIBBINDINGPROC)(GLuint vaobj, GLuint attribindex, GLuint bindingindex);
+typedef void(APIENTRYP PFNGLVERTEXARRAYVERTEXBUFFERPROC)(GLuint vaobj, GLuint bindingindex, GLuint buffer,
+                                                         GLintptr offset, GLsizei stride);
+typedef void(APIENTRYP PFNGLVERTEXARRAYELEMENTBUFFERPROC)(GLuint vaobj, GLuint buffer);
+typedef void(APIENTRYP PFNGLVERTEXARRAYBINDINGDIVISORPROC)(GLuint vaobj, GLuint bindingindex, GLuint divisor);
+extern PFNGLCREATEVERTEXARRAYSPROC        glad_glCreateVertexArrays;
+extern PFNGLENABLEVERTEXARRAYATTRIBPROC   glad_glEnableVertexArrayAttrib;
+extern PFNGLVERTEXARRAYATTRIBFORMATPROC   glad_glVertexArrayAttribFormat;
+extern PFNGLVERTEXARRAYATTRIBBINDINGPROC  glad_glVertexArrayAttribBinding;
+extern PFNGLVERTEXARRAYVERTEXBUFFERPROC   glad_glVertexArrayVertexBuffer;
+extern PFNGLVERTEXARRAYELEMENTBUFFERPROC  glad_glVertexArrayElementBuffer;
+extern PFNGLVERTEXARRAYBINDINGDIVISORPROC glad_glVertexArrayBindingDivisor;
+#define glCreateVertexArrays glad_glCreateVertexArrays
+#define glEnableVertexArrayAttrib glad_glEnableVertexArrayAttrib
+#define glVertexArrayAttribFormat glad_glVertexArrayAttribFormat
+#define glVertexArrayAttribBinding glad_glVertexArrayAttribBinding
+#define glVertexArrayVertexBuffer glad_glVertexArrayVertexBuffer
+#define glVertexArrayElementBuffer glad_glVertexArrayElementBuffer
+#define glVertexArrayBindingDivisor glad_glVertexArrayBindingDivisor
+
+// GL_ARB_multi_draw_indirect (core in 4.3), used with GL_ARB_shader_storage_buffer_object
+// and GL_ARB_shader_draw_parameters
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+typedef void(APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void* indirect,
+                                                           GLsizei drawcount, GLsizei stride);
+extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC glad_glMultiDrawElementsIndirect;
+#define glMultiDrawElementsIndirect glad_glMultiDrawElementsIndirect
+
+namespace Platform
+{
+    /**
+     * @brief Optional GL features detected on the current context.
+     *
+     * Filled by loadGLExtensions(); every flag stays false on drivers that do
+     * not advertise the feature, and callers fall back to the core 3.3 path.
+     */
+    struct GLExtensions
+    {
+        bool parallelShaderCompile = false; ///< KHR/ARB_parallel_shader_compile
+        bool bufferStorage         = false; ///< ARB_buffer_storage
+        bool directStateAccess     = false; ///< ARB_direct_state_access + ARB_vertex_attrib_binding
+        bool multiDrawIndirect     = false; ///< ARB_multi_draw_indirect + SSBOs + gl_DrawIDARB
+    };
+
+    /**
+     * @brief Detects optional features and loads their entry points.
+     *
+     * Call once, right after gladLoadGLLoader, with the same loader.
+     *
+     * @return False if the context reports no extension list at all.
+     */
+    bool loadGLExtensions(GLADloadproc load);
+
+    /**
+     * @brief Returns the features detected by the last loadGLExtensions() call.
+     */
+    const GLExtensions& glExtensions();
+
+    /**
+     * @brief Returns true if the current context advertises @p name.
+     */
+    bool hasGLExtension(std::string_view name);
+} // namespace Platform
+
+#endif // LEARNOPENGL_GLEXTENSIONS_H
@@ -0,0 +1,170 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_GLSTATE_H
+#define LEARNOPENGL_GLSTATE_H
+
+#include <array>
+#include <cstdint>
+
+#include "glad/glad.h"
+
+namespace Platform
+{
+    /**
+     * @brief Shadow copy of the bindings and fixed-function state of the
+     *        current context; calls that would not change anything are
+     *        dropped before they reach the driver.
+     *
+     * Tracked: program and program pipeline, vertex array, the draw-side
+     * buffer targets (array, element array, uniform, draw indirect, shader
+     * storage) with their indexed bindings, texture units and samplers,
+     * blend, depth, cull and viewport. Transfer targets (copy and pixel
+     * buffers) are bound and released around each copy, so bindBuffer()
+     * passes them straight through.
+     *
+     * The shadow is only right if every change to tracked state goes through
+     * this class, so wrappers bind through it and call the matching forget*()
+     * when they delete an object. Code that changes state behind its back,
+     * such as a third-party renderer, must call invalidate() afterwards.
+     *
+     * Everything starts unknown, so the first call of each kind is always
+     * issued.
+     */
+    class GLState
+    {
+      public:
+        static constexpr GLuint kMaxTextureUnits    = 32;
+        static constexpr GLuint kMaxIndexedBindings = 16;
+
+        struct Stats
+        {
+            std::uint32_t issued   = 0; ///< Calls forwarded to GL.
+            std::uint32_t filtered = 0; ///< Calls dropped as redundant.
+        };
+
+        GLState();
+
+        void useProgram(GLuint program);
+        void bindProgramPipeline(GLuint pipeline);
+
+        /**
+         * @brief Binds a VAO. The element array binding belongs to the VAO,
+         *        so it becomes unknown when the VAO changes.
+         */
+        void bindVertexArray(GLuint vertexArray);
+
+        void bindBuffer(GLenum target, GLuint buffer);
+
+        /**
+         * @brief Indexed binds also replace the generic binding of @p target.
+         */
+        void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+        void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Binds @p texture to @p target of @p unit, switching the
+         *        active unit only when the binding changes.
+         */
+        void bindTexture(GLuint unit, GLenum target, GLuint texture);
+        void bindSampler(GLuint unit, GLuint sampler);
+
+        void setBlend(bool enabled);
+        void setBlendFunc(GLenum source, GLenum destination);
+        void setDepthTest(bool enabled);
+        void setDepthWrite(bool enabled);
+        void setDepthFunc(GLenum func);
+        void setCullFace(bool enabled);
+        void setCullMode(GLenum face);
+        void setViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+        /**
+         * @brief Call when deleting an object: GL unbinds deleted buffers,
+         *        VAOs, textures and samplers by itself, and a recycled name
+         *        must not look bound already.
+         */
+        void forgetBuffer(GLuint buffer);
+        void forgetVertexArray(GLuint vertexArray);
+        void forgetProgram(GLuint program);
+        void forgetPipeline(GLuint pipeline);
+        void forgetTexture(GLuint texture);
+        void forgetSampler(GLuint sampler);
+
+        /**
+         * @brief Marks everything unknown, after state changed outside this class.
+         */
+        void invalidate();
+
+        const Stats& getStats() const
+        {
+            return m_stats;
+        }
+
+        void resetStats()
+        {
+            m_stats = {};
+        }
+
+      private:
+        static constexpr GLuint kUnknown        = 0xffffffffu;
+        static constexpr int    kBufferTargets  = 5;
+        static constexpr int    kTextureTargets = 5;
+
+        struct IndexedBinding
+        {
+            GLuint     buffer = kUnknown;
+            GLintptr   offset = 0;
+            GLsizeiptr size   = 0; ///< 0 for a whole-buffer glBindBufferBase.
+        };
+
+        using IndexedBindings = std::array<IndexedBinding, kMaxIndexedBindings>;
+
+        GLuint m_program;
+        GLuint m_pipeline;
+        GLuint m_vertexArray;
+        GLuint m_activeUnit;
+
+        std::array<GLuint, kBufferTargets>                                  m_buffers;
+        IndexedBindings                                                     m_uniformBindings;
+        IndexedBindings                                                     m_storageBindings;
+        std::array<std::array<GLuint, kTextureTargets>, kMaxTextureUnits>   m_textures;
+        std::array<GLuint, kMaxTextureUnits>                                m_samplers;
+
+        // Booleans are stored as GLuint so they share the kUnknown sentinel
+        GLuint                m_blend;
+        std::array<GLenum, 2> m_blendFunc;
+        GLuint                m_depthTest;
+        GLuint                m_depthWrite;
+        GLenum                m_depthFunc;
+        GLuint                m_cullFace;
+        GLenum                m_cullMode;
+        std::array<GLint, 4>  m_viewport;
+        bool                  m_viewportKnown;
+
+        Stats m_stats;
+
+        /**
+         * @brief Stores @p value in @p slot and returns true if the call must be issued.
+         */
+        bool update(GLuint& slot, GLuint value);
+
+        void setCapability(GLuint& slot, GLenum capability, bool enabled);
+        void activeTexture(GLuint unit);
+
+        static int bufferSlot(GLenum target);
+        static int textureSlot(GLenum target);
+        IndexedBindings* indexedBindings(GLenum target);
+    };
+
+    /**
+     * @brief Returns the state tracker of the calling thread's context.
+     *
+     * A context is current on one thread at a time, and only the thread that
+     * made it current issues GL calls, so one tracker per thread is one per
+     * context. A thread that makes another context current must invalidate().
+     */
+    GLState& glState();
+} // namespace Platform
+
+#endif // LEARNOPENGL_GLSTATE_H
@@ -0,0 +1,53 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_MAPPEDFILE_H
+#define LEARNOPENGL_MAPPEDFILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace Platform
+{
+    /**
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * Uses mmap on POSIX and a file mapping object on Windows, so the
+     * contents are read straight from the page cache without a stream copy.
+     * The view stays valid for the lifetime of the object.
+     */
+    class MappedFile
+    {
+      public:
+        /**
+         * @brief Maps @p path. Check isOpen() before using view().
+         */
+        explicit MappedFile(const std::filesystem::path& path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /**
+         * @brief True if the file exists and could be mapped (empty files included).
+         */
+        [[nodiscard]] bool isOpen() const;
+
+        [[nodiscard]] std::string_view view() const;
+
+      private:
+        const char* m_data;
+        std::size_t m_size;
+        bool        m_open;
+
+        void release();
+    };
+} // namespace Platform
+
+#endif // LEARNOPENGL_MAPPEDFILE_H
@@ -0,0 +1,146 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_RENDER_QUEUE_H
+#define LEARNOPENGL_RENDER_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <glad/glad.h>
+#include <vector>
+
+#include "geometry_arena.h"
+
+class CommandBuffer;
+class ShaderProgram;
+
+/**
+ * @brief One frame's draws, sorted by a 64-bit key before submission so
+ *        draws sharing a program, material and arena run back to back.
+ *
+ * Key layout, most significant bit first:
+ * @code
+ *   opaque       | pass:4 | 0 | program:16 | material:16 | depth:24       | 0:3 |
+ *   translucent  | pass:4 | 1 | ~depth:24  | program:16  | material:16    | 0:3 |
+ * @endcode
+ * Passes run in order and opaque draws precede translucent ones within a
+ * pass. Opaque draws are grouped by state and drawn front to back inside a
+ * group, so early depth rejection skips hidden fragments; translucent draws
+ * must blend back to front, so the inverted depth comes before any state.
+ * Program and material ids wider than 16 bits are truncated: a collision
+ * only costs a state change, never a wrong draw, because the packet keeps
+ * the real objects.
+ *
+ * Keys are sorted with an LSD radix sort, 8 bits per pass, skipping digits
+ * every key shares — the constant and zero fields cost nothing. The sort is
+ * stable, so draws with equal keys keep the order they were pushed in.
+ * @code
+ *   queue.clear();
+ *   const std::uint64_t key = RenderQueue::makeKey(0, false, program.getId(), materialId, depth);
+ *   queue.push(key, {&program, &arena, mesh, materialId});
+ *   queue.submit([&](std::uint32_t material) { materials[material].bind(); });
+ * @endcode
+ */
+class RenderQueue
+{
+  public:
+    static constexpr unsigned kPassBits  = 4;
+    static constexpr unsigned kStateBits = 16;
+    static constexpr unsigned kDepthBits = 24;
+    static constexpr unsigned kMaxPasses = 1u << kPassBits;
+
+    /**
+     * @brief Everything needed to issue one draw.
+     */
+    struct DrawPacket
+    {
+        const ShaderProgram* program  = nullptr;
+        const GeometryArena* arena    = nullptr;
+        GeometryArena::Mesh  mesh;
+        std::uint32_t        material = 0; ///< Handed to the material binder when it changes.
+        GLenum               mode     = GL_TRIANGLES;
+    };
+
+    /**
+     * @brief State changes of the last submit(); compare against the packet
+     *        count to see what sorting saved.
+     */
+    struct Stats
+    {
+        std::uint32_t packets         = 0;
+        std::uint32_t programChanges  = 0;
+        std::uint32_t arenaChanges    = 0;
+        std::uint32_t materialChanges = 0;
+        std::uint32_t sortPasses      = 0; ///< Radix digits actually scattered.
+    };
+
+    using MaterialBinder   = std::function<void(std::uint32_t material)>;
+    using MaterialRecorder = std::function<void(CommandBuffer& commands, std::uint32_t material)>;
+
+    /**
+     * @brief Builds a sort key.
+     *
+     * @param pass  Render pass, below kMaxPasses.
+     * @param depth View depth normalized to [0, 1], clamped.
+     */
+    static std::uint64_t makeKey(unsigned pass, bool translucent, std::uint32_t program, std::uint32_t material,
+                                 float depth);
+
+    /**
+     * @brief Queues a draw. @p packet's program and arena must outlive submit().
+     */
+    void push(std::uint64_t key, const DrawPacket& packet);
+
+    /**
+     * @brief Sorts the queued draws by key and issues them, binding a
+     *        program, an arena or a material only when it changes.
+     *
+     * The queue keeps its draws; clear() it before recording the next frame.
+     */
+    void submit(const MaterialBinder& bindMaterial = {});
+
+    /**
+     * @brief Like submit(), but records the draws into @p commands instead
+     *        of issuing them, so sorting can run off the context thread.
+     */
+    void record(CommandBuffer& commands, const MaterialRecorder& recordMaterial = {});
+
+    /**
+     * @brief Drops every queued draw but keeps the allocations.
+     */
+    void clear();
+
+    std::size_t size() const
+    {
+        return m_items.size();
+    }
+
+    const Stats& getStats() const
+    {
+        return m_stats;
+    }
+
+  private:
+    struct Item
+    {
+        std::uint64_t key;
+        std::uint32_t packet;
+    };
+
+    std::vector<Item>       m_items;
+    std::vector<Item>       m_scratch;
+    std::vector<DrawPacket> m_packets;
+    Stats                   m_stats;
+
+    void sort();
+
+    /**
+     * @brief Sorts, then visits the draws, reporting only the state that changes.
+     */
+    template <typename BindProgram, typename BindArena, typename BindMaterial, typename Draw>
+    void walk(BindProgram&& bindProgram, BindArena&& bindArena, BindMaterial&& bindMaterial, Draw&& draw);
+};
+
+#endif // LEARNOPENGL_RENDER_QUEUE_H
@@ -0,0 +1,94 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_BINARY_CACHE_H
+#define LEARNOPENGL_SHADER_BINARY_CACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/Config.h"
+#include "glad/glad.h"
+
+class ShaderStage;
+
+/**
+ * @brief Persistent on-disk cache of linked program binaries.
+ *
+ * Each entry is one file named after its key, holding the output of
+ * glGetProgramBinary. The key covers the stage types, sources and defines
+ * plus the separable flag and the GL_RENDERER / GL_VERSION strings, so a driver update or a GPU
+ * swap simply misses instead of feeding the driver a stale binary.
+ *
+ * Recency is tracked with the file modification time, which a hit refreshes;
+ * when a store pushes the directory over the size cap the oldest entries are
+ * deleted first.
+ *
+ * Needs a current GL 4.1 context; on older contexts, or when the driver
+ * exposes no binary formats, every call is a miss and nothing is written.
+ */
+class ShaderBinaryCache
+{
+  public:
+    struct Stats
+    {
+        std::uint32_t hits      = 0;
+        std::uint32_t misses    = 0;
+        std::uint32_t stores    = 0;
+        std::uint32_t evictions = 0;
+        std::uint32_t rejected  = 0; ///< Binaries the driver refused to load.
+    };
+
+    explicit ShaderBinaryCache(const Core::ShaderCacheConfig& config = {});
+
+    ShaderBinaryCache(const ShaderBinaryCache&) = delete;
+    ShaderBinaryCache& operator=(const ShaderBinaryCache&) = delete;
+
+    /**
+     * @brief Computes the cache key for a set of stages on the current context.
+     *
+     * @param separable Whether the program is linked with GL_PROGRAM_SEPARABLE.
+     */
+    std::uint64_t makeKey(const std::vector<const ShaderStage*>& stages, bool separable = false);
+
+    /**
+     * @brief Restores a cached binary into @p program with glProgramBinary.
+     *
+     * Entries that are truncated, corrupt or refused by the driver are
+     * deleted and count as misses.
+     *
+     * @return True if the program is now linked; false on a miss, in which
+     *         case the caller compiles and links from source.
+     */
+    bool load(std::uint64_t key, GLuint program);
+
+    /**
+     * @brief Writes the binary of a freshly linked program and enforces the size cap.
+     *
+     * The program should have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+     */
+    void store(std::uint64_t key, GLuint program);
+
+    /**
+     * @brief Returns true if the directory is set and the driver supports binaries.
+     */
+    bool isEnabled();
+
+    const Stats& getStats() const;
+
+  private:
+    std::filesystem::path m_directory;
+    std::size_t           m_maxBytes;
+    Stats                 m_stats;
+
+    int         m_supported; ///< -1 until first queried from the context.
+    std::string m_deviceId;  ///< GL_RENDERER + GL_VERSION, filled on first use.
+
+    std::filesystem::path entryPath(std::uint64_t key) const;
+    void evict();
+};
+
+#endif // LEARNOPENGL_SHADER_BINARY_CACHE_H
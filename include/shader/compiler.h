@@ -0,0 +1,168 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_COMPILER_H
+#define LEARNOPENGL_SHADER_COMPILER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "glad/glad.h"
+
+class ShaderBinaryCache;
+class ShaderProgram;
+class ShaderStage;
+
+/**
+ * @brief Everything needed to build one ShaderStage off the main thread.
+ */
+struct ShaderStageDesc
+{
+    std::string              filepath;
+    GLenum                   type;
+    std::vector<std::string> defines {};
+};
+
+/**
+ * @brief Builds programs without stalling the render loop.
+ *
+ * File reads and preprocessing run on worker threads. update(), called once
+ * per frame on the context thread, submits loaded sources to the driver and
+ * then polls for completion. It never queries a compile or link status
+ * until the driver reports the work done through
+ * GL_KHR_parallel_shader_compile; without that extension the status is
+ * read one frame after the link was issued.
+ *
+ * @code
+ *   ShaderCompiler compiler {2, &cache};
+ *   auto pending = compiler.submit({{"shaders/a.vert", GL_VERTEX_SHADER},
+ *                                   {"shaders/a.frag", GL_FRAGMENT_SHADER}});
+ *   // per frame:
+ *   compiler.update();
+ *   if (pending.poll() == ShaderCompiler::Status::Ready)
+ *       program = pending.take();
+ * @endcode
+ */
+class ShaderCompiler
+{
+    struct Job;
+
+  public:
+    enum class Status
+    {
+        Loading, ///< Sources are being read on a worker thread.
+        Linking, ///< Submitted to the driver, not finished yet.
+        Ready,   ///< Linked; take() hands out the program.
+        Failed   ///< Load, compile or link error; see error().
+    };
+
+    /**
+     * @brief Future-like view of one submitted program.
+     *
+     * Only valid on the context thread, and only while the ShaderCompiler
+     * that produced it is alive.
+     */
+    class Handle
+    {
+      public:
+        Handle() = default;
+
+        /**
+         * @brief Current state; an empty handle reports Failed.
+         */
+        Status poll() const;
+
+        /**
+         * @brief Moves the linked program out. Call once, after poll() returned Ready.
+         */
+        ShaderProgram take();
+
+        /**
+         * @brief Error description when poll() returned Failed.
+         */
+        const std::string& error() const;
+
+      private:
+        friend class ShaderCompiler;
+
+        explicit Handle(std::shared_ptr<Job> job);
+
+        std::shared_ptr<Job> m_job;
+    };
+
+    /**
+     * @param workerCount Number of file-loading threads.
+     * @param cache       Optional binary cache consulted before compiling.
+     */
+    explicit ShaderCompiler(unsigned workerCount = 2, ShaderBinaryCache* cache = nullptr);
+
+    /**
+     * @brief Stops the workers. Unfinished programs are deleted.
+     */
+    ~ShaderCompiler();
+
+    ShaderCompiler(const ShaderCompiler&) = delete;
+    ShaderCompiler& operator=(const ShaderCompiler&) = delete;
+
+    /**
+     * @brief Queues a program build. Returns immediately.
+     *
+     * @param separable Link with GL_PROGRAM_SEPARABLE, see ShaderProgram::setSeparable().
+     */
+    Handle submit(std::vector<ShaderStageDesc> stages, bool separable = false);
+
+    /**
+     * @brief Advances in-flight builds. Call once per frame on the context thread.
+     */
+    void update();
+
+    /**
+     * @brief Number of submitted programs that are not Ready or Failed yet.
+     */
+    size_t pendingCount() const;
+
+    /**
+     * @brief Keeps compiled stages alive between builds.
+     *
+     * A later build whose stage has the same path, type, defines and source
+     * reuses the compiled shader object instead of compiling it again. Only
+     * the newest source of each stage is kept. Meant for hot reload, where
+     * one edited file should not recompile every stage linked with it.
+     */
+    void setRetainStages(bool retain);
+
+  private:
+    struct RetainedStage
+    {
+        std::uint64_t                      sourceHash;
+        std::shared_ptr<const ShaderStage> stage;
+    };
+
+    ShaderBinaryCache* m_cache;
+    bool               m_retainStages;
+
+    /// Keyed by hash of path, type and defines. Context thread only.
+    std::unordered_map<std::uint64_t, RetainedStage> m_retained;
+
+    std::vector<std::thread>         m_workers;
+    std::deque<std::shared_ptr<Job>> m_loadQueue;
+    std::mutex                       m_mutex;
+    std::condition_variable          m_wake;
+    bool                             m_stopping;
+
+    std::vector<std::shared_ptr<Job>> m_inFlight; ///< Context thread only.
+
+    void workerLoop();
+    std::shared_ptr<const ShaderStage> makeStage(const ShaderStageDesc& desc, std::string source);
+    void fail(Job& job, std::string error) const;
+};
+
+#endif // LEARNOPENGL_SHADER_COMPILER_H
@@ -0,0 +1,96 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_HOT_RELOAD_H
+#define LEARNOPENGL_SHADER_HOT_RELOAD_H
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "shader/compiler.h"
+
+class ShaderProgram;
+
+/**
+ * @brief Rebuilds programs whose stage files change on disk.
+ *
+ * A watcher thread listens for inotify events under the shader directory
+ * and only records which files changed. update(), called once per frame at
+ * a frame boundary, invalidates them in ShaderPreprocessor::shared() — which
+ * also yields every file that #includes them — and resubmits the programs
+ * whose stages are among those files to the
+ * ShaderCompiler and, once a rebuild links, move-assigns it over the
+ * watched ShaderProgram. Until then — and for good if the edit does not
+ * compile — the old program keeps rendering.
+ *
+ * File reads happen on the compiler's worker threads, so the render thread
+ * never blocks on I/O. The compiler is switched to retain its stages, so
+ * only the stage that changed is recompiled; the others are relinked as is.
+ *
+ * inotify is Linux-only; on other platforms watch() still records programs
+ * but no change is ever detected.
+ */
+class ShaderHotReloader
+{
+  public:
+    explicit ShaderHotReloader(ShaderCompiler& compiler, std::filesystem::path directory = "shaders");
+
+    /**
+     * @brief Stops the watcher thread. Rebuilds still in flight are dropped.
+     */
+    ~ShaderHotReloader();
+
+    ShaderHotReloader(const ShaderHotReloader&) = delete;
+    ShaderHotReloader& operator=(const ShaderHotReloader&) = delete;
+
+    /**
+     * @brief Registers a program to be rebuilt when one of its stage files changes.
+     *
+     * @p program must stay at the same address until unwatch() or the
+     * reloader is destroyed.
+     */
+    void watch(ShaderProgram& program, std::vector<ShaderStageDesc> stages);
+
+    void unwatch(const ShaderProgram& program);
+
+    /**
+     * @brief Starts rebuilds for changed files and swaps in finished ones.
+     *
+     * Call once per frame, after ShaderCompiler::update() and outside of any
+     * draw that uses a watched program.
+     *
+     * @return Number of programs swapped this call.
+     */
+    int update();
+
+  private:
+    struct Watched
+    {
+        ShaderProgram*                     program;
+        std::vector<ShaderStageDesc>       stages;
+        std::vector<std::filesystem::path> files; ///< Normalized stage paths.
+        ShaderCompiler::Handle             pending;
+        bool                               rebuilding;
+    };
+
+    ShaderCompiler&       m_compiler;
+    std::filesystem::path m_directory;
+    std::vector<Watched>  m_watched;
+
+    std::thread           m_thread;
+    std::atomic<bool>     m_stopping;
+    int                   m_inotify;
+
+    std::mutex                      m_mutex;
+    std::set<std::filesystem::path> m_changed; ///< Filled by the watcher thread.
+
+    void watcherLoop();
+    bool dependsOn(const Watched& watched, const std::set<std::filesystem::path>& changed) const;
+};
+
+#endif // LEARNOPENGL_SHADER_HOT_RELOAD_H
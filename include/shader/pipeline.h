@@ -0,0 +1,87 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_PIPELINE_H
+#define LEARNOPENGL_SHADER_PIPELINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <unordered_map>
+
+#include "glad/glad.h"
+
+class ShaderProgram;
+
+/**
+ * @brief Combines separable programs into program pipeline objects on demand.
+ *
+ * With monolithic programs every vertex / fragment pairing is a separate
+ * link, so V vertex and F fragment shaders cost V×F links. Linking each
+ * stage once as a separable program (ShaderProgram::setSeparable) and
+ * combining them here costs V+F links; a new pairing only creates a
+ * pipeline object, which is cheap, and switching the fragment program never
+ * touches the vertex one.
+ * @code
+ *   ShaderProgram vertex;   vertex.setSeparable(true);   vertex.attach(vs);   vertex.link();
+ *   ShaderProgram fragment; fragment.setSeparable(true); fragment.attach(fs); fragment.link();
+ *   pipelines.bind(pipelines.get({&vertex, &fragment}));
+ * @endcode
+ *
+ * Pipelines are keyed by the programs' link serials, so a program rebuilt
+ * by hot reload gets a fresh pipeline instead of a stale one. The old
+ * entries stay until clear().
+ *
+ * Requires GL 4.1; get() returns 0 on older contexts.
+ */
+class ProgramPipelineCache
+{
+  public:
+    struct Stats
+    {
+        std::uint32_t hits    = 0;
+        std::uint32_t created = 0;
+    };
+
+    ProgramPipelineCache() = default;
+
+    /**
+     * @brief Deletes every cached pipeline object.
+     */
+    ~ProgramPipelineCache();
+
+    ProgramPipelineCache(const ProgramPipelineCache&) = delete;
+    ProgramPipelineCache& operator=(const ProgramPipelineCache&) = delete;
+
+    /**
+     * @brief Returns the pipeline that uses each program for its own stages.
+     *
+     * Every program must be linked and separable, and no two may share a stage.
+     *
+     * @return The pipeline name, or 0 if separable programs are unsupported
+     *         or a program is not ready.
+     */
+    GLuint get(std::initializer_list<const ShaderProgram*> programs);
+
+    /**
+     * @brief Makes @p pipeline current. Unbinds any program set with glUseProgram,
+     *        which would otherwise take precedence over the pipeline.
+     */
+    static void bind(GLuint pipeline);
+
+    /**
+     * @brief Deletes every cached pipeline, e.g. after programs were reloaded.
+     */
+    void clear();
+
+    size_t size() const;
+
+    const Stats& getStats() const;
+
+  private:
+    std::unordered_map<std::uint64_t, GLuint> m_pipelines;
+    Stats                                     m_stats;
+};
+
+#endif // LEARNOPENGL_SHADER_PIPELINE_H
@@ -0,0 +1,119 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_PREPROCESSOR_H
+#define LEARNOPENGL_SHADER_PREPROCESSOR_H
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Expands #include directives and injects #defines into GLSL sources.
+ *
+ * `#include "file"` is resolved relative to the including file first, then
+ * relative to the include root. Included files are pasted verbatim, so
+ * shared headers should carry their own #ifndef guards.
+ *
+ * Every file's expansion is memoized. An entry is keyed by the hash of the
+ * file's bytes combined with the expansion hashes of its includes, so a file
+ * that is saved without real changes keeps its cached text. A reverse
+ * dependency graph (header -> includers) lets invalidate() mark exactly the
+ * files whose expansion can change after an edit.
+ *
+ * Files are read through Platform::MappedFile. All members are thread-safe;
+ * the lock is held only to look up and publish entries, never across file
+ * I/O, so invalidate() does not wait on a compile worker's reads.
+ */
+class ShaderPreprocessor
+{
+  public:
+    struct Stats
+    {
+        std::uint32_t expansions = 0; ///< Files whose expanded text was rebuilt.
+        std::uint32_t reuses     = 0; ///< Stale files whose expansion was unchanged.
+    };
+
+    explicit ShaderPreprocessor(std::filesystem::path includeRoot = "shaders");
+
+    ShaderPreprocessor(const ShaderPreprocessor&) = delete;
+    ShaderPreprocessor& operator=(const ShaderPreprocessor&) = delete;
+
+    /**
+     * @brief Process-wide instance used by ShaderStage::loadSource().
+     */
+    static ShaderPreprocessor& shared();
+
+    /**
+     * @brief Returns the fully expanded source of @p filepath with @p defines
+     *        injected right after the #version line.
+     *
+     * @throws std::runtime_error on a missing file or an include cycle.
+     */
+    std::string process(const std::filesystem::path& filepath, const std::vector<std::string>& defines = {});
+
+    /**
+     * @brief Marks @p file and every file including it, directly or not, as stale.
+     *
+     * Does no I/O; the files are re-read by the next process() that needs them.
+     *
+     * @return The normalized paths of all invalidated files, @p file included.
+     */
+    std::vector<std::filesystem::path> invalidate(const std::filesystem::path& file);
+
+    /**
+     * @brief Inserts "#define <entry>" lines after the #version directive.
+     */
+    static void injectDefines(std::string& source, const std::vector<std::string>& defines);
+
+    /**
+     * @brief Absolute, lexically normalized form used for every graph key.
+     */
+    static std::filesystem::path normalize(const std::filesystem::path& path);
+
+    Stats getStats() const;
+
+  private:
+    struct Entry
+    {
+        std::uint64_t                      contentHash  = 0;
+        std::uint64_t                      expandedHash = 0;
+        std::shared_ptr<const std::string> expanded; ///< Shared with expansions still reading it.
+        std::vector<std::filesystem::path> includes; ///< Direct includes, normalized.
+        std::uint64_t                      generation = 0; ///< Bumped by invalidate().
+        bool                               stale = true;
+    };
+
+    /**
+     * @brief A file's expanded text as read, and the generation it was read at.
+     */
+    struct Expansion
+    {
+        std::shared_ptr<const std::string> text;
+        std::uint64_t                      hash       = 0;
+        std::uint64_t                      generation = 0;
+    };
+
+    std::filesystem::path m_includeRoot;
+
+    // Keyed by normalize(path).string()
+    mutable std::mutex                                     m_mutex;
+    std::unordered_map<std::string, Entry>                 m_files;
+    std::unordered_map<std::string, std::set<std::string>> m_dependents;
+    Stats                                                  m_stats;
+
+    /**
+     * @brief Returns the cached expansion of @p file, re-reading it and its
+     *        stale includes first. Locks only around the cache lookups.
+     */
+    Expansion expand(const std::filesystem::path& file, std::vector<std::filesystem::path>& stack);
+    std::filesystem::path resolveInclude(const std::filesystem::path& includer, const std::string& name) const;
+};
+
+#endif // LEARNOPENGL_SHADER_PREPROCESSOR_H
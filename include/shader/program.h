@@ -5,12 +5,18 @@
 #ifndef LEARNOPENGL_SHADER_PROGRAM_H
 #define LEARNOPENGL_SHADER_PROGRAM_H
 
+#include <chrono>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "glad/glad.h"
+#include "shader/uniform.h"
 
+class ShaderBinaryCache;
 class ShaderStage;
 
 class ShaderProgram
@@ -25,20 +31,153 @@ class ShaderProgram
     ShaderProgram(ShaderProgram&& other) noexcept;
     ShaderProgram& operator=(ShaderProgram&& other) noexcept;
 
-    void attach(const ShaderStage& stage) const;
-    bool link() const;
+    /**
+     * @brief Records a stage for the next link().
+     *
+     * The stage is compiled and attached by link(), so it must stay alive
+     * until link() returns.
+     */
+    void attach(const ShaderStage& stage);
+
+    /**
+     * @brief Marks the program as separable (GL_PROGRAM_SEPARABLE) for the next link().
+     *
+     * A separable program usually holds a single stage and is combined with
+     * others by ProgramPipelineCache instead of being linked against them.
+     * Its uniforms are written with glProgramUniform*, so it never needs to
+     * be bound. Requires GL 4.1; ignored with a warning on older contexts.
+     */
+    void setSeparable(bool separable);
+
+    bool isSeparable() const;
+
+    /**
+     * @brief GL_*_SHADER_BIT mask of the stages attached for the last link().
+     */
+    GLbitfield getStageBits() const;
+
+    /**
+     * @brief Process-unique number of the last successful link, 0 before it.
+     *
+     * Unlike the GL name, it changes whenever the program is rebuilt, e.g. by
+     * hot reload, so it is safe to key caches on.
+     */
+    std::uint64_t getLinkSerial() const;
+
+    /**
+     * @brief Links the program and rebuilds the uniform table.
+     *
+     * Every link is reported to ShaderTelemetry::shared().
+     *
+     * With a cache, a binary stored by a previous run is restored first and
+     * the stages are not even compiled; on a miss the program is linked from
+     * source and its binary written back.
+     *
+     * On success every active uniform is listed with glGetActiveUniform and
+     * stored in a flat table sorted by name hash, so setUniform never has to
+     * call glGetUniformLocation.
+     */
+    bool link(ShaderBinaryCache* cache = nullptr);
+
+    /**
+     * @brief Non-blocking first half of link(): compiles the attached stages
+     *        and issues glLinkProgram without querying any status.
+     *
+     * The stages must stay alive until finishLink() returns.
+     */
+    void beginLink(ShaderBinaryCache* cache = nullptr);
+
+    /**
+     * @brief Returns true once finishLink() will not stall.
+     *
+     * Uses GL_COMPLETION_STATUS_KHR when parallel shader compile is
+     * available; otherwise always true and finishLink() may block.
+     */
+    bool isLinkComplete() const;
+
+    /**
+     * @brief Second half of link(): checks the status, fills the binary cache
+     *        and rebuilds the uniform table.
+     *
+     * @throws std::runtime_error if a stage failed to compile.
+     */
+    bool finishLink();
 
     void bind() const;
     void unbind() const;
 
     GLuint getId() const;
 
-    void setUniform(const std::string& name, int value);
-    void setUniform(const std::string& name, float value);
-    void setUniform(const std::string& name, const glm::mat4& mat4);
+    /**
+     * @brief Returns the reflected uniform, or nullptr if it is not active.
+     */
+    const UniformInfo* findUniform(UniformHandle handle) const;
+
+    const std::vector<UniformInfo>& getUniforms() const;
+
+    const std::vector<UniformBlockInfo>& getUniformBlocks() const;
+
+    /**
+     * @brief Assigns a binding point to every uniform block named @p blockName.
+     *
+     * Applies to programs linked afterwards: link() looks each active block
+     * up here and calls glUniformBlockBinding, so shaders need no
+     * layout(binding = N) and C++ code never queries block indices.
+     * Register before building programs, typically once at startup.
+     */
+    static void registerBlockBinding(const std::string& blockName, GLuint bindingPoint);
+
+    // The program must be bound unless it is separable. Names the linker optimized away are
+    // ignored, the same way glUniform* ignores location -1. A value equal
+    // to the one the program already holds is not sent again.
+    void setUniform(UniformHandle handle, int value);
+    void setUniform(UniformHandle handle, float value);
+    void setUniform(UniformHandle handle, const glm::mat4& mat4);
+
+    void setUniform(std::string_view name, int value);
+    void setUniform(std::string_view name, float value);
+    void setUniform(std::string_view name, const glm::mat4& mat4);
+
+    /**
+     * @brief Uniform writes issued and skipped by all programs since the last reset.
+     */
+    static const UniformStats& getFrameUniformStats();
+
+    /**
+     * @brief Zeroes the counters. Call once at the start of each frame.
+     */
+    static void resetFrameUniformStats();
 
   private:
-    GLuint m_id;
+    GLuint                          m_id;
+    std::vector<const ShaderStage*> m_stages;   ///< Attached since the last link().
+    std::vector<const ShaderStage*> m_linking;  ///< Between beginLink() and finishLink().
+    std::vector<UniformInfo>        m_uniforms; ///< Sorted by UniformInfo::hash.
+    std::vector<UniformBlockInfo>   m_blocks;
+
+    ShaderBinaryCache* m_cache;
+    std::uint64_t      m_cacheKey;
+    bool               m_restored; ///< Last link came from the binary cache.
+    bool               m_separable;
+    GLbitfield         m_stageBits;
+    std::uint64_t      m_linkSerial;
+
+    // Telemetry of the link in progress
+    std::chrono::steady_clock::time_point m_linkStart;
+    double                                m_linkBlockingMs;
+    std::vector<double>                   m_submitMs; ///< Per m_linking stage, negative if compiled earlier.
+
+    void reflectUniforms();
+    void bindUniformBlocks();
+    UniformInfo* lookup(UniformHandle handle);
+    void recordTelemetry(const std::vector<const ShaderStage*>& stages, bool linked) const;
+
+    /**
+     * @brief Compares @p value against the shadow copy and updates it.
+     *
+     * @return True if the value differs and must be sent to the driver.
+     */
+    static bool updateShadow(UniformInfo& info, const void* value, std::uint8_t words);
 };
 
-#endif // LEARNOPENGL_SHADER_PROGRAM_H
\ No newline at end of file
+#endif // LEARNOPENGL_SHADER_PROGRAM_H
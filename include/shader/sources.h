@@ -0,0 +1,71 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_SOURCES_H
+#define LEARNOPENGL_SHADER_SOURCES_H
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Resolves shader paths to their source text.
+ *
+ * The build runs tools/shader_embed over shaders/, which expands every
+ * #include, shrinks each stage with GlslOptimizer and compiles the results
+ * into the executable, indexed by path
+ * ("shaders/basic.vert"). Shipped builds load stages from that table with
+ * no file I/O and need no shaders/ directory next to the binary.
+ *
+ * For development an override root can be set; a path that exists under it
+ * is read from disk through ShaderPreprocessor::shared() instead, so edits
+ * show up without rebuilding and hot reload keeps working. Paths that are
+ * neither overridden nor embedded are read from disk as given.
+ */
+class ShaderSources
+{
+  public:
+    /**
+     * @brief Sets the directory that stage paths are resolved against before
+     *        the embedded table. Empty disables overrides.
+     *
+     * Call once at startup, before any stage is loaded.
+     */
+    static void setOverrideRoot(std::filesystem::path root);
+
+    static const std::filesystem::path& getOverrideRoot();
+
+    /**
+     * @brief Returns the expanded source of @p filepath with @p defines injected.
+     *
+     * Thread-safe once the override root is set.
+     *
+     * @throws std::runtime_error if the path is neither overridden, embedded
+     *         nor readable from disk.
+     */
+    static std::string load(const std::string& filepath, const std::vector<std::string>& defines);
+
+    /**
+     * @brief Looks @p filepath up in the embedded table.
+     */
+    static std::optional<std::string_view> findEmbedded(const std::string& filepath);
+
+    /**
+     * @brief The file on disk that load() reads for @p filepath when it is
+     *        overridden. Used by the hot reloader to match change events.
+     */
+    static std::filesystem::path diskPath(const std::filesystem::path& filepath);
+
+    /**
+     * @brief Size of the stage file itself, before #include expansion, or 0
+     *        if it cannot be found. Stats the file only when it is not embedded.
+     */
+    static size_t sourceBytes(const std::string& filepath);
+
+    static size_t embeddedCount();
+};
+
+#endif // LEARNOPENGL_SHADER_SOURCES_H
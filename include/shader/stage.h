@@ -6,13 +6,40 @@
 #define LEARNOPENGL_SHADER_STAGE_H
 
 #include <string>
+#include <vector>
 
 #include "glad/glad.h"
 
+/**
+ * @brief One shader stage loaded from a file.
+ *
+ * The source is read (and the defines injected) on construction, but the GL
+ * shader object is only created by compile(). ShaderProgram::link compiles
+ * its stages on demand, so a program restored from the binary cache never
+ * compiles them at all.
+ *
+ * compile() does not wait for the driver: the status is only queried by
+ * checkCompileStatus(), which ShaderProgram calls after a failed link.
+ */
 class ShaderStage
 {
   public:
-    ShaderStage(std::string filepath, GLenum type);
+    /**
+     * @param filepath Path of the GLSL source file.
+     * @param type     GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, ...
+     * @param defines  Injected as "#define <entry>" right after the #version line.
+     *                 An entry may carry a value, e.g. "MAX_LIGHTS 4".
+     *
+     * @throws std::runtime_error if the source cannot be loaded, see loadSource().
+     */
+    ShaderStage(std::string filepath, GLenum type, std::vector<std::string> defines = {});
+
+    /**
+     * @brief Constructs from a source already produced by loadSource(),
+     *        typically on a loader thread. Does no file I/O.
+     */
+    ShaderStage(std::string filepath, GLenum type, std::vector<std::string> defines, std::string source);
+
     ~ShaderStage();
 
     ShaderStage(const ShaderStage&) = delete;
@@ -21,16 +48,48 @@ class ShaderStage
     ShaderStage(ShaderStage&&) noexcept;
     ShaderStage& operator=(ShaderStage&&) noexcept;
 
+    /**
+     * @brief Returns the stage source from ShaderSources, #includes expanded
+     *        and the defines injected.
+     *
+     * Touches no GL state, so it is safe to call from any thread.
+     *
+     * @throws std::runtime_error if a file cannot be opened or includes cycle.
+     */
+    static std::string loadSource(const std::string& filepath, const std::vector<std::string>& defines);
+
+    /**
+     * @brief Submits the stage to the driver if it has not been compiled yet.
+     *
+     * Const because the GL object is a lazily built view of the source.
+     *
+     * @return True if this call submitted it, false if it was compiled already.
+     */
+    bool compile() const;
+
+    /**
+     * @brief Queries GL_COMPILE_STATUS. Blocks until the driver has finished.
+     *
+     * @throws std::runtime_error with the driver info log on failure.
+     */
+    void checkCompileStatus() const;
+
+    /**
+     * @brief Returns the GL shader object, or 0 before compile().
+     */
     GLuint getID() const;
     GLenum getType() const;
 
+    const std::string& getFilepath() const;
+    const std::string& getSource() const;
+    const std::vector<std::string>& getDefines() const;
+
   private:
-    GLuint m_id;
+    mutable GLuint m_id;
     GLenum m_type;
     std::string m_filepath;
-
-    std::string loadShaderSource() const;
-    void compile(const std::string& source);
+    std::vector<std::string> m_defines;
+    std::string m_source;
 };
 
-#endif // LEARNOPENGL_SHADER_STAGE_H
\ No newline at end of file
+#endif // LEARNOPENGL_SHADER_STAGE_H
@@ -0,0 +1,155 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_STD140_H
+#define LEARNOPENGL_SHADER_STD140_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+/**
+ * @brief Compile-time checks that a C++ struct matches the GLSL std140 layout.
+ *
+ * std140 aligns vec3 / vec4 / matrix columns / array elements to 16 bytes,
+ * while glm packs them to 4; a struct that mirrors a uniform block has to
+ * pad for that. List the members once and the compiler verifies every
+ * offset and the overall size:
+ * @code
+ *   struct PerDraw
+ *   {
+ *       glm::mat4 model;
+ *       glm::vec3 tint;
+ *       float     roughness;   // fills the vec3 padding
+ *   };
+ *   STD140_ASSERT(PerDraw, STD140_FIELD(PerDraw, model), STD140_FIELD(PerDraw, tint),
+ *                 STD140_FIELD(PerDraw, roughness));
+ * @endcode
+ * Members may be 32-bit scalars, glm vectors and matrices, and arrays of
+ * those. Nested structs are not supported: a member of any other type fails
+ * to compile, so flatten the struct into the block instead.
+ */
+namespace Std140
+{
+    /**
+     * @brief std140 base alignment and size of a member type.
+     */
+    template <typename T>
+    struct Traits
+    {
+        static_assert(sizeof(T) == 0, "std140 members must be 32-bit scalars, glm vectors/matrices or arrays of them");
+    };
+
+    template <typename T, std::size_t Align, std::size_t Size>
+    struct ScalarTraits
+    {
+        static constexpr std::size_t align = Align;
+        static constexpr std::size_t size  = Size;
+    };
+
+    // GLSL bool is 4 bytes in a block; mirror it with std::int32_t, never bool
+    template <>
+    struct Traits<float> : ScalarTraits<float, 4, 4>
+    {
+    };
+    template <>
+    struct Traits<std::int32_t> : ScalarTraits<std::int32_t, 4, 4>
+    {
+    };
+    template <>
+    struct Traits<std::uint32_t> : ScalarTraits<std::uint32_t, 4, 4>
+    {
+    };
+
+    template <glm::length_t L, typename T, glm::qualifier Q>
+    struct Traits<glm::vec<L, T, Q>>
+    {
+        static_assert(sizeof(T) == 4, "std140 vectors must have 32-bit components");
+        static constexpr std::size_t align = L == 2 ? 8 : 16;
+        static constexpr std::size_t size  = L * 4;
+    };
+
+    // A CxR matrix is laid out as an array of C column vectors, each padded to vec4
+    template <glm::length_t C, glm::length_t R, typename T, glm::qualifier Q>
+    struct Traits<glm::mat<C, R, T, Q>>
+    {
+        static_assert(sizeof(T) == 4, "std140 matrices must have 32-bit components");
+        static_assert(R == 4, "glm packs vec2/vec3 matrix columns tightly; mirror them with a mat?x4");
+        static constexpr std::size_t align = 16;
+        static constexpr std::size_t size  = C * 16;
+    };
+
+    // Array elements are rounded up to a vec4 stride, which the C++ element has to match
+    template <typename T, std::size_t N>
+    struct Traits<T[N]>
+    {
+        static constexpr std::size_t stride = (Traits<T>::size + 15) / 16 * 16;
+        static constexpr std::size_t align  = 16;
+        static constexpr std::size_t size   = stride * N;
+
+        static_assert(sizeof(T) == stride, "std140 arrays have a 16-byte element stride; use vec4 elements, not float");
+    };
+
+    constexpr std::size_t alignUp(const std::size_t value, const std::size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief One member: its std140 requirements and where the C++ compiler put it.
+     */
+    struct Field
+    {
+        std::size_t align;
+        std::size_t size;
+        std::size_t cppOffset;
+    };
+
+    template <typename T>
+    constexpr Field field(const std::size_t cppOffset)
+    {
+        return {Traits<T>::align, Traits<T>::size, cppOffset};
+    }
+
+    /**
+     * @brief std140 size of a block with the given members, in declaration order.
+     */
+    template <std::size_t N>
+    constexpr std::size_t blockSize(const Field (&fields)[N])
+    {
+        std::size_t offset = 0;
+        for (const Field& f : fields)
+        {
+            offset = alignUp(offset, f.align) + f.size;
+        }
+        return alignUp(offset, 16);
+    }
+
+    /**
+     * @brief True if every member sits at its std140 offset and the struct
+     *        size equals the std140 block size (a multiple of 16).
+     */
+    template <typename Struct, std::size_t N>
+    constexpr bool validate(const Field (&fields)[N])
+    {
+        std::size_t offset = 0;
+        for (const Field& f : fields)
+        {
+            offset = alignUp(offset, f.align);
+            if (offset != f.cppOffset)
+            {
+                return false;
+            }
+            offset += f.size;
+        }
+        return sizeof(Struct) == alignUp(offset, 16);
+    }
+} // namespace Std140
+
+#define STD140_FIELD(Struct, member) ::Std140::field<decltype(Struct::member)>(offsetof(Struct, member))
+
+#define STD140_ASSERT(Struct, ...)                                                                                     \
+    static_assert(::Std140::validate<Struct>({__VA_ARGS__}), #Struct " does not match the std140 layout")
+
+#endif // LEARNOPENGL_SHADER_STD140_H
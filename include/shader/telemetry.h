@@ -0,0 +1,97 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_TELEMETRY_H
+#define LEARNOPENGL_SHADER_TELEMETRY_H
+
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "glad/glad.h"
+
+/**
+ * @brief Collects compile and link timings to find the shaders that dominate startup.
+ *
+ * ShaderProgram reports every link here. A stage is reported when a link
+ * compiled it, so stages restored from the binary cache or reused by hot
+ * reload do not appear twice. Times are wall-clock milliseconds spent on
+ * the calling thread:
+ *  - a stage's submitMs covers glShaderSource + glCompileShader only. The
+ *    compile itself is deferred until the link status is read, so this is
+ *    not the cost of the stage and is exported but never ranked;
+ *  - a program's blockingMs covers beginLink() + finishLink(), including
+ *    the compiles it issued and the stall on GL_LINK_STATUS, and latencyMs
+ *    the time from beginLink() to the end of finishLink().
+ *
+ * Info log sizes are queried only after the link status, so recording never
+ * adds a driver stall. ShaderWarmup adds the time of each program's first
+ * draw. All members are thread-safe.
+ */
+class ShaderTelemetry
+{
+  public:
+    struct StageRecord
+    {
+        std::string filepath;
+        GLenum      type = GL_NONE;
+        std::string defines;                ///< Joined with ';', empty without defines.
+        std::size_t sourceBytes       = 0; ///< The stage file itself, before #include expansion.
+        std::size_t preprocessedBytes = 0; ///< What the driver compiled.
+        double      submitMs          = 0.0; ///< glShaderSource + glCompileShader, not the compile.
+        std::size_t infoLogBytes      = 0;
+    };
+
+    struct ProgramRecord
+    {
+        std::string name; ///< Stage paths joined with " + ".
+        double      blockingMs   = 0.0;
+        double      latencyMs    = 0.0;
+        bool        cacheHit     = false;
+        bool        linked       = false;
+        std::size_t infoLogBytes = 0;
+    };
+
+    struct WarmupRecord
+    {
+        std::string name;
+        double      drawMs = 0.0; ///< First draw, glFinish included.
+    };
+
+    static ShaderTelemetry& shared();
+
+    void recordStage(StageRecord record);
+    void recordProgram(ProgramRecord record);
+    void recordWarmup(WarmupRecord record);
+
+    std::vector<StageRecord>   getStages() const;
+    std::vector<ProgramRecord> getPrograms() const;
+    std::vector<WarmupRecord>  getWarmups() const;
+
+    /**
+     * @brief Writes every record, in recording order, as a JSON document.
+     *
+     * @return False if the file could not be written.
+     */
+    bool writeJson(const std::filesystem::path& path) const;
+
+    /**
+     * @brief Prints the @p count most expensive program builds (blockingMs)
+     *        and warmup draws, slowest first.
+     */
+    void printSlowest(std::ostream& out, std::size_t count = 10) const;
+
+    void clear();
+
+  private:
+    mutable std::mutex         m_mutex;
+    std::vector<StageRecord>   m_stages;
+    std::vector<ProgramRecord> m_programs;
+    std::vector<WarmupRecord>  m_warmups;
+};
+
+#endif // LEARNOPENGL_SHADER_TELEMETRY_H
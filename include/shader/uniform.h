@@ -0,0 +1,79 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_UNIFORM_H
+#define LEARNOPENGL_SHADER_UNIFORM_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "core/Hash.h"
+#include "glad/glad.h"
+
+/**
+ * @brief Precomputed key for a uniform lookup.
+ *
+ * Built from the uniform name with a constexpr hash, so a handle declared
+ * at namespace scope costs nothing per frame:
+ * @code
+ *   constexpr UniformHandle kModel {"uModel"};
+ *   program.setUniform(kModel, model);
+ * @endcode
+ */
+struct UniformHandle
+{
+    std::uint64_t hash;
+
+    constexpr explicit UniformHandle(std::string_view name)
+        : hash(Core::fnv1a(name))
+    {}
+
+    constexpr bool operator==(const UniformHandle&) const = default;
+};
+
+/**
+ * @brief One active uniform as reported by glGetActiveUniform at link time.
+ *
+ * Array uniforms are stored under their base name ("lights" rather than
+ * "lights[0]"); size holds the element count.
+ *
+ * shadow mirrors the value of element 0 currently held by the program, as
+ * raw 32-bit words, so ShaderProgram::setUniform can skip redundant
+ * glUniform* calls. It is seeded from glGetUniform* at link time.
+ */
+struct UniformInfo
+{
+    std::uint64_t hash;     ///< Core::fnv1a of name, the sort key of the table.
+    GLint         location; ///< Location of element 0.
+    GLenum        type;     ///< GL type enum (GL_FLOAT_MAT4, GL_SAMPLER_2D, ...).
+    GLint         size;     ///< Array element count, 1 for non-arrays.
+    std::string   name;     ///< Base name, kept for diagnostics.
+
+    std::array<std::uint32_t, 16> shadow {};     ///< First shadowWords entries are valid.
+    std::uint8_t                  shadowWords {}; ///< 0 if the type is not shadowed.
+};
+
+/**
+ * @brief One active uniform block as reported by glGetActiveUniformBlockName.
+ */
+struct UniformBlockInfo
+{
+    std::string name;
+    GLuint      index;    ///< Block index within the program.
+    GLint       dataSize; ///< GL_UNIFORM_BLOCK_DATA_SIZE; compare against sizeof of the C++ mirror.
+    GLint       binding;  ///< Binding point assigned at link time, -1 if none registered.
+};
+
+/**
+ * @brief Uniform writes issued to the driver versus skipped as redundant.
+ */
+struct UniformStats
+{
+    std::uint32_t issued  = 0;
+    std::uint32_t skipped = 0;
+};
+
+#endif // LEARNOPENGL_SHADER_UNIFORM_H
@@ -0,0 +1,122 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_VARIANT_H
+#define LEARNOPENGL_SHADER_VARIANT_H
+
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "shader/compiler.h"
+
+class ShaderBinaryCache;
+class ShaderProgram;
+
+/**
+ * @brief Feature-keyed permutations of one shader.
+ *
+ * Each feature name is a define; bit i of a variant key enables features[i].
+ * A variant is compiled the first time get() asks for it and cached by key,
+ * so only combinations that are actually drawn are ever built.
+ *
+ * Every key passed to get() is recorded. saveWarmupList() writes those keys
+ * by feature name; on the next launch warmup() builds exactly that set while
+ * the loading screen is up instead of hitching on first use mid-frame.
+ *
+ * @code
+ *   ShaderVariantManager lit {"lit", {{"shaders/lit.vert", GL_VERTEX_SHADER},
+ *                                     {"shaders/lit.frag", GL_FRAGMENT_SHADER}},
+ *                             {"SKINNING", "SHADOWS", "FOG"}, &cache};
+ *   ShaderProgram& program = lit.get(lit.keyOf({"SHADOWS", "FOG"}));
+ * @endcode
+ */
+class ShaderVariantManager
+{
+  public:
+    using Key = std::uint64_t;
+
+    /**
+     * @param name     Identifies this shader in warmup lists; must not contain spaces.
+     * @param stages   Stage files shared by every variant.
+     * @param features Define names, at most 64.
+     * @param cache    Optional binary cache used when building variants.
+     */
+    ShaderVariantManager(std::string name, std::vector<ShaderStageDesc> stages, std::vector<std::string> features,
+                         ShaderBinaryCache* cache = nullptr);
+
+    ~ShaderVariantManager();
+
+    ShaderVariantManager(const ShaderVariantManager&) = delete;
+    ShaderVariantManager& operator=(const ShaderVariantManager&) = delete;
+
+    /**
+     * @brief Builds a key from feature names. Unknown names are ignored.
+     */
+    Key keyOf(std::initializer_list<std::string_view> features) const;
+
+    /**
+     * @brief Returns the variant for @p key, building it on first use.
+     *
+     * The returned reference stays valid for the lifetime of the manager.
+     *
+     * @throws std::runtime_error if the variant fails to compile or link.
+     */
+    ShaderProgram& get(Key key);
+
+    /**
+     * @brief Builds every key not built yet. Used to warm up at load time.
+     */
+    void precompile(const std::vector<Key>& keys);
+
+    /**
+     * @brief Returns the stages of the variant, defines filled in.
+     *
+     * Pass to ShaderHotReloader::watch together with get(key).
+     */
+    std::vector<ShaderStageDesc> stagesFor(Key key) const;
+
+    const std::string& getName() const;
+
+    /**
+     * @brief Keys requested through get() since construction.
+     */
+    const std::set<Key>& getUsedKeys() const;
+
+    size_t getBuiltCount() const;
+
+    /**
+     * @brief Writes the used variants of @p managers, one "<name> <feature>..." line each.
+     */
+    static bool saveWarmupList(const std::filesystem::path& path,
+                               const std::vector<const ShaderVariantManager*>& managers);
+
+    /**
+     * @brief Precompiles every variant of @p managers listed in @p path.
+     *
+     * A missing file is not an error: the first launch simply has nothing to warm up.
+     *
+     * @return Number of variants built.
+     */
+    static size_t warmup(const std::filesystem::path& path, const std::vector<ShaderVariantManager*>& managers);
+
+  private:
+    std::string                  m_name;
+    std::vector<ShaderStageDesc> m_stages;
+    std::vector<std::string>     m_features;
+    ShaderBinaryCache*           m_cache;
+
+    std::unordered_map<Key, std::unique_ptr<ShaderProgram>> m_variants;
+    std::set<Key>                                           m_used;
+
+    ShaderProgram& build(Key key);
+};
+
+#endif // LEARNOPENGL_SHADER_VARIANT_H
@@ -0,0 +1,85 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_SHADER_WARMUP_H
+#define LEARNOPENGL_SHADER_WARMUP_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "glad/glad.h"
+
+class ShaderProgram;
+
+/**
+ * @brief Draws each program once off-screen so its first real draw does not hitch.
+ *
+ * Many drivers return from glLinkProgram before generating machine code and
+ * finish the job on the first draw that uses the program, which shows up as
+ * a frame spike the first time an object appears. run() issues that first
+ * draw ahead of time: one triangle per program into a 4x4 framebuffer with
+ * color and depth attachments, followed by glFinish so the cost lands here.
+ *
+ * The vertex layout comes from the program's active attributes: each one is
+ * fed from a small zeroed buffer with its own type and component count, so
+ * the driver compiles the fetch path a real mesh with that layout would use.
+ * VAOs are shared between programs with the same attribute signature.
+ *
+ * Each draw is timed and reported to ShaderTelemetry::shared(). The previous
+ * framebuffer, viewport, program and VAO bindings are restored afterwards.
+ */
+class ShaderWarmup
+{
+  public:
+    struct Result
+    {
+        std::string name;
+        double      drawMs;
+    };
+
+    /**
+     * @brief Creates the framebuffer and the attribute source buffer.
+     *        Needs a current context.
+     */
+    ShaderWarmup();
+
+    ~ShaderWarmup();
+
+    ShaderWarmup(const ShaderWarmup&) = delete;
+    ShaderWarmup& operator=(const ShaderWarmup&) = delete;
+
+    /**
+     * @brief Queues a linked program for the next run().
+     *
+     * Separable programs hold a single stage and cannot draw on their own;
+     * they are skipped.
+     */
+    void add(const ShaderProgram& program, std::string name);
+
+    /**
+     * @brief Draws every queued program once and clears the queue.
+     */
+    std::vector<Result> run();
+
+  private:
+    struct Pending
+    {
+        const ShaderProgram* program;
+        std::string          name;
+    };
+
+    GLuint m_framebuffer;
+    GLuint m_color;
+    GLuint m_depth;
+    GLuint m_zeroBuffer;
+
+    std::vector<Pending>                      m_pending;
+    std::unordered_map<std::uint64_t, GLuint> m_vertexArrays; ///< Keyed by attribute signature.
+
+    GLuint vertexArrayFor(GLuint program);
+};
+
+#endif // LEARNOPENGL_SHADER_WARMUP_H
@@ -0,0 +1,124 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_UNIFORM_RING_H
+#define LEARNOPENGL_UNIFORM_RING_H
+
+#include <array>
+#include <cstring>
+#include <glad/glad.h>
+
+/**
+ * @brief Per-frame ring of uniform block data in one large UBO.
+ *
+ * The buffer is split into `frames` regions. Each frame packs every
+ * per-draw block into the next region and binds ranges of it with
+ * glBindBufferRange, replacing one glUniform* call per value per draw with
+ * a single buffer update per frame.
+ *
+ * Frame protocol:
+ * @code
+ *   ring.beginFrame();                        // waits for the GPU to release the region, maps it
+ *   auto a = ring.push(perDraw[i]);           // for every draw
+ *   ring.flush();                             // unmaps; data is visible to the GPU
+ *   ring.bind(0, a);  draw(i);                // for every draw
+ *   ring.endFrame();                          // fences the region
+ * @endcode
+ *
+ * Regions are guarded with fences, so the mapping uses
+ * GL_MAP_UNSYNCHRONIZED_BIT and never waits on unrelated GPU work.
+ */
+class UniformRing
+{
+  public:
+    static constexpr unsigned kMaxFrames = 4;
+
+    /**
+     * @brief A block written into the current frame's region.
+     */
+    struct Allocation
+    {
+        GLintptr   offset = 0; ///< Absolute offset in the UBO.
+        GLsizeiptr size   = 0;
+    };
+
+    /**
+     * @brief Allocates the UBO.
+     *
+     * @param bytesPerFrame Capacity of one frame region.
+     * @param frames        Frames in flight, at most kMaxFrames.
+     */
+    explicit UniformRing(size_t bytesPerFrame, unsigned frames = 3);
+
+    /**
+     * @brief Deletes the UBO and any outstanding fences.
+     */
+    ~UniformRing();
+
+    UniformRing(const UniformRing&) = delete;
+    UniformRing& operator=(const UniformRing&) = delete;
+
+    /**
+     * @brief Waits until the GPU has finished with the next region, then maps it.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Reserves @p size bytes, aligned to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+     *
+     * @return The allocation and a write pointer into the mapped region.
+     * @throws std::runtime_error if the frame region is exhausted.
+     */
+    Allocation allocate(size_t size, void** data);
+
+    /**
+     * @brief Copies one block into the frame. T should be checked with STD140_ASSERT.
+     */
+    template <typename T>
+    Allocation push(const T& block)
+    {
+        void*            data       = nullptr;
+        const Allocation allocation = allocate(sizeof(T), &data);
+        std::memcpy(data, &block, sizeof(T));
+        return allocation;
+    }
+
+    /**
+     * @brief Unmaps the region. Call after the last push() and before the first draw.
+     */
+    void flush();
+
+    /**
+     * @brief Binds an allocation to a uniform block binding point.
+     */
+    void bind(GLuint bindingPoint, const Allocation& allocation) const;
+
+    /**
+     * @brief Fences the region. Call after the frame's last draw.
+     */
+    void endFrame();
+
+    /**
+     * @brief Bytes pushed so far in the current frame, padding included.
+     */
+    size_t getUsedBytes() const;
+
+    GLuint getID() const
+    {
+        return m_id;
+    }
+
+  private:
+    GLuint   m_id;
+    size_t   m_regionSize;
+    unsigned m_frames;
+    unsigned m_frame;
+    size_t   m_alignment;
+    size_t   m_cursor;
+    char*    m_mapped;
+
+    std::array<GLsync, kMaxFrames> m_fences;
+};
+
+#endif // LEARNOPENGL_UNIFORM_RING_H
@@ -0,0 +1,161 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_UPLOAD_QUEUE_H
+#define LEARNOPENGL_UPLOAD_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <glad/glad.h>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "core/Config.h"
+#include "vertex_buffer.h"
+
+/**
+ * @brief Spreads buffer and texture uploads over frames through a staging ring.
+ *
+ * Any thread may enqueue data; the queue copies it, so the caller's memory
+ * can be released right away. Once per frame the render thread calls
+ * update(), which copies at most bytesPerFrame of queued data into the
+ * current region of a streaming staging buffer and issues the GPU-side
+ * copies from there. A large upload is split across as many frames as the
+ * budget requires, so no single frame pays for it.
+ *
+ * Each enqueue returns a ticket. The copies of a frame are followed by a
+ * fence, and a ticket reads as complete once the fence after its last byte
+ * has signalled, i.e. once the destination holds the new data:
+ * @code
+ *   const UploadQueue::Ticket t = uploads.enqueue(buffer.getID(), 0, data, size); // any thread
+ *   uploads.update();                                                            // render thread, every frame
+ *   if (uploads.isComplete(t)) { ... }
+ * @endcode
+ * Tickets complete in the order they were issued.
+ */
+class UploadQueue
+{
+  public:
+    using Ticket = std::uint64_t;
+
+    /**
+     * @brief Applies a staged upload to its destination on the render thread.
+     *
+     * Called with the staging buffer bound to GL_PIXEL_UNPACK_BUFFER and
+     * GL_COPY_READ_BUFFER; @p offset is the upload's byte offset in it, to be
+     * passed as the pointer argument of glTexSubImage* and friends.
+     */
+    using Apply = std::function<void(GLintptr offset)>;
+
+    struct Stats
+    {
+        std::uint64_t enqueued      = 0;
+        std::uint64_t completed     = 0;
+        std::uint64_t bytesUploaded = 0;
+        std::uint32_t budgetFrames  = 0; ///< update() calls that spent the whole budget with work left.
+    };
+
+    explicit UploadQueue(const Core::UploadQueueConfig& config = {});
+
+    /**
+     * @brief Deletes the outstanding fences. Queued uploads are dropped.
+     */
+    ~UploadQueue();
+
+    UploadQueue(const UploadQueue&) = delete;
+    UploadQueue& operator=(const UploadQueue&) = delete;
+
+    /**
+     * @brief Queues a copy of @p size bytes into @p buffer at @p offset. Thread-safe.
+     */
+    Ticket enqueue(GLuint buffer, GLintptr offset, const void* data, size_t size);
+
+    /**
+     * @brief Queues an upload whose destination is written by @p apply,
+     *        e.g. a texture level. Thread-safe.
+     *
+     * It is staged in one piece, so @p size must not exceed the per-frame budget.
+     *
+     * @throws std::logic_error if @p size exceeds the per-frame budget.
+     */
+    Ticket enqueue(Apply apply, const void* data, size_t size);
+
+    /**
+     * @brief Render thread, once per frame: retires finished uploads and
+     *        stages the next budget's worth.
+     */
+    void update();
+
+    /**
+     * @brief Render thread: uploads everything queued and waits for the GPU
+     *        to finish, ignoring the budget. For loading screens and shutdown.
+     */
+    void drain();
+
+    /**
+     * @brief True once the destination of @p ticket holds the uploaded data. Thread-safe.
+     */
+    bool isComplete(const Ticket ticket) const
+    {
+        return ticket <= m_completed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Bytes queued but not yet staged. Thread-safe.
+     */
+    size_t getPendingBytes() const;
+
+    Stats getStats() const;
+
+  private:
+    struct Request
+    {
+        Ticket                 ticket   = 0;
+        std::vector<std::byte> data;
+        size_t                 consumed = 0; ///< Bytes already staged.
+        GLuint                 buffer   = 0;
+        GLintptr               offset   = 0;
+        Apply                  apply;
+    };
+
+    struct InFlight
+    {
+        GLsync fence  = nullptr;
+        Ticket ticket = 0; ///< Last ticket fully staged before the fence.
+    };
+
+    size_t       m_budget;
+    VertexBuffer m_staging; ///< Streaming buffer, one budget-sized region per frame in flight.
+
+    mutable std::mutex  m_mutex;
+    std::deque<Request> m_requests;
+    Ticket              m_nextTicket;
+    size_t              m_pendingBytes;
+    Stats               m_stats;
+
+    std::deque<InFlight> m_inFlight;
+    std::atomic<Ticket>  m_completed;
+    Ticket               m_staged; ///< Last ticket whose final byte was staged.
+
+    Ticket push(Request request);
+
+    /**
+     * @brief Pops signalled fences and advances m_completed. With @p wait,
+     *        blocks until every fence has signalled.
+     */
+    void retire(bool wait);
+
+    /**
+     * @brief Stages one region's worth of requests and issues their copies.
+     *
+     * @return True if requests are left that did not fit.
+     */
+    bool stage();
+};
+
+#endif // LEARNOPENGL_UPLOAD_QUEUE_H
@@ -0,0 +1,136 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_VERTEX_ARRAY_CACHE_H
+#define LEARNOPENGL_VERTEX_ARRAY_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glad/glad.h>
+#include <unordered_map>
+
+#include "vertex_layout.h"
+
+/**
+ * @brief Shares vertex array objects between meshes with the same layout.
+ *
+ * With Platform::glExtensions().directStateAccess there is one VAO per
+ * layout hash. Its attribute formats are set once through
+ * glVertexArrayAttribFormat, all attributes read vertex binding 0, and
+ * bind() only swaps the buffers attached to that binding and the element
+ * buffer, skipping the calls when they are already attached. Nothing has to
+ * be bound to edit the VAO.
+ *
+ * On older contexts the attribute state cannot be separated from the
+ * buffers, so there is one VAO per (layout, vertex buffer, index buffer)
+ * key, built once with glVertexAttribPointer.
+ * @code
+ *   vertexArrays.bind(vertexLayoutOf<MeshVertex>(), vbo.getID(), ibo.getID());
+ *   glDrawElements(...);
+ * @endcode
+ *
+ * A cache must not outlive its context. Call forget() before deleting a
+ * buffer it has seen, or a recycled buffer name could reach a stale VAO.
+ */
+class VertexArrayCache
+{
+  public:
+    struct Stats
+    {
+        std::uint32_t hits          = 0;
+        std::uint32_t created       = 0;
+        std::uint32_t bufferBinds   = 0; ///< Buffer attachments issued, DSA path only.
+        std::uint32_t bufferSkipped = 0; ///< Attachments skipped because they were already current.
+    };
+
+    VertexArrayCache();
+
+    /**
+     * @brief Deletes every cached VAO.
+     */
+    ~VertexArrayCache();
+
+    VertexArrayCache(const VertexArrayCache&) = delete;
+    VertexArrayCache& operator=(const VertexArrayCache&) = delete;
+
+    /**
+     * @brief Returns a VAO reading @p layout from @p vertexBuffer, with
+     *        @p indexBuffer as its element buffer, without binding it.
+     *
+     * Creating a VAO on the fallback path leaves VAO 0 bound.
+     *
+     * @param vertexOffset Byte offset of vertex 0 in @p vertexBuffer.
+     */
+    GLuint get(const VertexLayout& layout, GLuint vertexBuffer, GLuint indexBuffer = 0, GLintptr vertexOffset = 0);
+
+    /**
+     * @brief get() followed by glBindVertexArray.
+     */
+    GLuint bind(const VertexLayout& layout, GLuint vertexBuffer, GLuint indexBuffer = 0, GLintptr vertexOffset = 0);
+
+    /**
+     * @brief Binds a VAO that reads @p layout per vertex and @p instanceLayout
+     *        per instance (divisor 1) from @p instanceBuffer at @p instanceOffset.
+     *
+     * Instanced and plain VAOs of a layout are separate entries, so
+     * per-instance attributes never stay enabled for non-instanced draws.
+     * A changed instance offset costs one glVertexArrayVertexBuffer with
+     * direct state access, or re-pointing the instance attributes otherwise.
+     */
+    GLuint bindInstanced(const VertexLayout& layout, GLuint vertexBuffer, GLuint indexBuffer,
+                         const VertexLayout& instanceLayout, GLuint instanceBuffer, GLintptr instanceOffset);
+
+    /**
+     * @brief Detaches @p buffer from every cached VAO; call before deleting it.
+     */
+    void forget(GLuint buffer);
+
+    /**
+     * @brief Deletes every cached VAO.
+     */
+    void clear();
+
+    std::size_t size() const
+    {
+        return m_arrays.size();
+    }
+
+    bool usesDirectStateAccess() const
+    {
+        return m_directStateAccess;
+    }
+
+    const Stats& getStats() const
+    {
+        return m_stats;
+    }
+
+  private:
+    struct Entry
+    {
+        GLuint   vao            = 0;
+        GLuint   vertexBuffer   = 0;
+        GLuint   indexBuffer    = 0;
+        GLintptr vertexOffset   = 0;
+        GLuint   instanceBuffer = 0; ///< Instanced entries only.
+        GLintptr instanceOffset = 0;
+    };
+
+    bool                                     m_directStateAccess;
+    std::unordered_map<std::uint64_t, Entry> m_arrays;
+    Stats                                    m_stats;
+
+    /**
+     * @brief Finds or creates the entry and, with direct state access,
+     *        attaches the vertex and index buffers.
+     */
+    Entry& acquire(const VertexLayout& layout, const VertexLayout* instanceLayout, GLuint vertexBuffer,
+                   GLuint indexBuffer, GLintptr vertexOffset);
+
+    Entry createDirect(const VertexLayout& layout, const VertexLayout* instanceLayout);
+    Entry createBound(const VertexLayout& layout, const VertexLayout* instanceLayout, GLuint vertexBuffer,
+                      GLuint indexBuffer, GLintptr vertexOffset);
+};
+
+#endif // LEARNOPENGL_VERTEX_ARRAY_CACHE_H
@@ -5,9 +5,14 @@
 #ifndef LEARNOPENGL_VERTEX_BUFFER_H
 #define LEARNOPENGL_VERTEX_BUFFER_H
 
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <glad/glad.h>
 #include <vector>
 
+class UploadQueue;
+
 /**
  * @brief RAII wrapper for an OpenGL Vertex Buffer Object (VBO).
  *
@@ -15,10 +20,47 @@
  * and deletion of an OpenGL Vertex Buffer Object. This ensures clean
  * resource management by preventing accidental copying and enabling
  * efficient moving of buffers.
+ *
+ * A buffer made with createStreaming() holds per-frame dynamic vertex data
+ * instead. It is split into `frames` regions and the CPU writes straight
+ * into the region of the current frame:
+ * @code
+ *   stream.beginFrame();                          // waits until the GPU released the region
+ *   auto a = stream.write(vertices, bytes);       // any number of writes
+ *   stream.flush();                               // no-op when persistently mapped
+ *   glDrawArrays(GL_TRIANGLES, a.firstVertex(stride), count);
+ *   stream.endFrame();                            // fences the region
+ * @endcode
+ * With GL_ARB_buffer_storage the buffer is mapped once, persistently and
+ * coherently, and each region is guarded by a fence, so a frame costs no
+ * glBufferSubData copy and no implicit synchronization. On a plain GL 3.3
+ * context beginFrame() orphans the buffer and maps it unsynchronized instead,
+ * which lets the driver hand out fresh storage while the GPU still reads the
+ * old one.
  */
 class VertexBuffer
 {
   public:
+    static constexpr unsigned kMaxFrames = 4;
+
+    /**
+     * @brief A range written into the current frame of a streaming buffer.
+     */
+    struct Allocation
+    {
+        GLintptr   offset = 0; ///< Absolute byte offset in the buffer.
+        GLsizeiptr size   = 0;
+
+        /**
+         * @brief The vertex index of the range, for glDrawArrays(first) or a
+         *        base vertex, when the VAO sources the buffer from offset 0.
+         */
+        GLint firstVertex(const GLsizei stride) const
+        {
+            return static_cast<GLint>(offset / stride);
+        }
+    };
+
     /**
      * @brief Constructs a VBO from a raw pointer and size.
      *
@@ -36,6 +78,17 @@ class VertexBuffer
      */
     explicit VertexBuffer(const std::vector<float>& vertices, GLenum usage = GL_STATIC_DRAW);
 
+    /**
+     * @brief Creates a streaming buffer for data rewritten every frame.
+     *
+     * Persistently mapped when Platform::glExtensions().bufferStorage is
+     * set, orphaned every frame otherwise.
+     *
+     * @param bytesPerFrame Capacity of one frame region.
+     * @param frames        Frames in flight, at most kMaxFrames.
+     */
+    static VertexBuffer createStreaming(size_t bytesPerFrame, unsigned frames = 3);
+
     /**
      * @brief Deleted copy constructor.
      *
@@ -88,14 +141,97 @@ class VertexBuffer
     /**
      * @brief Updates a portion or all of the buffer's data.
      *
+     * Goes through GL_COPY_WRITE_BUFFER, so the buffer does not need to be
+     * bound and the GL_ARRAY_BUFFER binding is left alone.
+     *
      * @param data   Pointer to the new data.
      * @param size   Size of the new data in bytes.
      * @param offset Offset into the buffer where data should be written.
      *
-     * @note The buffer must already be bound before calling this function.
+     * @throws std::logic_error on a streaming buffer; use write() instead.
      */
     void updateData(const void* data, size_t size, size_t offset = 0);
 
+    /**
+     * @brief Like updateData(), but the copy goes through @p queue and is
+     *        spread over frames by its budget.
+     *
+     * The data is copied, so it may be released on return. The buffer must
+     * outlive the upload.
+     *
+     * @return The queue's ticket; UploadQueue::isComplete() tells when the
+     *         new contents are visible to draws.
+     * @throws std::logic_error on a streaming buffer.
+     */
+    std::uint64_t updateDataAsync(UploadQueue& queue, const void* data, size_t size, size_t offset = 0);
+
+    /**
+     * @brief Streaming only: waits until the GPU is done with the next region
+     *        and makes it writable.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Streaming only: reserves @p size bytes in the current region.
+     *
+     * @param data      Receives a write pointer into the mapped region.
+     * @param alignment Offset alignment; the vertex stride keeps firstVertex() exact.
+     *
+     * @throws std::runtime_error if the region is exhausted or not mapped.
+     */
+    Allocation allocate(size_t size, void** data, size_t alignment = 16);
+
+    /**
+     * @brief Streaming only: copies @p size bytes into the current region.
+     */
+    Allocation write(const void* data, const size_t size, const size_t alignment = 16)
+    {
+        void*            target     = nullptr;
+        const Allocation allocation = allocate(size, &target, alignment);
+        std::memcpy(target, data, size);
+        return allocation;
+    }
+
+    /**
+     * @brief Streaming only: makes the writes visible to the GPU. Call after
+     *        the last write() and before the first draw of the frame.
+     *
+     * Unmaps the orphaned buffer; a coherent persistent mapping needs nothing.
+     */
+    void flush();
+
+    /**
+     * @brief Streaming only: fences the region. Call after the frame's last draw.
+     */
+    void endFrame();
+
+    /**
+     * @brief Returns true if the buffer was made by createStreaming().
+     */
+    bool isStreaming() const
+    {
+        return m_mode != Mode::Static;
+    }
+
+    /**
+     * @brief Returns true if streaming uses a persistent mapping.
+     */
+    bool isPersistent() const
+    {
+        return m_mode == Mode::Persistent;
+    }
+
+    /**
+     * @brief Number of beginFrame() calls that had to wait on the GPU.
+     *
+     * A growing count means the GPU runs more frames behind than there are
+     * regions.
+     */
+    unsigned getStallCount() const
+    {
+        return m_stalls;
+    }
+
     /**
      * @brief Returns the OpenGL buffer ID.
      */
@@ -113,9 +249,30 @@ class VertexBuffer
     }
 
   private:
+    enum class Mode
+    {
+        Static,
+        Persistent, ///< Streaming through a persistent coherent mapping.
+        Orphaning,  ///< Streaming through glBufferData orphaning.
+    };
+
     unsigned int m_id; ///< The OpenGL-generated buffer ID.
     size_t m_size;     ///< Size of the buffer (in bytes).
 
+    // Streaming state
+    Mode     m_mode;
+    size_t   m_regionSize;
+    unsigned m_frames;
+    unsigned m_frame;
+    size_t   m_cursor;
+    char*    m_persistent; ///< Whole-buffer mapping, Mode::Persistent only.
+    char*    m_mapped;     ///< Current region while writable.
+    unsigned m_stalls;
+
+    std::array<GLsync, kMaxFrames> m_fences;
+
+    VertexBuffer();
+
     /**
      * @brief Creates the VBO and uploads initial data.
      *
@@ -124,6 +281,11 @@ class VertexBuffer
      * @param usage OpenGL buffer usage hint (e.g., GL_STATIC_DRAW).
      */
     void createBuffer(const void* data, size_t size, GLenum usage);
+
+    /**
+     * @brief Deletes the buffer, its mapping and its fences.
+     */
+    void release();
 };
 
 #endif // LEARNOPENGL_VERTEX_BUFFER_H
@@ -0,0 +1,282 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_VERTEX_LAYOUT_H
+#define LEARNOPENGL_VERTEX_LAYOUT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "core/Hash.h"
+
+/**
+ * @brief Storage formats of a vertex attribute.
+ *
+ * The quantized ones trade precision for bandwidth; the GPU expands them
+ * back to floats during vertex fetch at no shader cost:
+ *  - Snorm16x4 / Snorm16x2: signed 16-bit, read as [-1, 1]. Positions use
+ *    them relative to the mesh bounds, normals and tangents in octahedral
+ *    encoding (see VertexQuantizer);
+ *  - Half2 / Half4: 16-bit floats, for UVs and other unbounded values.
+ */
+enum class VertexFormat
+{
+    Float1,
+    Float2,
+    Float3,
+    Float4,
+    Snorm16x2,
+    Snorm16x4,
+    Half2,
+    Half4,
+};
+
+/**
+ * @brief One vertex attribute, as passed to glVertexAttribPointer.
+ */
+struct VertexAttribute
+{
+    GLuint    location   = 0;
+    GLint     components = 0;
+    GLenum    type       = GL_FLOAT;
+    GLboolean normalized = GL_FALSE;
+    GLuint    offset     = 0; ///< Byte offset inside one vertex.
+
+    /**
+     * @brief The attribute that reads @p format at @p offset.
+     */
+    static constexpr VertexAttribute make(const GLuint location, const VertexFormat format, const GLuint offset)
+    {
+        switch (format)
+        {
+            case VertexFormat::Float1:
+                return {location, 1, GL_FLOAT, GL_FALSE, offset};
+            case VertexFormat::Float2:
+                return {location, 2, GL_FLOAT, GL_FALSE, offset};
+            case VertexFormat::Float3:
+                return {location, 3, GL_FLOAT, GL_FALSE, offset};
+            case VertexFormat::Float4:
+                return {location, 4, GL_FLOAT, GL_FALSE, offset};
+            case VertexFormat::Snorm16x2:
+                return {location, 2, GL_SHORT, GL_TRUE, offset};
+            case VertexFormat::Snorm16x4:
+                return {location, 4, GL_SHORT, GL_TRUE, offset};
+            case VertexFormat::Half2:
+                return {location, 2, GL_HALF_FLOAT, GL_FALSE, offset};
+            case VertexFormat::Half4:
+                return {location, 4, GL_HALF_FLOAT, GL_FALSE, offset};
+        }
+        return {};
+    }
+
+    /**
+     * @brief Bytes one vertex spends on the attribute.
+     */
+    constexpr std::size_t size() const
+    {
+        const std::size_t componentSize = type == GL_FLOAT ? 4 : type == GL_SHORT || type == GL_HALF_FLOAT ? 2 : 1;
+        return componentSize * static_cast<std::size_t>(components);
+    }
+};
+
+/**
+ * @brief The interleaved attributes of one vertex buffer.
+ */
+struct VertexLayout
+{
+    std::vector<VertexAttribute> attributes;
+    GLsizei                      stride = 0;
+
+    /**
+     * @brief Points the attributes at the buffer bound to GL_ARRAY_BUFFER
+     *        and enables them on the bound VAO.
+     */
+    void apply() const
+    {
+        for (const VertexAttribute& attribute : attributes)
+        {
+            glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized,
+                                  stride, reinterpret_cast<const void*>(static_cast<GLintptr>(attribute.offset)));
+            glEnableVertexAttribArray(attribute.location);
+        }
+    }
+
+    /**
+     * @brief Identifies the layout for VertexArrayCache; equal layouts hash equally.
+     */
+    std::uint64_t hash() const
+    {
+        std::uint64_t value = Core::fnv1a(&stride, sizeof(stride));
+        for (const VertexAttribute& attribute : attributes)
+        {
+            const GLuint fields[] = {attribute.location, static_cast<GLuint>(attribute.components), attribute.type,
+                                     attribute.normalized, attribute.offset};
+            value = Core::fnv1a(fields, sizeof(fields), value);
+        }
+        return value;
+    }
+};
+
+// -------------------------------------------------------
+// Compile-time layouts from vertex structs
+// -------------------------------------------------------
+
+/**
+ * @brief Maps a vertex struct member type to its VertexFormat.
+ *
+ * 16-bit arrays are taken as quantized data: signed ones as snorm16,
+ * unsigned ones as half floats.
+ */
+template <typename T>
+struct VertexFormatOf;
+
+template <>
+struct VertexFormatOf<float>
+{
+    static constexpr VertexFormat value = VertexFormat::Float1;
+};
+
+template <>
+struct VertexFormatOf<float[2]>
+{
+    static constexpr VertexFormat value = VertexFormat::Float2;
+};
+
+template <>
+struct VertexFormatOf<float[3]>
+{
+    static constexpr VertexFormat value = VertexFormat::Float3;
+};
+
+template <>
+struct VertexFormatOf<float[4]>
+{
+    static constexpr VertexFormat value = VertexFormat::Float4;
+};
+
+template <>
+struct VertexFormatOf<glm::vec2>
+{
+    static constexpr VertexFormat value = VertexFormat::Float2;
+};
+
+template <>
+struct VertexFormatOf<glm::vec3>
+{
+    static constexpr VertexFormat value = VertexFormat::Float3;
+};
+
+template <>
+struct VertexFormatOf<glm::vec4>
+{
+    static constexpr VertexFormat value = VertexFormat::Float4;
+};
+
+template <>
+struct VertexFormatOf<std::int16_t[2]>
+{
+    static constexpr VertexFormat value = VertexFormat::Snorm16x2;
+};
+
+template <>
+struct VertexFormatOf<std::int16_t[4]>
+{
+    static constexpr VertexFormat value = VertexFormat::Snorm16x4;
+};
+
+template <>
+struct VertexFormatOf<std::uint16_t[2]>
+{
+    static constexpr VertexFormat value = VertexFormat::Half2;
+};
+
+template <>
+struct VertexFormatOf<std::uint16_t[4]>
+{
+    static constexpr VertexFormat value = VertexFormat::Half4;
+};
+
+/**
+ * @brief The attribute at @p location reading @p member of @p Vertex, with
+ *        its format deduced from the member's type.
+ */
+#define VERTEX_ATTRIBUTE(Vertex, member, location)                                                                    \
+    ::VertexAttribute::make((location), ::VertexFormatOf<decltype(Vertex::member)>::value,                            \
+                            static_cast<GLuint>(offsetof(Vertex, member)))
+
+/**
+ * @brief A layout fixed at compile time; build one with makeVertexLayout().
+ */
+template <typename Vertex, std::size_t N>
+struct StaticVertexLayout
+{
+    std::array<VertexAttribute, N> attributes;
+
+    /**
+     * @brief True if every attribute lies inside the vertex and none overlap.
+     */
+    constexpr bool isValid() const
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (attributes[i].offset + attributes[i].size() > sizeof(Vertex))
+            {
+                return false;
+            }
+            for (std::size_t j = i + 1; j < N; ++j)
+            {
+                const bool disjoint = attributes[i].offset + attributes[i].size() <= attributes[j].offset ||
+                                      attributes[j].offset + attributes[j].size() <= attributes[i].offset;
+                if (!disjoint || attributes[i].location == attributes[j].location)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    VertexLayout toLayout() const
+    {
+        return {{attributes.begin(), attributes.end()}, static_cast<GLsizei>(sizeof(Vertex))};
+    }
+};
+
+template <typename Vertex, typename... Attributes>
+constexpr StaticVertexLayout<Vertex, sizeof...(Attributes)> makeVertexLayout(const Attributes&... attributes)
+{
+    return {{attributes...}};
+}
+
+/**
+ * @brief Specialize for a vertex struct to give it a layout:
+ * @code
+ *   struct MeshVertex { glm::vec3 position; std::int16_t normal[2]; };
+ *
+ *   template <> struct VertexTraits<MeshVertex>
+ *   {
+ *       static constexpr auto layout = makeVertexLayout<MeshVertex>(
+ *           VERTEX_ATTRIBUTE(MeshVertex, position, 0),
+ *           VERTEX_ATTRIBUTE(MeshVertex, normal, 1));
+ *       static_assert(layout.isValid());
+ *   };
+ * @endcode
+ */
+template <typename Vertex>
+struct VertexTraits;
+
+/**
+ * @brief The runtime layout of a vertex struct with a VertexTraits specialization.
+ */
+template <typename Vertex>
+VertexLayout vertexLayoutOf()
+{
+    return VertexTraits<Vertex>::layout.toLayout();
+}
+
+#endif // LEARNOPENGL_VERTEX_LAYOUT_H
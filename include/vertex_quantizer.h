@@ -0,0 +1,128 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_VERTEX_QUANTIZER_H
+#define LEARNOPENGL_VERTEX_QUANTIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "vertex_layout.h"
+
+/**
+ * @brief Compact vertex written by VertexQuantizer::quantize(): 16 bytes
+ *        instead of the 32 of float position, normal and UV.
+ */
+struct QuantizedVertex
+{
+    std::int16_t  position[4]; ///< Snorm16 relative to the mesh bounds; w is 1.
+    std::int16_t  normal[2];   ///< Snorm16 octahedral.
+    std::uint16_t uv[2];       ///< Half floats.
+};
+
+static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex must stay tightly packed");
+
+template <>
+struct VertexTraits<QuantizedVertex>
+{
+    static constexpr auto layout = makeVertexLayout<QuantizedVertex>(VERTEX_ATTRIBUTE(QuantizedVertex, position, 0),
+                                                                     VERTEX_ATTRIBUTE(QuantizedVertex, normal, 1),
+                                                                     VERTEX_ATTRIBUTE(QuantizedVertex, uv, 2));
+    static_assert(layout.isValid());
+};
+
+/**
+ * @brief Batch conversion of float vertex streams into quantized formats.
+ *
+ * - Positions are mapped into the mesh's bounding box as snorm16 with
+ *   w = 1, so the GPU reads them as vec4 and the dequantization is one
+ *   affine matrix, Bounds::dequantizeMatrix(), folded into the model matrix:
+ *   @code
+ *     gl_Position = uViewProjection * uModel * aPosition;   // uModel *= bounds.dequantizeMatrix()
+ *   @endcode
+ *   The error is at most half of extent / 32767 per axis.
+ * - Unit vectors use octahedral encoding in two snorm16 values; decode with
+ *   octDecode() from shaders/quantized.glsl. Tangents go through the same
+ *   kernel; their handedness sign has to be stored separately.
+ * - UVs become half floats.
+ *
+ * Each kernel has an SSE2 path, an AVX2 path (8 vertices per iteration,
+ * with F16C for halves) when the build enables LEARNOPENGL_AVX2, and a
+ * scalar path built on glm/gtc/packing.hpp that also handles the tail. The
+ * SIMD paths round ties to even where glm rounds them away from zero, so
+ * they may differ from it by one unit on exact ties.
+ *
+ * Input streams are tightly packed floats; outputs are written @p outStride
+ * bytes apart, so they can go straight into an interleaved vertex.
+ */
+class VertexQuantizer
+{
+  public:
+    struct Bounds
+    {
+        glm::vec3 min {0.0f};
+        glm::vec3 max {0.0f};
+
+        glm::vec3 center() const
+        {
+            return (min + max) * 0.5f;
+        }
+
+        /// Half-size per axis, never zero.
+        glm::vec3 extent() const;
+
+        /**
+         * @brief Maps quantized positions back to object space.
+         */
+        glm::mat4 dequantizeMatrix() const;
+    };
+
+    /**
+     * @brief Name of the compiled kernel path: "AVX2", "SSE2" or "scalar".
+     */
+    static const char* simdPath();
+
+    /**
+     * @brief Axis-aligned bounds of @p count float3 positions.
+     */
+    static Bounds computeBounds(const float* positions, std::size_t count);
+
+    /**
+     * @brief Writes 4 × snorm16 per position, w = 1.
+     */
+    static void quantizePositions(const float* positions, std::size_t count, const Bounds& bounds, void* out,
+                                  std::size_t outStride);
+
+    /**
+     * @brief Writes 2 × snorm16 per unit vector, octahedral. A zero vector
+     *        encodes as +Z.
+     */
+    static void encodeOctahedral(const float* vectors, std::size_t count, void* out, std::size_t outStride);
+
+    /**
+     * @brief Writes 2 × half float per UV.
+     */
+    static void packHalf2(const float* uvs, std::size_t count, void* out, std::size_t outStride);
+
+    /**
+     * @brief Fills QuantizedVertex records from separate float streams.
+     *
+     * @param normals float3 per vertex, or null for a zero normal.
+     * @param uvs     float2 per vertex, or null for zero UVs.
+     * @return The bounds the positions were quantized against.
+     */
+    static Bounds quantize(const float* positions, const float* normals, const float* uvs, std::size_t count,
+                           QuantizedVertex* out);
+
+    /**
+     * @brief The attributes of QuantizedVertex at locations 0, 1 and 2.
+     */
+    static VertexLayout layout()
+    {
+        return vertexLayoutOf<QuantizedVertex>();
+    }
+};
+
+#endif // LEARNOPENGL_VERTEX_QUANTIZER_H
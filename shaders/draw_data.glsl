@@ -0,0 +1,35 @@
+#ifndef DRAW_DATA_GLSL
+#define DRAW_DATA_GLSL
+
+// Per-draw records of a MeshRegistry. Declare `struct DrawRecord` first, then
+// read the current draw's record through DRAW. Use only vec4 / mat4 members,
+// so std140 and std430 lay the record out the same way. Only the vertex
+// stage sees gl_DrawIDARB; forward what the fragment stage needs as flat outputs.
+//
+// When the registry uses multi-draw indirect it is compiled with
+// MULTI_DRAW_INDIRECT, and the stage must enable, right after #version:
+//   #ifdef MULTI_DRAW_INDIRECT
+//   #extension GL_ARB_shader_storage_buffer_object : require
+//   #extension GL_ARB_shader_draw_parameters : require
+//   #extension GL_ARB_shading_language_420pack : require
+//   #endif
+
+#ifndef DRAW_DATA_BINDING
+#define DRAW_DATA_BINDING 0
+#endif
+
+#ifdef MULTI_DRAW_INDIRECT
+layout(std430, binding = DRAW_DATA_BINDING) readonly buffer DrawDataBuffer
+{
+    DrawRecord drawRecords[];
+};
+#define DRAW drawRecords[gl_DrawIDARB]
+#else
+layout(std140) uniform DrawDataBlock
+{
+    DrawRecord drawRecord;
+};
+#define DRAW drawRecord
+#endif
+
+#endif
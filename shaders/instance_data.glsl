@@ -0,0 +1,11 @@
+#ifndef INSTANCE_DATA_GLSL
+#define INSTANCE_DATA_GLSL
+
+// Per-instance attributes of an InstanceBatch draw, matching InstanceData.
+// Locations 0-3 are left to the mesh's own vertex attributes.
+
+layout(location = 4) in mat4 aInstanceTransform;
+layout(location = 8) in vec4 aInstanceColor;
+layout(location = 9) in vec4 aInstanceCustom;
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef QUANTIZED_GLSL
+#define QUANTIZED_GLSL
+
+// Inverse of VertexQuantizer::encodeOctahedral: two snorm16 values, already
+// expanded to [-1, 1] by the vertex fetch, back to a unit vector.
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+#endif
@@ -0,0 +1,229 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "command_buffer.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "platform/GLState.h"
+#include "shader/program.h"
+
+struct CommandBuffer::Command
+{
+    struct Draw
+    {
+        GLint   baseVertex;
+        GLuint  firstIndex;
+        GLsizei indexCount;
+        GLenum  mode;
+    };
+
+    struct Uniforms
+    {
+        GLuint      binding;
+        GLsizeiptr  size;
+        const void* data;   ///< In the buffer's allocator.
+        GLintptr    offset; ///< In the UniformRing, filled by execute().
+    };
+
+    Type     type;
+    Command* next;
+    union
+    {
+        const ShaderProgram* program;
+        const GeometryArena* arena;
+        Draw                 draw;
+        Uniforms             uniforms;
+        GLint                viewport[4];
+        bool                 enabled;
+    };
+};
+
+CommandBuffer::CommandBuffer(const std::size_t blockSize)
+    : m_allocator(blockSize)
+    , m_first(nullptr)
+    , m_last(nullptr)
+    , m_count(0)
+    , m_hasUniforms(false)
+{}
+
+CommandBuffer::CommandBuffer(CommandBuffer&& other) noexcept
+    : m_allocator(std::move(other.m_allocator))
+    , m_first(std::exchange(other.m_first, nullptr))
+    , m_last(std::exchange(other.m_last, nullptr))
+    , m_count(std::exchange(other.m_count, 0))
+    , m_hasUniforms(std::exchange(other.m_hasUniforms, false))
+{}
+
+CommandBuffer& CommandBuffer::operator=(CommandBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        m_allocator = std::move(other.m_allocator);
+        m_first = std::exchange(other.m_first, nullptr);
+        m_last = std::exchange(other.m_last, nullptr);
+        m_count = std::exchange(other.m_count, 0);
+        m_hasUniforms = std::exchange(other.m_hasUniforms, false);
+    }
+    return *this;
+}
+
+void CommandBuffer::bindProgram(const ShaderProgram& program)
+{
+    push(Type::BindProgram).program = &program;
+}
+
+void CommandBuffer::bindGeometry(const GeometryArena& arena)
+{
+    push(Type::BindGeometry).arena = &arena;
+}
+
+void CommandBuffer::draw(const GeometryArena::Mesh& mesh, const GLenum mode)
+{
+    push(Type::Draw).draw = {mesh.baseVertex, mesh.firstIndex, mesh.indexCount, mode};
+}
+
+void CommandBuffer::setUniforms(const GLuint binding, const void* data, const std::size_t size)
+{
+    void* copy = m_allocator.allocate(size, 16);
+    std::memcpy(copy, data, size);
+    push(Type::Uniforms).uniforms = {binding, static_cast<GLsizeiptr>(size), copy, 0};
+    m_hasUniforms = true;
+}
+
+void CommandBuffer::setViewport(const GLint x, const GLint y, const GLsizei width, const GLsizei height)
+{
+    Command& command = push(Type::Viewport);
+    command.viewport[0] = x;
+    command.viewport[1] = y;
+    command.viewport[2] = width;
+    command.viewport[3] = height;
+}
+
+void CommandBuffer::setBlend(const bool enabled)
+{
+    push(Type::Blend).enabled = enabled;
+}
+
+void CommandBuffer::setDepthTest(const bool enabled)
+{
+    push(Type::DepthTest).enabled = enabled;
+}
+
+void CommandBuffer::setCullFace(const bool enabled)
+{
+    push(Type::CullFace).enabled = enabled;
+}
+
+void CommandBuffer::reset()
+{
+    m_allocator.reset();
+    m_first = nullptr;
+    m_last = nullptr;
+    m_count = 0;
+    m_hasUniforms = false;
+}
+
+CommandBuffer::Stats CommandBuffer::execute(const std::vector<CommandBuffer*>& buffers, UniformRing* uniforms)
+{
+    Stats stats;
+
+    // Stage every uniform block first: the ring has to be unmapped before the first draw
+    bool staged = false;
+    for (CommandBuffer* buffer : buffers)
+    {
+        if (!buffer->m_hasUniforms)
+        {
+            continue;
+        }
+        if (!uniforms)
+        {
+            throw std::logic_error("CommandBuffer::execute(): uniforms recorded but no UniformRing given");
+        }
+
+        for (Command* command = buffer->m_first; command; command = command->next)
+        {
+            if (command->type != Type::Uniforms)
+            {
+                continue;
+            }
+            void*                         target = nullptr;
+            const UniformRing::Allocation allocation =
+                uniforms->allocate(static_cast<size_t>(command->uniforms.size), &target);
+            std::memcpy(target, command->uniforms.data, static_cast<size_t>(command->uniforms.size));
+            command->uniforms.offset = allocation.offset;
+            stats.uniformBytes += static_cast<std::size_t>(command->uniforms.size);
+        }
+        staged = true;
+    }
+    if (staged)
+    {
+        uniforms->flush();
+    }
+
+    Platform::GLState&   state = Platform::glState();
+    const GeometryArena* arena = nullptr;
+
+    for (const CommandBuffer* buffer : buffers)
+    {
+        for (const Command* command = buffer->m_first; command; command = command->next)
+        {
+            ++stats.commands;
+            switch (command->type)
+            {
+                case Type::BindProgram: command->program->bind(); break;
+                case Type::BindGeometry:
+                    arena = command->arena;
+                    arena->bind();
+                    break;
+                case Type::Draw:
+                {
+                    if (!arena)
+                    {
+                        throw std::logic_error("CommandBuffer::execute(): draw recorded before bindGeometry()");
+                    }
+                    GeometryArena::Mesh mesh;
+                    mesh.baseVertex = command->draw.baseVertex;
+                    mesh.firstIndex = command->draw.firstIndex;
+                    mesh.indexCount = command->draw.indexCount;
+                    arena->draw(mesh, command->draw.mode);
+                    ++stats.draws;
+                    break;
+                }
+                case Type::Uniforms:
+                    uniforms->bind(command->uniforms.binding, {command->uniforms.offset, command->uniforms.size});
+                    break;
+                case Type::Viewport:
+                    state.setViewport(command->viewport[0], command->viewport[1], command->viewport[2],
+                                      command->viewport[3]);
+                    break;
+                case Type::Blend: state.setBlend(command->enabled); break;
+                case Type::DepthTest: state.setDepthTest(command->enabled); break;
+                case Type::CullFace: state.setCullFace(command->enabled); break;
+            }
+        }
+    }
+    return stats;
+}
+
+CommandBuffer::Command& CommandBuffer::push(const Type type)
+{
+    Command* command = static_cast<Command*>(m_allocator.allocate(sizeof(Command), alignof(Command)));
+    command->type = type;
+    command->next = nullptr;
+
+    if (m_last)
+    {
+        m_last->next = command;
+    }
+    else
+    {
+        m_first = command;
+    }
+    m_last = command;
+    ++m_count;
+    return *command;
+}
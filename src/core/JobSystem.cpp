@@ -0,0 +1,302 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "core/JobSystem.h"
+
+#include <stdexcept>
+
+namespace Core
+{
+    namespace
+    {
+        constexpr std::size_t kJobsPerChunk = 256;
+
+        // Rounds spent retrying before an idle worker goes to sleep
+        constexpr int kIdleSpins = 64;
+
+        struct CurrentThread
+        {
+            const JobSystem* system = nullptr;
+            unsigned         index  = 0;
+        };
+
+        thread_local CurrentThread s_current;
+
+        std::uint64_t nextRandom(std::uint64_t& state)
+        {
+            // xorshift64*
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 0x2545F4914F6CDD1Dull;
+        }
+    } // namespace
+
+    JobSystem::JobSystem(const JobSystemConfig& config)
+        : m_stopping(false)
+        , m_queued(0)
+        , m_sleeping(0)
+        , m_executed(0)
+        , m_stolen(0)
+        , m_inlined(0)
+        , m_pooled(0)
+    {
+        unsigned workers = static_cast<unsigned>(config.workerThreads);
+        if (config.workerThreads < 0)
+        {
+            const unsigned hardware = std::thread::hardware_concurrency();
+            workers = hardware > 1 ? hardware - 1 : 0;
+        }
+
+        // Index 0 is the building thread, which only works inside wait()
+        for (unsigned i = 0; i <= workers; ++i)
+        {
+            m_threads.push_back(std::make_unique<Thread>(config.queueCapacity));
+            m_threads.back()->random = 0x9E3779B97F4A7C15ull * (i + 1);
+        }
+
+        s_current = {this, 0};
+        for (unsigned i = 1; i <= workers; ++i)
+        {
+            m_threads[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping.store(true);
+        }
+        m_wake.notify_all();
+
+        for (const std::unique_ptr<Thread>& thread : m_threads)
+        {
+            if (thread->thread.joinable())
+            {
+                thread->thread.join();
+            }
+        }
+
+        // The workers are gone, so this thread may pop every deque
+        for (const std::unique_ptr<Thread>& thread : m_threads)
+        {
+            while (Job* job = thread->deque.pop())
+            {
+                job->destroy(*job);
+            }
+        }
+
+        if (s_current.system == this)
+        {
+            s_current = {};
+        }
+    }
+
+    void JobSystem::wait(const Counter& counter)
+    {
+        const unsigned self = currentThread();
+        while (!counter.isDone())
+        {
+            if (!runOne(self))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // complete() may still be inside the counter's lock; let it leave
+        // before the caller is free to destroy the counter
+        std::lock_guard lock(counter.m_mutex);
+    }
+
+    JobSystem::Stats JobSystem::getStats() const
+    {
+        return {m_executed.load(std::memory_order_relaxed), m_stolen.load(std::memory_order_relaxed),
+                m_inlined.load(std::memory_order_relaxed), m_pooled.load(std::memory_order_relaxed)};
+    }
+
+    void JobSystem::submit(Job* job)
+    {
+        Thread& self = *m_threads[currentThread()];
+
+        m_queued.fetch_add(1);
+        if (!self.deque.push(job))
+        {
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            m_inlined.fetch_add(1, std::memory_order_relaxed);
+            execute(job);
+            return;
+        }
+
+        // Pairs with the sleeping increment in workerLoop(): either this sees
+        // the sleeper or the sleeper sees the job
+        if (m_sleeping.load() > 0)
+        {
+            std::lock_guard lock(m_mutex);
+            m_wake.notify_one();
+        }
+    }
+
+    void JobSystem::execute(Job* job)
+    {
+        job->invoke(*job);
+        job->destroy(*job);
+
+        Counter* counter = job->counter;
+        release(job);
+        m_executed.fetch_add(1, std::memory_order_relaxed);
+
+        if (counter)
+        {
+            complete(*counter);
+        }
+    }
+
+    void JobSystem::complete(Counter& counter)
+    {
+        // Only the drop to zero takes the lock; wait() takes it afterwards, so
+        // the counter outlives this call
+        std::uint32_t pending = counter.m_pending.load(std::memory_order_relaxed);
+        while (pending > 1)
+        {
+            if (counter.m_pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel,
+                                                        std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+
+        Job* continuations = nullptr;
+        {
+            std::lock_guard lock(counter.m_mutex);
+            if (counter.m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                continuations = std::exchange(counter.m_continuations, nullptr);
+            }
+        }
+
+        while (continuations)
+        {
+            Job* next = std::exchange(continuations->next, nullptr);
+            submit(continuations);
+            continuations = next;
+        }
+    }
+
+    void JobSystem::release(Job* job)
+    {
+        const unsigned self = currentThread();
+        if (job->owner == self)
+        {
+            Thread& thread = *m_threads[self];
+            job->next = thread.freeJobs;
+            thread.freeJobs = job;
+            return;
+        }
+
+        // A stolen job: without this its slot would be lost to the spawning
+        // thread, which would keep growing its pool
+        std::atomic<Job*>& returned = m_threads[job->owner]->returned;
+        job->next = returned.load(std::memory_order_relaxed);
+        while (!returned.compare_exchange_weak(job->next, job, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    bool JobSystem::runOne(const unsigned self)
+    {
+        Thread& thread = *m_threads[self];
+        Job*    job = thread.deque.pop();
+
+        if (!job)
+        {
+            const auto count = static_cast<unsigned>(m_threads.size());
+            const auto start = static_cast<unsigned>(nextRandom(thread.random) % count);
+            for (unsigned i = 0; i < count && !job; ++i)
+            {
+                const unsigned victim = (start + i) % count;
+                if (victim != self)
+                {
+                    job = m_threads[victim]->deque.steal();
+                }
+            }
+            if (!job)
+            {
+                return false;
+            }
+        }
+
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        if (job->owner != self)
+        {
+            m_stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+        execute(job);
+        return true;
+    }
+
+    void JobSystem::workerLoop(const unsigned self)
+    {
+        s_current = {this, self};
+
+        int idle = 0;
+        while (!m_stopping.load(std::memory_order_relaxed))
+        {
+            if (runOne(self))
+            {
+                idle = 0;
+                continue;
+            }
+            if (++idle < kIdleSpins)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock(m_mutex);
+            m_sleeping.fetch_add(1);
+            m_wake.wait(lock, [this] { return m_stopping.load() || m_queued.load() > 0; });
+            m_sleeping.fetch_sub(1);
+            idle = 0;
+        }
+    }
+
+    unsigned JobSystem::currentThread() const
+    {
+        if (s_current.system != this)
+        {
+            throw std::logic_error("JobSystem: jobs can only be spawned and waited on by the thread that built "
+                                   "the system or from inside a job");
+        }
+        return s_current.index;
+    }
+
+    JobSystem::Job* JobSystem::allocateJob()
+    {
+        const unsigned self = currentThread();
+        Thread&        thread = *m_threads[self];
+
+        if (!thread.freeJobs)
+        {
+            // Taken as a whole list, so there is no ABA on the returned stack
+            thread.freeJobs = thread.returned.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (!thread.freeJobs)
+        {
+            m_pooled.fetch_add(kJobsPerChunk, std::memory_order_relaxed);
+            thread.pool.push_back(std::make_unique<Job[]>(kJobsPerChunk));
+            Job* chunk = thread.pool.back().get();
+            for (std::size_t i = 0; i < kJobsPerChunk; ++i)
+            {
+                chunk[i].next = i + 1 < kJobsPerChunk ? &chunk[i + 1] : nullptr;
+            }
+            thread.freeJobs = chunk;
+        }
+
+        Job* job = thread.freeJobs;
+        thread.freeJobs = job->next;
+        job->owner = self;
+        return job;
+    }
+} // namespace Core
@@ -0,0 +1,56 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "core/LinearAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Core
+{
+    LinearAllocator::LinearAllocator(const std::size_t blockSize)
+        : m_blockSize(std::max<std::size_t>(blockSize, 256))
+        , m_block(0)
+        , m_cursor(0)
+        , m_used(0)
+        , m_capacity(0)
+    {}
+
+    void* LinearAllocator::allocate(const std::size_t size, const std::size_t alignment)
+    {
+        while (m_block < m_blocks.size())
+        {
+            Block&               block   = m_blocks[m_block];
+            const auto           base    = reinterpret_cast<std::uintptr_t>(block.memory.get());
+            const std::uintptr_t aligned = (base + m_cursor + alignment - 1) & ~(std::uintptr_t {alignment} - 1);
+            const std::size_t    offset  = aligned - base;
+
+            if (offset + size <= block.size)
+            {
+                m_used += offset + size - m_cursor;
+                m_cursor = offset + size;
+                return block.memory.get() + offset;
+            }
+
+            // The rest of this block is wasted until reset()
+            ++m_block;
+            m_cursor = 0;
+        }
+
+        // Worst-case padding is alignment - 1, as new[] only guarantees max_align_t
+        const std::size_t blockSize = std::max(m_blockSize, size + alignment);
+        m_blocks.push_back({std::make_unique<std::byte[]>(blockSize), blockSize});
+        m_capacity += blockSize;
+        m_block = m_blocks.size() - 1;
+        m_cursor = 0;
+        return allocate(size, alignment);
+    }
+
+    void LinearAllocator::reset()
+    {
+        m_block = 0;
+        m_cursor = 0;
+        m_used = 0;
+    }
+} // namespace Core
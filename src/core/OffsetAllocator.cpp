@@ -0,0 +1,315 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "core/OffsetAllocator.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace Core
+{
+    namespace
+    {
+        constexpr std::uint32_t kMantissaBits  = 3;
+        constexpr std::uint32_t kMantissaValue = 1u << kMantissaBits;
+        constexpr std::uint32_t kMantissaMask  = kMantissaValue - 1;
+
+        // Bin of the smallest size class that holds at least `size` units
+        std::uint32_t binRoundUp(const std::uint32_t size)
+        {
+            if (size < kMantissaValue)
+            {
+                return size;
+            }
+
+            const std::uint32_t highestBit = 31 - std::countl_zero(size);
+            const std::uint32_t shift      = highestBit - kMantissaBits;
+            std::uint32_t       mantissa   = (size >> shift) & kMantissaMask;
+            if ((size & ((1u << shift) - 1)) != 0)
+            {
+                ++mantissa;
+            }
+            // Addition, so a mantissa overflow carries into the exponent
+            return ((shift + 1) << kMantissaBits) + mantissa;
+        }
+
+        // Bin of the largest size class that `size` units fully cover
+        std::uint32_t binRoundDown(const std::uint32_t size)
+        {
+            if (size < kMantissaValue)
+            {
+                return size;
+            }
+
+            const std::uint32_t highestBit = 31 - std::countl_zero(size);
+            const std::uint32_t shift      = highestBit - kMantissaBits;
+            return ((shift + 1) << kMantissaBits) | ((size >> shift) & kMantissaMask);
+        }
+
+        std::uint32_t lowestBitFrom(const std::uint32_t mask, const std::uint32_t start)
+        {
+            if (start >= 32)
+            {
+                return OffsetAllocator::kNoSpace;
+            }
+            const std::uint32_t remaining = mask & ~((1u << start) - 1);
+            return remaining == 0 ? OffsetAllocator::kNoSpace : std::countr_zero(remaining);
+        }
+    } // namespace
+
+    OffsetAllocator::OffsetAllocator(const std::uint32_t size, const std::uint32_t maxAllocs)
+        : m_size(size)
+        , m_maxAllocs(std::max(maxAllocs, 1u))
+        , m_freeStorage(0)
+        , m_allocations(0)
+        , m_usedBinsTop(0)
+        , m_usedBins {}
+        , m_binIndices {}
+        , m_freeCount(0)
+    {
+        reset();
+    }
+
+    void OffsetAllocator::reset()
+    {
+        m_freeStorage = 0;
+        m_allocations = 0;
+        m_usedBinsTop = 0;
+        std::fill(std::begin(m_usedBins), std::end(m_usedBins), 0);
+        std::fill(std::begin(m_binIndices), std::end(m_binIndices), kUnused);
+
+        m_nodes.assign(m_maxAllocs, Node {});
+        m_freeNodes.resize(m_maxAllocs);
+
+        // Pop order is 0, 1, 2... which keeps early allocations at low node indices
+        for (std::uint32_t i = 0; i < m_maxAllocs; ++i)
+        {
+            m_freeNodes[i] = m_maxAllocs - i - 1;
+        }
+        m_freeCount = m_maxAllocs;
+
+        if (m_size > 0)
+        {
+            insertNodeIntoBin(m_size, 0);
+        }
+    }
+
+    OffsetAllocator::Allocation OffsetAllocator::allocate(const std::uint32_t size)
+    {
+        // A split needs a node for the remainder
+        if (size == 0 || m_freeCount == 0)
+        {
+            return {};
+        }
+
+        const std::uint32_t minBin     = binRoundUp(size);
+        const std::uint32_t minTopBin  = minBin >> kMantissaBits;
+        const std::uint32_t minLeafBin = minBin & kMantissaMask;
+
+        std::uint32_t topBin  = minTopBin;
+        std::uint32_t leafBin = kNoSpace;
+
+        if (topBin < kTopBins && (m_usedBinsTop & (1u << topBin)))
+        {
+            leafBin = lowestBitFrom(m_usedBins[topBin], minLeafBin);
+        }
+
+        if (leafBin == kNoSpace)
+        {
+            topBin = lowestBitFrom(m_usedBinsTop, minTopBin + 1);
+            if (topBin == kNoSpace)
+            {
+                return {};
+            }
+            leafBin = std::countr_zero(static_cast<std::uint32_t>(m_usedBins[topBin]));
+        }
+
+        const std::uint32_t binIndex  = (topBin << kMantissaBits) | leafBin;
+        const std::uint32_t nodeIndex = m_binIndices[binIndex];
+        Node&               node      = m_nodes[nodeIndex];
+        const std::uint32_t nodeSize  = node.size;
+
+        node.size = size;
+        node.used = true;
+
+        // Pop the node off the head of its bin list
+        m_binIndices[binIndex] = node.binListNext;
+        if (node.binListNext != kUnused)
+        {
+            m_nodes[node.binListNext].binListPrev = kUnused;
+        }
+        node.binListNext = kUnused;
+        m_freeStorage -= nodeSize;
+
+        if (m_binIndices[binIndex] == kUnused)
+        {
+            m_usedBins[topBin] &= static_cast<std::uint8_t>(~(1u << leafBin));
+            if (m_usedBins[topBin] == 0)
+            {
+                m_usedBinsTop &= ~(1u << topBin);
+            }
+        }
+
+        if (const std::uint32_t remainder = nodeSize - size; remainder > 0)
+        {
+            const std::uint32_t remainderIndex = insertNodeIntoBin(remainder, m_nodes[nodeIndex].offset + size);
+            Node&               allocated      = m_nodes[nodeIndex];
+
+            if (allocated.neighborNext != kUnused)
+            {
+                m_nodes[allocated.neighborNext].neighborPrev = remainderIndex;
+            }
+            m_nodes[remainderIndex].neighborPrev = nodeIndex;
+            m_nodes[remainderIndex].neighborNext = allocated.neighborNext;
+            allocated.neighborNext               = remainderIndex;
+        }
+
+        ++m_allocations;
+        return {m_nodes[nodeIndex].offset, nodeIndex};
+    }
+
+    void OffsetAllocator::free(const Allocation allocation)
+    {
+        if (!allocation.isValid() || allocation.metadata >= m_maxAllocs || !m_nodes[allocation.metadata].used)
+        {
+            return;
+        }
+
+        const std::uint32_t nodeIndex = allocation.metadata;
+        std::uint32_t       offset    = m_nodes[nodeIndex].offset;
+        std::uint32_t       size      = m_nodes[nodeIndex].size;
+
+        // Merge with free neighbours on both sides
+        if (const std::uint32_t prev = m_nodes[nodeIndex].neighborPrev; prev != kUnused && !m_nodes[prev].used)
+        {
+            offset = m_nodes[prev].offset;
+            size += m_nodes[prev].size;
+            removeNodeFromBin(prev);
+            m_nodes[nodeIndex].neighborPrev = m_nodes[prev].neighborPrev;
+        }
+
+        if (const std::uint32_t next = m_nodes[nodeIndex].neighborNext; next != kUnused && !m_nodes[next].used)
+        {
+            size += m_nodes[next].size;
+            removeNodeFromBin(next);
+            m_nodes[nodeIndex].neighborNext = m_nodes[next].neighborNext;
+        }
+
+        const std::uint32_t neighborPrev = m_nodes[nodeIndex].neighborPrev;
+        const std::uint32_t neighborNext = m_nodes[nodeIndex].neighborNext;
+
+        m_nodes[nodeIndex].used = false;
+        m_freeNodes[m_freeCount++] = nodeIndex;
+        --m_allocations;
+
+        const std::uint32_t merged = insertNodeIntoBin(size, offset);
+        if (neighborPrev != kUnused)
+        {
+            m_nodes[merged].neighborPrev       = neighborPrev;
+            m_nodes[neighborPrev].neighborNext = merged;
+        }
+        if (neighborNext != kUnused)
+        {
+            m_nodes[merged].neighborNext       = neighborNext;
+            m_nodes[neighborNext].neighborPrev = merged;
+        }
+    }
+
+    std::uint32_t OffsetAllocator::allocationSize(const Allocation allocation) const
+    {
+        if (!allocation.isValid() || allocation.metadata >= m_maxAllocs)
+        {
+            return 0;
+        }
+        return m_nodes[allocation.metadata].size;
+    }
+
+    OffsetAllocator::Stats OffsetAllocator::getStats() const
+    {
+        Stats stats;
+        stats.size        = m_size;
+        stats.free        = m_freeStorage;
+        stats.used        = m_size - m_freeStorage;
+        stats.allocations = m_allocations;
+
+        for (std::uint32_t bin = 0; bin < kLeafBins; ++bin)
+        {
+            for (std::uint32_t node = m_binIndices[bin]; node != kUnused; node = m_nodes[node].binListNext)
+            {
+                stats.largestFree = std::max(stats.largestFree, m_nodes[node].size);
+                ++stats.freeRegions;
+            }
+        }
+        return stats;
+    }
+
+    std::uint32_t OffsetAllocator::insertNodeIntoBin(const std::uint32_t size, const std::uint32_t offset)
+    {
+        const std::uint32_t binIndex = binRoundDown(size);
+        const std::uint32_t topBin   = binIndex >> kMantissaBits;
+        const std::uint32_t leafBin  = binIndex & kMantissaMask;
+
+        if (m_binIndices[binIndex] == kUnused)
+        {
+            m_usedBins[topBin] |= static_cast<std::uint8_t>(1u << leafBin);
+            m_usedBinsTop |= 1u << topBin;
+        }
+
+        const std::uint32_t head      = m_binIndices[binIndex];
+        const std::uint32_t nodeIndex = m_freeNodes[--m_freeCount];
+
+        Node& node       = m_nodes[nodeIndex];
+        node             = Node {};
+        node.offset      = offset;
+        node.size        = size;
+        node.binListNext = head;
+        if (head != kUnused)
+        {
+            m_nodes[head].binListPrev = nodeIndex;
+        }
+
+        m_binIndices[binIndex] = nodeIndex;
+        m_freeStorage += size;
+        return nodeIndex;
+    }
+
+    void OffsetAllocator::removeNodeFromBin(const std::uint32_t nodeIndex)
+    {
+        const Node& node = m_nodes[nodeIndex];
+
+        if (node.binListPrev != kUnused)
+        {
+            m_nodes[node.binListPrev].binListNext = node.binListNext;
+            if (node.binListNext != kUnused)
+            {
+                m_nodes[node.binListNext].binListPrev = node.binListPrev;
+            }
+        }
+        else
+        {
+            // Head of its bin: the bin may become empty
+            const std::uint32_t binIndex = binRoundDown(node.size);
+            const std::uint32_t topBin   = binIndex >> kMantissaBits;
+            const std::uint32_t leafBin  = binIndex & kMantissaMask;
+
+            m_binIndices[binIndex] = node.binListNext;
+            if (node.binListNext != kUnused)
+            {
+                m_nodes[node.binListNext].binListPrev = kUnused;
+            }
+
+            if (m_binIndices[binIndex] == kUnused)
+            {
+                m_usedBins[topBin] &= static_cast<std::uint8_t>(~(1u << leafBin));
+                if (m_usedBins[topBin] == 0)
+                {
+                    m_usedBinsTop &= ~(1u << topBin);
+                }
+            }
+        }
+
+        m_freeNodes[m_freeCount++] = nodeIndex;
+        m_freeStorage -= node.size;
+    }
+} // namespace Core
@@ -0,0 +1,104 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "geometry_arena.h"
+
+#include <utility>
+#include <vector>
+
+GeometryArena::GeometryArena(VertexLayout layout, VertexArrayCache& vertexArrays,
+                             const Core::GeometryArenaConfig& config)
+    : m_layout(std::move(layout))
+    , m_vertices(nullptr, static_cast<size_t>(config.vertexCapacity) * m_layout.stride, GL_STATIC_DRAW)
+    , m_indices(config.indexCapacity, IndexBuffer::typeFor(config.vertexCapacity))
+    , m_vertexArrays(vertexArrays)
+    , m_vertexAllocator(config.vertexCapacity, config.maxMeshes * 2)
+    , m_indexAllocator(config.indexCapacity, config.maxMeshes * 2)
+    , m_meshes(0)
+{}
+
+GeometryArena::~GeometryArena()
+{
+    m_vertexArrays.forget(m_vertices.getID());
+    m_vertexArrays.forget(m_indices.getID());
+}
+
+GeometryArena::Mesh GeometryArena::add(const void* vertices, const std::uint32_t vertexCount,
+                                       const std::uint32_t* indices, const std::uint32_t indexCount)
+{
+    Mesh mesh;
+    mesh.vertexAllocation = m_vertexAllocator.allocate(vertexCount);
+    mesh.indexAllocation  = m_indexAllocator.allocate(indexCount);
+
+    if (!mesh.isValid())
+    {
+        m_vertexAllocator.free(mesh.vertexAllocation);
+        m_indexAllocator.free(mesh.indexAllocation);
+        return {};
+    }
+
+    mesh.baseVertex  = static_cast<GLint>(mesh.vertexAllocation.offset);
+    mesh.vertexCount = vertexCount;
+    mesh.firstIndex  = mesh.indexAllocation.offset;
+    mesh.indexCount  = static_cast<GLsizei>(indexCount);
+
+    const size_t stride = static_cast<size_t>(m_layout.stride);
+    m_vertices.updateData(vertices, vertexCount * stride, mesh.vertexAllocation.offset * stride);
+    if (m_indices.getType() == GL_UNSIGNED_SHORT)
+    {
+        const std::vector<std::uint16_t> narrow(indices, indices + indexCount);
+        m_indices.updateData(narrow.data(), indexCount, mesh.indexAllocation.offset);
+    }
+    else
+    {
+        m_indices.updateData(indices, indexCount, mesh.indexAllocation.offset);
+    }
+
+    ++m_meshes;
+    return mesh;
+}
+
+void GeometryArena::remove(Mesh& mesh)
+{
+    if (!mesh.isValid())
+    {
+        return;
+    }
+
+    m_vertexAllocator.free(mesh.vertexAllocation);
+    m_indexAllocator.free(mesh.indexAllocation);
+    --m_meshes;
+    mesh = {};
+}
+
+void GeometryArena::bind() const
+{
+    m_vertexArrays.bind(m_layout, m_vertices.getID(), m_indices.getID());
+}
+
+void GeometryArena::bindInstanced(const VertexLayout& instanceLayout, const GLuint instanceBuffer,
+                                  const GLintptr instanceOffset) const
+{
+    m_vertexArrays.bindInstanced(m_layout, m_vertices.getID(), m_indices.getID(), instanceLayout, instanceBuffer,
+                                 instanceOffset);
+}
+
+void GeometryArena::draw(const Mesh& mesh, const GLenum mode) const
+{
+    const auto offset = static_cast<GLintptr>(mesh.firstIndex) * static_cast<GLintptr>(m_indices.getIndexSize());
+    glDrawElementsBaseVertex(mode, mesh.indexCount, m_indices.getType(), reinterpret_cast<const void*>(offset),
+                             mesh.baseVertex);
+}
+
+void GeometryArena::drawInstanced(const Mesh& mesh, const GLsizei instanceCount, const GLenum mode) const
+{
+    const auto offset = static_cast<GLintptr>(mesh.firstIndex) * static_cast<GLintptr>(m_indices.getIndexSize());
+    glDrawElementsInstancedBaseVertex(mode, mesh.indexCount, m_indices.getType(),
+                                      reinterpret_cast<const void*>(offset), instanceCount, mesh.baseVertex);
+}
+
+GeometryArena::Stats GeometryArena::getStats() const
+{
+    return {m_vertexAllocator.getStats(), m_indexAllocator.getStats(), m_meshes};
+}
@@ -0,0 +1,106 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "index_buffer.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "platform/GLState.h"
+
+GLenum IndexBuffer::typeFor(const size_t vertexCount)
+{
+    return vertexCount <= std::numeric_limits<std::uint16_t>::max() + size_t {1} ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+size_t IndexBuffer::sizeOf(const GLenum type)
+{
+    return type == GL_UNSIGNED_SHORT ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+}
+
+IndexBuffer::IndexBuffer(const std::vector<std::uint32_t>& indices, size_t vertexCount, const GLenum usage)
+    : m_id(0)
+    , m_count(indices.size())
+    , m_type(GL_UNSIGNED_INT)
+{
+    if (vertexCount == 0 && !indices.empty())
+    {
+        vertexCount = *std::max_element(indices.begin(), indices.end()) + size_t {1};
+    }
+    m_type = typeFor(vertexCount);
+
+    if (m_type == GL_UNSIGNED_SHORT)
+    {
+        const std::vector<std::uint16_t> narrow(indices.begin(), indices.end());
+        createBuffer(narrow.data(), narrow.size() * sizeof(std::uint16_t), usage);
+    }
+    else
+    {
+        createBuffer(indices.data(), indices.size() * sizeof(std::uint32_t), usage);
+    }
+}
+
+IndexBuffer::IndexBuffer(const size_t count, const GLenum type, const GLenum usage)
+    : m_id(0)
+    , m_count(count)
+    , m_type(type)
+{
+    createBuffer(nullptr, count * sizeOf(type), usage);
+}
+
+IndexBuffer::IndexBuffer(IndexBuffer&& other) noexcept
+    : m_id(std::exchange(other.m_id, 0))
+    , m_count(std::exchange(other.m_count, 0))
+    , m_type(other.m_type)
+{}
+
+IndexBuffer& IndexBuffer::operator=(IndexBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        m_id = std::exchange(other.m_id, 0);
+        m_count = std::exchange(other.m_count, 0);
+        m_type = other.m_type;
+    }
+    return *this;
+}
+
+IndexBuffer::~IndexBuffer()
+{
+    release();
+}
+
+void IndexBuffer::bind() const
+{
+    Platform::glState().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
+}
+
+void IndexBuffer::updateData(const void* indices, const size_t count, const size_t first)
+{
+    const size_t indexSize = getIndexSize();
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(first * indexSize),
+                    static_cast<GLsizeiptr>(count * indexSize), indices);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void IndexBuffer::createBuffer(const void* data, const size_t size, const GLenum usage)
+{
+    glGenBuffers(1, &m_id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size), data, usage);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void IndexBuffer::release()
+{
+    if (m_id != 0)
+    {
+        Platform::glState().forgetBuffer(m_id);
+        glDeleteBuffers(1, &m_id);
+        m_id = 0;
+    }
+}
@@ -0,0 +1,57 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "instance_batch.h"
+
+InstanceBatch::InstanceBatch(const Core::InstanceBatchConfig& config)
+    : m_buffer(VertexBuffer::createStreaming(static_cast<size_t>(config.maxInstances) * sizeof(InstanceData),
+                                             config.frames))
+    , m_capacity(config.maxInstances)
+{}
+
+void InstanceBatch::beginFrame()
+{
+    m_buffer.beginFrame();
+    m_stats = {};
+}
+
+InstanceBatch::Range InstanceBatch::write(const InstanceData* instances, const std::uint32_t count)
+{
+    // Regions start on a multiple of the stride, so aligning to it wastes
+    // nothing and maxInstances always fit in a frame
+    const VertexBuffer::Allocation allocation =
+        m_buffer.write(instances, static_cast<size_t>(count) * sizeof(InstanceData), sizeof(InstanceData));
+    return {allocation.offset, static_cast<GLsizei>(count)};
+}
+
+void InstanceBatch::flush()
+{
+    m_buffer.flush();
+}
+
+void InstanceBatch::draw(const GeometryArena& arena, const GeometryArena::Mesh& mesh, const Range& range,
+                         const GLenum mode)
+{
+    if (range.count <= 0 || !mesh.isValid())
+    {
+        return;
+    }
+
+    arena.bindInstanced(layout(), m_buffer.getID(), range.offset);
+    arena.drawInstanced(mesh, range.count, mode);
+
+    m_stats.instances += static_cast<std::uint32_t>(range.count);
+    ++m_stats.drawCalls;
+}
+
+void InstanceBatch::endFrame()
+{
+    m_buffer.endFrame();
+}
+
+const VertexLayout& InstanceBatch::layout()
+{
+    static const VertexLayout instanceLayout = vertexLayoutOf<InstanceData>();
+    return instanceLayout;
+}
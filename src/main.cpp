@@ -1,19 +1,39 @@
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <optional>
 #include <vector>
 
 #include "graphics.h"
 
+#include "command_buffer.h"
 #include "core/Config.h"
+#include "core/JobSystem.h"
+#include "geometry_arena.h"
+#include "mesh_optimizer.h"
+#include "platform/GLExtensions.h"
+#include "platform/GLState.h"
 #include "platform/InputHandle.h"
 #include "platform/WindowHandle.h"
+#include "render_queue.h"
+#include "shader/binary_cache.h"
+#include "shader/compiler.h"
+#include "shader/hot_reload.h"
 #include "shader/program.h"
+#include "shader/sources.h"
 #include "shader/stage.h"
+#include "shader/telemetry.h"
+#include "shader/warmup.h"
+#include "upload_queue.h"
+#include "vertex_array_cache.h"
 
 
 int main()
 {
+    const Core::AppConfig config = Core::defaultConfig();
+
     // Create window
-    Platform::WindowHandle window {};
+    Platform::WindowHandle window {config};
 
     if (!window.init())
     {
@@ -25,6 +45,7 @@ int main()
         std::cerr << "[main] gladLoadGLLoader failed\n";
         return -1;
     }
+    Platform::loadGLExtensions((GLADloadproc)glfwGetProcAddress);
 
     Platform::InputHandle input_handler {window.handle()};
     if (!input_handler.init())
@@ -33,55 +54,163 @@ int main()
     }
 
 
+    // Large uploads are spread over frames instead of stalling the one they land in
+    UploadQueue uploads {config.uploads};
+
+    // === GEOMETRY ===
+    VertexArrayCache vertexArrays;
+    const VertexLayout positionLayout {{VertexAttribute::make(0, VertexFormat::Float3, 0)}, 3 * sizeof(float)};
+    GeometryArena geometry {positionLayout, vertexArrays, config.geometry};
+
     std::vector vertices = {
         -0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f, -0.5f, 0.5f, 0.0f,
 
         -0.5f, 0.5f,  0.0f, 0.5f, -0.5f, 0.0f, 0.5f,  0.5f, 0.0f,
     };
 
-    // === VAO ===
-    unsigned int VAO;
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
+    // Weld the shared corners and reorder for the post-transform cache
+    std::vector<std::uint32_t>  quadIndices;
+    std::size_t                 quadVertexCount = vertices.size() / 3;
+    const MeshOptimizer::Report quadReport =
+        MeshOptimizer::optimize(quadIndices, vertices.data(), quadVertexCount, 3 * sizeof(float));
+    std::cout << "[main] quad: " << quadReport.vertexCountBefore << " -> " << quadReport.vertexCountAfter
+              << " vertices, ACMR " << quadReport.acmrBefore << " -> " << quadReport.acmrAfter << "\n";
 
-    // === VBO ===
-    unsigned int VBO;
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-
-    // Vertex attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    const GeometryArena::Mesh quad = geometry.add(vertices.data(), static_cast<std::uint32_t>(quadVertexCount),
+                                                  quadIndices.data(), static_cast<std::uint32_t>(quadIndices.size()));
 
     // === SHADERS ===
-    const ShaderStage vert("shaders/basic.vert", GL_VERTEX_SHADER);
-    const ShaderStage frag("shaders/basic.frag", GL_FRAGMENT_SHADER);
+    ShaderSources::setOverrideRoot(config.shaderSources.overrideRoot);
+    ShaderBinaryCache shaderCache {config.shaderCache};
+
+    // Flat-color fallback, drawn until the real program finishes building
+    const ShaderStage fallbackVert("shaders/basic.vert", GL_VERTEX_SHADER);
+    const ShaderStage fallbackFrag("shaders/fallback.frag", GL_FRAGMENT_SHADER);
 
-    ShaderProgram program;
-    program.attach(vert);
-    program.attach(frag);
+    ShaderProgram fallback;
+    fallback.attach(fallbackVert);
+    fallback.attach(fallbackFrag);
 
-    if (!program.link())
+    if (!fallback.link(&shaderCache))
     {
         return -1;
     }
 
+    // Pay each program's deferred code generation off-screen instead of on its first frame
+    ShaderWarmup shaderWarmup;
+    shaderWarmup.add(fallback, "fallback");
+    shaderWarmup.run();
+
+    const std::vector<ShaderStageDesc> basicStages = {
+        {"shaders/basic.vert", GL_VERTEX_SHADER},
+        {"shaders/basic.frag", GL_FRAGMENT_SHADER},
+    };
+
+    ShaderCompiler shaderCompiler {2, &shaderCache};
+    ShaderCompiler::Handle pendingProgram = shaderCompiler.submit(basicStages);
+    std::optional<ShaderProgram> program;
+
+    // Edits under the override root are rebuilt in the background and swapped in between frames. Without one,
+    // every stage comes from the embedded table and there is nothing on disk to watch
+    std::optional<ShaderHotReloader> shaderReloader;
+    if (!ShaderSources::getOverrideRoot().empty())
+    {
+        shaderReloader.emplace(shaderCompiler, ShaderSources::diskPath("shaders"));
+    }
+    else
+    {
+        std::cout << "[main] shader hot reload off: no override root (Debug builds and "
+                     "-DLEARNOPENGL_SHADER_OVERRIDE=ON set one)\n";
+    }
+
+    // Sorted and recorded on a worker without GL calls, then replayed on this (the context) thread
+    Core::JobSystem jobs {config.jobs};
+    RenderQueue     renderQueue;
+    CommandBuffer   frameCommands;
+
     // === Render loop ===
     while (!window.shouldClose())
     {
         input_handler.pollHeld();
+        ShaderProgram::resetFrameUniformStats();
 
         glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        program.bind();
-        glBindVertexArray(VAO);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        uploads.update();
+        shaderCompiler.update();
+        if (shaderReloader)
+        {
+            shaderReloader->update();
+        }
+        if (!program && pendingProgram.poll() == ShaderCompiler::Status::Ready)
+        {
+            program = pendingProgram.take();
+            if (shaderReloader)
+            {
+                shaderReloader->watch(*program, basicStages);
+            }
+            shaderWarmup.add(*program, "basic");
+            shaderWarmup.run();
+        }
+
+        // Recorded in any order; record() sorts by program, material and depth
+        const ShaderProgram& activeProgram = program ? *program : fallback;
+        renderQueue.clear();
+        renderQueue.push(RenderQueue::makeKey(0, false, activeProgram.getId(), 0, 0.0f),
+                         {&activeProgram, &geometry, quad});
+        frameCommands.reset();
+        Core::JobSystem::Counter recorded;
+        jobs.run([&] { renderQueue.record(frameCommands); }, &recorded);
+        jobs.wait(recorded);
+        CommandBuffer::execute({&frameCommands}, nullptr);
 
         window.swapBuffers();
         window.pollEvents();
     }
 
+    const ShaderBinaryCache::Stats& cacheStats = shaderCache.getStats();
+    std::cout << "[main] shader cache: " << cacheStats.hits << " hits, " << cacheStats.misses << " misses, "
+              << cacheStats.evictions << " evictions\n";
+
+    const UploadQueue::Stats uploadStats = uploads.getStats();
+    std::cout << "[main] uploads: " << uploadStats.completed << "/" << uploadStats.enqueued << " completed, "
+              << uploadStats.bytesUploaded << " bytes, " << uploadStats.budgetFrames << " frames over budget\n";
+
+    const RenderQueue::Stats queueStats = renderQueue.getStats();
+    std::cout << "[main] last frame: " << queueStats.packets << " draws, " << queueStats.programChanges
+              << " program / " << queueStats.materialChanges << " material / " << queueStats.arenaChanges
+              << " arena changes\n";
+
+    // Reset at the top of each frame, so these are the last frame's writes
+    const UniformStats& uniformStats = ShaderProgram::getFrameUniformStats();
+    std::cout << "[main] last frame uniforms: " << uniformStats.issued << " issued, " << uniformStats.skipped
+              << " skipped as unchanged\n";
+
+    const Core::JobSystem::Stats jobStats = jobs.getStats();
+    std::cout << "[main] jobs: " << jobStats.executed << " run on " << jobs.getThreadCount() << " threads, "
+              << jobStats.stolen << " stolen, " << jobStats.inlined << " inlined\n";
+
+    const Platform::GLState::Stats stateStats = Platform::glState().getStats();
+    std::cout << "[main] GL state: " << stateStats.issued << " calls issued, " << stateStats.filtered
+              << " filtered as redundant\n";
+
+    const GeometryArena::Stats geometryStats = geometry.getStats();
+    std::cout << "[main] geometry: " << geometryStats.meshes << " meshes, vertices "
+              << geometryStats.vertices.occupancy() * 100.0f << "% used / "
+              << geometryStats.vertices.fragmentation() * 100.0f << "% fragmented, indices "
+              << geometryStats.indices.occupancy() * 100.0f << "% used / "
+              << geometryStats.indices.fragmentation() * 100.0f << "% fragmented\n";
+
+    const ShaderTelemetry& telemetry = ShaderTelemetry::shared();
+    if (!config.shaderTelemetry.reportPath.empty())
+    {
+        telemetry.writeJson(config.shaderTelemetry.reportPath);
+    }
+    if (config.shaderTelemetry.slowestCount > 0)
+    {
+        telemetry.printSlowest(std::cout, config.shaderTelemetry.slowestCount);
+    }
+
     return 0;
 }
@@ -0,0 +1,313 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
+#include "core/Hash.h"
+
+namespace
+{
+    constexpr std::uint32_t kNone = 0xffffffffu;
+
+    // Forsyth's tuning constants
+    constexpr float kCacheDecayPower   = 1.5f;
+    constexpr float kLastTriangleScore = 0.75f;
+    constexpr float kValenceBoostScale = 2.0f;
+    constexpr float kValenceBoostPower = 0.5f;
+
+    float vertexScore(const int cachePosition, const std::uint32_t remainingTriangles)
+    {
+        if (remainingTriangles == 0)
+        {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            // The last triangle's vertices get a fixed score, so it is not
+            // simply repeated with a different winding
+            if (cachePosition < 3)
+            {
+                score = kLastTriangleScore;
+            }
+            else
+            {
+                const float scale = 1.0f / (MeshOptimizer::kCacheSize - 3);
+                score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, kCacheDecayPower);
+            }
+        }
+
+        // Prefer vertices with few triangles left, so isolated ones are not stranded
+        return score + kValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -kValenceBoostPower);
+    }
+
+    void sequentialIndices(std::vector<std::uint32_t>& indices, const std::size_t vertexCount)
+    {
+        if (indices.empty())
+        {
+            indices.resize(vertexCount);
+            std::iota(indices.begin(), indices.end(), 0u);
+        }
+    }
+} // namespace
+
+MeshOptimizer::Report MeshOptimizer::optimize(std::vector<std::uint32_t>& indices, void* vertices,
+                                              std::size_t& vertexCount, const std::size_t stride)
+{
+    sequentialIndices(indices, vertexCount);
+
+    Report report;
+    report.vertexCountBefore = vertexCount;
+    report.acmrBefore        = acmr(indices, vertexCount);
+
+    vertexCount = weld(indices, vertices, vertexCount, stride);
+    optimizeVertexCache(indices, vertexCount);
+    vertexCount = optimizeVertexFetch(indices, vertices, vertexCount, stride);
+
+    report.vertexCountAfter = vertexCount;
+    report.acmrAfter        = acmr(indices, vertexCount);
+    return report;
+}
+
+std::size_t MeshOptimizer::weld(std::vector<std::uint32_t>& indices, void* vertices, const std::size_t vertexCount,
+                                const std::size_t stride)
+{
+    sequentialIndices(indices, vertexCount);
+
+    auto* bytes = static_cast<unsigned char*>(vertices);
+
+    // Buckets by content hash; a bucket lists the unique vertices sharing it
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> buckets;
+    buckets.reserve(vertexCount);
+
+    std::vector<std::uint32_t> remap(vertexCount, kNone);
+    std::size_t                unique = 0;
+
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        const unsigned char*        vertex = bytes + i * stride;
+        std::vector<std::uint32_t>& bucket = buckets[Core::fnv1a(vertex, stride)];
+
+        const auto match = std::find_if(bucket.begin(), bucket.end(), [&](const std::uint32_t candidate) {
+            return std::memcmp(bytes + candidate * stride, vertex, stride) == 0;
+        });
+
+        if (match != bucket.end())
+        {
+            remap[i] = *match;
+            continue;
+        }
+
+        // unique <= i, so this only ever moves a vertex towards the front
+        if (unique != i)
+        {
+            std::memcpy(bytes + unique * stride, vertex, stride);
+        }
+        remap[i] = static_cast<std::uint32_t>(unique);
+        bucket.push_back(static_cast<std::uint32_t>(unique));
+        ++unique;
+    }
+
+    for (std::uint32_t& index : indices)
+    {
+        index = remap[index];
+    }
+    return unique;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<std::uint32_t>& indices, const std::size_t vertexCount)
+{
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    // Triangles adjacent to each vertex, as one flat array; the first
+    // remaining[v] entries of a vertex's slice are its unemitted triangles
+    std::vector<std::uint32_t> remaining(vertexCount, 0);
+    for (std::size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        ++remaining[indices[i]];
+    }
+
+    std::vector<std::uint32_t> adjacencyOffset(vertexCount + 1, 0);
+    for (std::size_t v = 0; v < vertexCount; ++v)
+    {
+        adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+    }
+
+    std::vector<std::uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<std::uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (std::size_t t = 0; t < triangleCount; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<std::uint32_t>(t);
+            }
+        }
+    }
+
+    std::vector<int>   cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v)
+    {
+        score[v] = vertexScore(-1, remaining[v]);
+    }
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool>  emitted(triangleCount, false);
+    for (std::size_t t = 0; t < triangleCount; ++t)
+    {
+        triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+    }
+
+    std::vector<std::uint32_t> output;
+    output.reserve(triangleCount * 3);
+
+    std::vector<std::uint32_t> cache;
+    std::vector<std::uint32_t> nextCache;
+    cache.reserve(kCacheSize + 3);
+    nextCache.reserve(kCacheSize + 3);
+
+    std::uint32_t best     = static_cast<std::uint32_t>(std::max_element(triangleScore.begin(), triangleScore.end()) -
+                                                    triangleScore.begin());
+    std::size_t   scanFrom = 0;
+
+    while (best != kNone)
+    {
+        emitted[best] = true;
+
+        nextCache.clear();
+        for (int k = 0; k < 3; ++k)
+        {
+            const std::uint32_t v = indices[best * 3 + k];
+            output.push_back(v);
+            nextCache.push_back(v);
+
+            // Swap the triangle out of the vertex's remaining slice
+            std::uint32_t* first = adjacency.data() + adjacencyOffset[v];
+            std::uint32_t* last  = first + remaining[v];
+            std::iter_swap(std::find(first, last, best), last - 1);
+            --remaining[v];
+        }
+
+        for (const std::uint32_t v : cache)
+        {
+            if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end())
+            {
+                nextCache.push_back(v);
+            }
+        }
+
+        // Vertices pushed past the end drop out of the cache
+        for (std::size_t i = kCacheSize; i < nextCache.size(); ++i)
+        {
+            cachePosition[nextCache[i]] = -1;
+            score[nextCache[i]]         = vertexScore(-1, remaining[nextCache[i]]);
+        }
+        nextCache.resize(std::min<std::size_t>(nextCache.size(), kCacheSize));
+
+        for (std::size_t i = 0; i < nextCache.size(); ++i)
+        {
+            cachePosition[nextCache[i]] = static_cast<int>(i);
+            score[nextCache[i]]         = vertexScore(static_cast<int>(i), remaining[nextCache[i]]);
+        }
+        std::swap(cache, nextCache);
+
+        // Only triangles around cached vertices changed score; pick the best of them
+        best             = kNone;
+        float bestScore = -1.0f;
+        for (const std::uint32_t v : cache)
+        {
+            for (std::uint32_t i = 0; i < remaining[v]; ++i)
+            {
+                const std::uint32_t t = adjacency[adjacencyOffset[v] + i];
+                triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+                if (triangleScore[t] > bestScore)
+                {
+                    bestScore = triangleScore[t];
+                    best      = t;
+                }
+            }
+        }
+
+        // Nothing left around the cache: restart from the next unemitted triangle in input order.
+        // scanFrom only moves forward, so dead ends cost O(T) in total rather than a scan each
+        if (best == kNone)
+        {
+            while (scanFrom < triangleCount && emitted[scanFrom])
+            {
+                ++scanFrom;
+            }
+            if (scanFrom < triangleCount)
+            {
+                best = static_cast<std::uint32_t>(scanFrom);
+            }
+        }
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+std::size_t MeshOptimizer::optimizeVertexFetch(std::vector<std::uint32_t>& indices, void* vertices,
+                                               const std::size_t vertexCount, const std::size_t stride)
+{
+    std::vector<std::uint32_t> remap(vertexCount, kNone);
+    std::uint32_t              next = 0;
+
+    for (std::uint32_t& index : indices)
+    {
+        if (remap[index] == kNone)
+        {
+            remap[index] = next++;
+        }
+        index = remap[index];
+    }
+
+    auto*                            bytes = static_cast<unsigned char*>(vertices);
+    const std::vector<unsigned char> original(bytes, bytes + vertexCount * stride);
+
+    for (std::size_t v = 0; v < vertexCount; ++v)
+    {
+        if (remap[v] != kNone)
+        {
+            std::memcpy(bytes + remap[v] * stride, original.data() + v * stride, stride);
+        }
+    }
+    return next;
+}
+
+float MeshOptimizer::acmr(const std::vector<std::uint32_t>& indices, const std::size_t vertexCount,
+                          const unsigned cacheSize)
+{
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+    {
+        return 0.0f;
+    }
+
+    // A vertex is cached while fewer than cacheSize misses happened since it was loaded
+    std::vector<std::uint32_t> loadedAt(vertexCount, 0);
+    std::uint32_t              misses = 0;
+
+    for (std::size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        const std::uint32_t v = indices[i];
+        if (loadedAt[v] == 0 || misses - loadedAt[v] >= cacheSize)
+        {
+            ++misses;
+            loadedAt[v] = misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
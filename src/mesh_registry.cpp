@@ -0,0 +1,220 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "mesh_registry.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "platform/GLExtensions.h"
+#include "platform/GLState.h"
+#include "shader/program.h"
+
+namespace
+{
+    // Grows by doubling, so a bucket that gains draws one by one reallocates rarely
+    void uploadGrowing(GLuint& buffer, std::size_t& capacity, const void* data, const std::size_t size,
+                       const GLenum usage)
+    {
+        if (buffer == 0)
+        {
+            glGenBuffers(1, &buffer);
+        }
+
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        if (size > capacity)
+        {
+            capacity = std::max(size, capacity * 2);
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, usage);
+        }
+        glBufferSubData(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(size), data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+} // namespace
+
+MeshRegistry::MeshRegistry(GeometryArena& arena, const std::size_t drawDataSize, const GLuint binding,
+                           const bool allowMultiDrawIndirect)
+    : m_arena(arena)
+    , m_drawDataSize(drawDataSize)
+    , m_dataStride(drawDataSize)
+    , m_binding(binding)
+    , m_multiDrawIndirect(allowMultiDrawIndirect && Platform::glExtensions().multiDrawIndirect)
+{
+    if (drawDataSize == 0 || drawDataSize % 16 != 0)
+    {
+        throw std::logic_error("MeshRegistry: per-draw records must be a non-zero multiple of 16 bytes, got " +
+                               std::to_string(drawDataSize));
+    }
+
+    if (!m_multiDrawIndirect)
+    {
+        GLint alignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        const auto align = static_cast<std::size_t>(std::max(alignment, 1));
+        m_dataStride     = (drawDataSize + align - 1) / align * align;
+
+        ShaderProgram::registerBlockBinding(kBlockName, binding);
+    }
+}
+
+MeshRegistry::~MeshRegistry()
+{
+    for (const auto& [id, bucket] : m_buckets)
+    {
+        if (bucket.commandBuffer != 0)
+        {
+            Platform::glState().forgetBuffer(bucket.commandBuffer);
+            glDeleteBuffers(1, &bucket.commandBuffer);
+        }
+        if (bucket.dataBuffer != 0)
+        {
+            Platform::glState().forgetBuffer(bucket.dataBuffer);
+            glDeleteBuffers(1, &bucket.dataBuffer);
+        }
+    }
+}
+
+MeshRegistry::Handle MeshRegistry::add(const GeometryArena::Mesh& mesh, const std::uint32_t bucketId,
+                                       const void* drawData, const GLuint instanceCount)
+{
+    Bucket& bucket = m_buckets[bucketId];
+
+    Handle handle;
+    if (!m_freeHandles.empty())
+    {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else
+    {
+        handle = static_cast<Handle>(m_handles.size());
+        m_handles.emplace_back();
+    }
+
+    const auto index  = static_cast<std::uint32_t>(bucket.commands.size());
+    m_handles[handle] = {bucketId, index};
+
+    bucket.commands.push_back({static_cast<GLuint>(mesh.indexCount), instanceCount, mesh.firstIndex,
+                               mesh.baseVertex, 0});
+    bucket.owners.push_back(handle);
+    bucket.data.resize(bucket.data.size() + m_dataStride);
+    std::memcpy(bucket.data.data() + index * m_dataStride, drawData, m_drawDataSize);
+    bucket.dirty = true;
+    return handle;
+}
+
+const MeshRegistry::Location& MeshRegistry::locate(const Handle handle) const
+{
+    // A stale handle's slot may hold another mesh's draw by now; touching it would corrupt that draw
+    if (handle >= m_handles.size() || m_handles[handle].index == kRemoved)
+    {
+        throw std::logic_error("MeshRegistry: handle " + std::to_string(handle) + " is not registered");
+    }
+    return m_handles[handle];
+}
+
+void MeshRegistry::update(const Handle handle, const void* drawData)
+{
+    const Location location = locate(handle);
+    Bucket&        bucket   = m_buckets[location.bucket];
+    std::memcpy(bucket.data.data() + location.index * m_dataStride, drawData, m_drawDataSize);
+    bucket.dirty = true;
+}
+
+void MeshRegistry::remove(const Handle handle)
+{
+    const Location      location = locate(handle);
+    Bucket&             bucket   = m_buckets[location.bucket];
+    const std::uint32_t last     = static_cast<std::uint32_t>(bucket.commands.size()) - 1;
+
+    // Move the last draw into the hole so the bucket stays dense
+    if (location.index != last)
+    {
+        bucket.commands[location.index] = bucket.commands[last];
+        bucket.owners[location.index]   = bucket.owners[last];
+        std::memcpy(bucket.data.data() + location.index * m_dataStride, bucket.data.data() + last * m_dataStride,
+                    m_dataStride);
+        m_handles[bucket.owners[location.index]].index = location.index;
+    }
+
+    bucket.commands.pop_back();
+    bucket.owners.pop_back();
+    bucket.data.resize(bucket.data.size() - m_dataStride);
+    bucket.dirty = true;
+
+    m_handles[handle].index = kRemoved;
+    m_freeHandles.push_back(handle);
+}
+
+void MeshRegistry::render(const std::uint32_t bucketId)
+{
+    const auto it = m_buckets.find(bucketId);
+    if (it == m_buckets.end() || it->second.commands.empty())
+    {
+        return;
+    }
+
+    Bucket& bucket = it->second;
+    if (bucket.dirty)
+    {
+        upload(bucket);
+    }
+
+    m_arena.bind();
+    const GLenum indexType = m_arena.getIndexType();
+    const auto   drawCount = static_cast<GLsizei>(bucket.commands.size());
+
+    if (m_multiDrawIndirect)
+    {
+        Platform::GLState& state = Platform::glState();
+        state.bindBufferBase(GL_SHADER_STORAGE_BUFFER, m_binding, bucket.dataBuffer);
+        state.bindBuffer(GL_DRAW_INDIRECT_BUFFER, bucket.commandBuffer);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, nullptr, drawCount,
+                                    sizeof(DrawElementsIndirectCommand));
+
+        m_stats.draws += static_cast<std::uint32_t>(drawCount);
+        ++m_stats.submissions;
+        return;
+    }
+
+    const auto indexSize = static_cast<GLintptr>(m_arena.getIndexSize());
+    for (GLsizei i = 0; i < drawCount; ++i)
+    {
+        const DrawElementsIndirectCommand& command = bucket.commands[static_cast<std::size_t>(i)];
+        const auto* indices = reinterpret_cast<const void*>(static_cast<GLintptr>(command.firstIndex) * indexSize);
+
+        Platform::glState().bindBufferRange(GL_UNIFORM_BUFFER, m_binding, bucket.dataBuffer,
+                                            static_cast<GLintptr>(static_cast<std::size_t>(i) * m_dataStride),
+                                            static_cast<GLsizeiptr>(m_drawDataSize));
+
+        if (command.instanceCount == 1)
+        {
+            glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(command.count), indexType, indices,
+                                     command.baseVertex);
+        }
+        else
+        {
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(command.count), indexType, indices,
+                                              static_cast<GLsizei>(command.instanceCount), command.baseVertex);
+        }
+    }
+
+    m_stats.draws += static_cast<std::uint32_t>(drawCount);
+    m_stats.submissions += static_cast<std::uint32_t>(drawCount);
+}
+
+void MeshRegistry::upload(Bucket& bucket)
+{
+    if (m_multiDrawIndirect)
+    {
+        uploadGrowing(bucket.commandBuffer, bucket.commandCapacity, bucket.commands.data(),
+                      bucket.commands.size() * sizeof(DrawElementsIndirectCommand), GL_DYNAMIC_DRAW);
+    }
+    uploadGrowing(bucket.dataBuffer, bucket.dataCapacity, bucket.data.data(), bucket.data.size(), GL_DYNAMIC_DRAW);
+
+    bucket.dirty = false;
+    ++m_stats.uploads;
+}
@@ -0,0 +1,98 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "platform/GLExtensions.h"
+
+#include <string>
+#include <unordered_set>
+
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glad_glMaxShaderCompilerThreadsKHR = nullptr;
+PFNGLBUFFERSTORAGEPROC               glad_glBufferStorage               = nullptr;
+PFNGLCREATEVERTEXARRAYSPROC          glad_glCreateVertexArrays          = nullptr;
+PFNGLENABLEVERTEXARRAYATTRIBPROC     glad_glEnableVertexArrayAttrib     = nullptr;
+PFNGLVERTEXARRAYATTRIBFORMATPROC     glad_glVertexArrayAttribFormat     = nullptr;
+PFNGLVERTEXARRAYATTRIBBINDINGPROC    glad_glVertexArrayAttribBinding    = nullptr;
+PFNGLVERTEXARRAYVERTEXBUFFERPROC     glad_glVertexArrayVertexBuffer     = nullptr;
+PFNGLVERTEXARRAYELEMENTBUFFERPROC    glad_glVertexArrayElementBuffer    = nullptr;
+PFNGLVERTEXARRAYBINDINGDIVISORPROC   glad_glVertexArrayBindingDivisor   = nullptr;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC   glad_glMultiDrawElementsIndirect   = nullptr;
+
+namespace Platform
+{
+    namespace
+    {
+        GLExtensions                    s_extensions;
+        std::unordered_set<std::string> s_names;
+
+        template <typename Proc>
+        bool loadProc(GLADloadproc load, Proc& proc, const char* name)
+        {
+            proc = reinterpret_cast<Proc>(load(name));
+            return proc != nullptr;
+        }
+    } // namespace
+
+    bool loadGLExtensions(GLADloadproc load)
+    {
+        s_extensions = {};
+        s_names.clear();
+
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            if (const auto* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i))))
+            {
+                s_names.emplace(name);
+            }
+        }
+
+        if (hasGLExtension("GL_KHR_parallel_shader_compile"))
+        {
+            s_extensions.parallelShaderCompile =
+                loadProc(load, glad_glMaxShaderCompilerThreadsKHR, "glMaxShaderCompilerThreadsKHR");
+        }
+        else if (hasGLExtension("GL_ARB_parallel_shader_compile"))
+        {
+            s_extensions.parallelShaderCompile =
+                loadProc(load, glad_glMaxShaderCompilerThreadsKHR, "glMaxShaderCompilerThreadsARB");
+        }
+
+        if (hasGLExtension("GL_ARB_buffer_storage"))
+        {
+            s_extensions.bufferStorage = loadProc(load, glad_glBufferStorage, "glBufferStorage");
+        }
+
+        if (hasGLExtension("GL_ARB_direct_state_access") && hasGLExtension("GL_ARB_vertex_attrib_binding"))
+        {
+            s_extensions.directStateAccess =
+                loadProc(load, glad_glCreateVertexArrays, "glCreateVertexArrays") &&
+                loadProc(load, glad_glEnableVertexArrayAttrib, "glEnableVertexArrayAttrib") &&
+                loadProc(load, glad_glVertexArrayAttribFormat, "glVertexArrayAttribFormat") &&
+                loadProc(load, glad_glVertexArrayAttribBinding, "glVertexArrayAttribBinding") &&
+                loadProc(load, glad_glVertexArrayVertexBuffer, "glVertexArrayVertexBuffer") &&
+                loadProc(load, glad_glVertexArrayElementBuffer, "glVertexArrayElementBuffer") &&
+                loadProc(load, glad_glVertexArrayBindingDivisor, "glVertexArrayBindingDivisor");
+        }
+
+        if (hasGLExtension("GL_ARB_multi_draw_indirect") && hasGLExtension("GL_ARB_shader_storage_buffer_object") &&
+            hasGLExtension("GL_ARB_shader_draw_parameters"))
+        {
+            s_extensions.multiDrawIndirect =
+                loadProc(load, glad_glMultiDrawElementsIndirect, "glMultiDrawElementsIndirect");
+        }
+
+        return count > 0;
+    }
+
+    const GLExtensions& glExtensions()
+    {
+        return s_extensions;
+    }
+
+    bool hasGLExtension(const std::string_view name)
+    {
+        return s_names.contains(std::string(name));
+    }
+} // namespace Platform
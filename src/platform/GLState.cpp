@@ -0,0 +1,354 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "platform/GLState.h"
+
+#include "platform/GLExtensions.h"
+
+namespace Platform
+{
+    GLState::GLState()
+    {
+        invalidate();
+    }
+
+    void GLState::useProgram(const GLuint program)
+    {
+        if (update(m_program, program))
+        {
+            glUseProgram(program);
+        }
+    }
+
+    void GLState::bindProgramPipeline(const GLuint pipeline)
+    {
+        if (update(m_pipeline, pipeline))
+        {
+            glBindProgramPipeline(pipeline);
+        }
+    }
+
+    void GLState::bindVertexArray(const GLuint vertexArray)
+    {
+        if (update(m_vertexArray, vertexArray))
+        {
+            glBindVertexArray(vertexArray);
+            m_buffers[bufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = kUnknown;
+        }
+    }
+
+    void GLState::bindBuffer(const GLenum target, const GLuint buffer)
+    {
+        const int slot = bufferSlot(target);
+        if (slot < 0 || update(m_buffers[slot], buffer))
+        {
+            if (slot < 0)
+            {
+                ++m_stats.issued;
+            }
+            glBindBuffer(target, buffer);
+        }
+    }
+
+    void GLState::bindBufferBase(const GLenum target, const GLuint index, const GLuint buffer)
+    {
+        bindBufferRange(target, index, buffer, 0, 0);
+    }
+
+    void GLState::bindBufferRange(const GLenum target, const GLuint index, const GLuint buffer,
+                                  const GLintptr offset, const GLsizeiptr size)
+    {
+        IndexedBindings* bindings = indexedBindings(target);
+        if (bindings && index < kMaxIndexedBindings)
+        {
+            IndexedBinding& binding = (*bindings)[index];
+            if (binding.buffer == buffer && binding.offset == offset && binding.size == size)
+            {
+                ++m_stats.filtered;
+                return;
+            }
+            binding = {buffer, offset, size};
+        }
+
+        ++m_stats.issued;
+        if (size == 0)
+        {
+            glBindBufferBase(target, index, buffer);
+        }
+        else
+        {
+            glBindBufferRange(target, index, buffer, offset, size);
+        }
+
+        if (const int slot = bufferSlot(target); slot >= 0)
+        {
+            m_buffers[slot] = buffer;
+        }
+    }
+
+    void GLState::bindTexture(const GLuint unit, const GLenum target, const GLuint texture)
+    {
+        const int slot = textureSlot(target);
+        if (unit >= kMaxTextureUnits || slot < 0)
+        {
+            activeTexture(unit);
+            ++m_stats.issued;
+            glBindTexture(target, texture);
+            return;
+        }
+
+        if (update(m_textures[unit][slot], texture))
+        {
+            activeTexture(unit);
+            glBindTexture(target, texture);
+        }
+    }
+
+    void GLState::bindSampler(const GLuint unit, const GLuint sampler)
+    {
+        if (unit >= kMaxTextureUnits || update(m_samplers[unit], sampler))
+        {
+            if (unit >= kMaxTextureUnits)
+            {
+                ++m_stats.issued;
+            }
+            glBindSampler(unit, sampler);
+        }
+    }
+
+    void GLState::setBlend(const bool enabled)
+    {
+        setCapability(m_blend, GL_BLEND, enabled);
+    }
+
+    void GLState::setBlendFunc(const GLenum source, const GLenum destination)
+    {
+        if (m_blendFunc[0] == source && m_blendFunc[1] == destination)
+        {
+            ++m_stats.filtered;
+            return;
+        }
+        m_blendFunc = {source, destination};
+        ++m_stats.issued;
+        glBlendFunc(source, destination);
+    }
+
+    void GLState::setDepthTest(const bool enabled)
+    {
+        setCapability(m_depthTest, GL_DEPTH_TEST, enabled);
+    }
+
+    void GLState::setDepthWrite(const bool enabled)
+    {
+        if (update(m_depthWrite, enabled ? 1u : 0u))
+        {
+            glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+        }
+    }
+
+    void GLState::setDepthFunc(const GLenum func)
+    {
+        if (update(m_depthFunc, func))
+        {
+            glDepthFunc(func);
+        }
+    }
+
+    void GLState::setCullFace(const bool enabled)
+    {
+        setCapability(m_cullFace, GL_CULL_FACE, enabled);
+    }
+
+    void GLState::setCullMode(const GLenum face)
+    {
+        if (update(m_cullMode, face))
+        {
+            glCullFace(face);
+        }
+    }
+
+    void GLState::setViewport(const GLint x, const GLint y, const GLsizei width, const GLsizei height)
+    {
+        const std::array<GLint, 4> viewport = {x, y, width, height};
+        if (m_viewportKnown && m_viewport == viewport)
+        {
+            ++m_stats.filtered;
+            return;
+        }
+        m_viewport = viewport;
+        m_viewportKnown = true;
+        ++m_stats.issued;
+        glViewport(x, y, width, height);
+    }
+
+    void GLState::forgetBuffer(const GLuint buffer)
+    {
+        for (GLuint& bound : m_buffers)
+        {
+            if (bound == buffer)
+            {
+                bound = 0;
+            }
+        }
+        for (IndexedBindings* bindings : {&m_uniformBindings, &m_storageBindings})
+        {
+            for (IndexedBinding& binding : *bindings)
+            {
+                if (binding.buffer == buffer)
+                {
+                    binding = {0, 0, 0};
+                }
+            }
+        }
+    }
+
+    void GLState::forgetVertexArray(const GLuint vertexArray)
+    {
+        if (m_vertexArray == vertexArray)
+        {
+            m_vertexArray = 0;
+            m_buffers[bufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = kUnknown;
+        }
+    }
+
+    void GLState::forgetProgram(const GLuint program)
+    {
+        // A deleted program stays in use until replaced, but its name may be
+        // recycled before that
+        if (m_program == program)
+        {
+            m_program = kUnknown;
+        }
+    }
+
+    void GLState::forgetPipeline(const GLuint pipeline)
+    {
+        if (m_pipeline == pipeline)
+        {
+            m_pipeline = 0;
+        }
+    }
+
+    void GLState::forgetTexture(const GLuint texture)
+    {
+        for (auto& unit : m_textures)
+        {
+            for (GLuint& bound : unit)
+            {
+                if (bound == texture)
+                {
+                    bound = 0;
+                }
+            }
+        }
+    }
+
+    void GLState::forgetSampler(const GLuint sampler)
+    {
+        for (GLuint& bound : m_samplers)
+        {
+            if (bound == sampler)
+            {
+                bound = 0;
+            }
+        }
+    }
+
+    void GLState::invalidate()
+    {
+        m_program = kUnknown;
+        m_pipeline = kUnknown;
+        m_vertexArray = kUnknown;
+        m_activeUnit = kUnknown;
+
+        m_buffers.fill(kUnknown);
+        m_uniformBindings.fill({});
+        m_storageBindings.fill({});
+        for (auto& unit : m_textures)
+        {
+            unit.fill(kUnknown);
+        }
+        m_samplers.fill(kUnknown);
+
+        m_blend = kUnknown;
+        m_blendFunc = {kUnknown, kUnknown};
+        m_depthTest = kUnknown;
+        m_depthWrite = kUnknown;
+        m_depthFunc = kUnknown;
+        m_cullFace = kUnknown;
+        m_cullMode = kUnknown;
+        m_viewport = {};
+        m_viewportKnown = false;
+    }
+
+    bool GLState::update(GLuint& slot, const GLuint value)
+    {
+        if (slot == value)
+        {
+            ++m_stats.filtered;
+            return false;
+        }
+        slot = value;
+        ++m_stats.issued;
+        return true;
+    }
+
+    void GLState::setCapability(GLuint& slot, const GLenum capability, const bool enabled)
+    {
+        if (update(slot, enabled ? 1u : 0u))
+        {
+            enabled ? glEnable(capability) : glDisable(capability);
+        }
+    }
+
+    void GLState::activeTexture(const GLuint unit)
+    {
+        if (update(m_activeUnit, unit))
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+        }
+    }
+
+    int GLState::bufferSlot(const GLenum target)
+    {
+        switch (target)
+        {
+            case GL_ARRAY_BUFFER: return 0;
+            case GL_ELEMENT_ARRAY_BUFFER: return 1;
+            case GL_UNIFORM_BUFFER: return 2;
+            case GL_DRAW_INDIRECT_BUFFER: return 3;
+            case GL_SHADER_STORAGE_BUFFER: return 4;
+            default: return -1;
+        }
+    }
+
+    int GLState::textureSlot(const GLenum target)
+    {
+        switch (target)
+        {
+            case GL_TEXTURE_2D: return 0;
+            case GL_TEXTURE_2D_ARRAY: return 1;
+            case GL_TEXTURE_3D: return 2;
+            case GL_TEXTURE_CUBE_MAP: return 3;
+            case GL_TEXTURE_BUFFER: return 4;
+            default: return -1;
+        }
+    }
+
+    GLState::IndexedBindings* GLState::indexedBindings(const GLenum target)
+    {
+        switch (target)
+        {
+            case GL_UNIFORM_BUFFER: return &m_uniformBindings;
+            case GL_SHADER_STORAGE_BUFFER: return &m_storageBindings;
+            default: return nullptr;
+        }
+    }
+
+    GLState& glState()
+    {
+        thread_local GLState state;
+        return state;
+    }
+} // namespace Platform
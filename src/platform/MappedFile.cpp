@@ -0,0 +1,127 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "platform/MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace Platform
+{
+    MappedFile::MappedFile(const std::filesystem::path& path)
+        : m_data(nullptr)
+        , m_size(0)
+        , m_open(false)
+    {
+#ifdef _WIN32
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+
+        LARGE_INTEGER size {};
+        if (GetFileSizeEx(file, &size))
+        {
+            m_size = static_cast<std::size_t>(size.QuadPart);
+            m_open = true;
+
+            // Zero-length files cannot be mapped; they are simply empty
+            if (m_size > 0)
+            {
+                const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping)
+                {
+                    m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                    CloseHandle(mapping);
+                }
+                m_open = m_data != nullptr;
+            }
+        }
+        CloseHandle(file);
+#else
+        const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+        {
+            return;
+        }
+
+        struct stat info {};
+        if (fstat(file, &info) == 0)
+        {
+            m_size = static_cast<std::size_t>(info.st_size);
+            m_open = true;
+
+            // Zero-length files cannot be mapped; they are simply empty
+            if (m_size > 0)
+            {
+                void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+                m_data     = data == MAP_FAILED ? nullptr : static_cast<const char*>(data);
+                m_open     = m_data != nullptr;
+            }
+        }
+        close(file);
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+        release();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_open(std::exchange(other.m_open, false))
+    {}
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_open = std::exchange(other.m_open, false);
+        }
+        return *this;
+    }
+
+    bool MappedFile::isOpen() const
+    {
+        return m_open;
+    }
+
+    std::string_view MappedFile::view() const
+    {
+        return m_data ? std::string_view(m_data, m_size) : std::string_view();
+    }
+
+    void MappedFile::release()
+    {
+        if (m_data)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(m_data);
+#else
+            munmap(const_cast<char*>(m_data), m_size);
+#endif
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_open = false;
+    }
+} // namespace Platform
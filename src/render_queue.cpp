@@ -0,0 +1,198 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "render_queue.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+
+#include "command_buffer.h"
+#include "shader/program.h"
+
+namespace
+{
+    constexpr unsigned      kRadixBits = 8;
+    constexpr unsigned      kDigits    = 64 / kRadixBits;
+    constexpr std::size_t   kBuckets   = std::size_t {1} << kRadixBits;
+    constexpr std::uint64_t kStateMask = (std::uint64_t {1} << RenderQueue::kStateBits) - 1;
+    constexpr std::uint64_t kDepthMask = (std::uint64_t {1} << RenderQueue::kDepthBits) - 1;
+
+    // Below this a comparison sort beats eight histogram passes. It must be
+    // stable like the radix sort, so equal keys keep submission order at any size
+    constexpr std::size_t kRadixThreshold = 64;
+
+    // Field positions, counted from bit 0
+    constexpr unsigned kReservedBits     = 3;
+    constexpr unsigned kPassShift        = 64 - RenderQueue::kPassBits;
+    constexpr unsigned kTranslucentShift = kPassShift - 1;
+} // namespace
+
+std::uint64_t RenderQueue::makeKey(const unsigned pass, const bool translucent, const std::uint32_t program,
+                                   const std::uint32_t material, const float depth)
+{
+    if (pass >= kMaxPasses)
+    {
+        throw std::logic_error("RenderQueue::makeKey(): pass " + std::to_string(pass) + " is out of range");
+    }
+
+    const float clamped = std::clamp(depth, 0.0f, 1.0f);
+    const auto  quantized = static_cast<std::uint64_t>(clamped * static_cast<float>(kDepthMask)) & kDepthMask;
+
+    std::uint64_t key = static_cast<std::uint64_t>(pass) << kPassShift;
+    if (!translucent)
+    {
+        key |= (program & kStateMask) << (kReservedBits + kDepthBits + kStateBits);
+        key |= (material & kStateMask) << (kReservedBits + kDepthBits);
+        key |= quantized << kReservedBits;
+        return key;
+    }
+
+    key |= std::uint64_t {1} << kTranslucentShift;
+    key |= (kDepthMask - quantized) << (kReservedBits + 2 * kStateBits);
+    key |= (program & kStateMask) << (kReservedBits + kStateBits);
+    key |= (material & kStateMask) << kReservedBits;
+    return key;
+}
+
+void RenderQueue::push(const std::uint64_t key, const DrawPacket& packet)
+{
+    m_items.push_back({key, static_cast<std::uint32_t>(m_packets.size())});
+    m_packets.push_back(packet);
+}
+
+void RenderQueue::submit(const MaterialBinder& bindMaterial)
+{
+    walk([](const ShaderProgram& program) { program.bind(); },
+         [](const GeometryArena& arena) { arena.bind(); },
+         [&](const std::uint32_t material)
+         {
+             if (bindMaterial)
+             {
+                 bindMaterial(material);
+             }
+         },
+         [](const GeometryArena& arena, const DrawPacket& packet) { arena.draw(packet.mesh, packet.mode); });
+}
+
+void RenderQueue::record(CommandBuffer& commands, const MaterialRecorder& recordMaterial)
+{
+    walk([&](const ShaderProgram& program) { commands.bindProgram(program); },
+         [&](const GeometryArena& arena) { commands.bindGeometry(arena); },
+         [&](const std::uint32_t material)
+         {
+             if (recordMaterial)
+             {
+                 recordMaterial(commands, material);
+             }
+         },
+         [&](const GeometryArena&, const DrawPacket& packet) { commands.draw(packet.mesh, packet.mode); });
+}
+
+template <typename BindProgram, typename BindArena, typename BindMaterial, typename Draw>
+void RenderQueue::walk(BindProgram&& bindProgram, BindArena&& bindArena, BindMaterial&& bindMaterial, Draw&& draw)
+{
+    m_stats = {};
+    m_stats.packets = static_cast<std::uint32_t>(m_items.size());
+    sort();
+
+    const ShaderProgram* program = nullptr;
+    const GeometryArena* arena = nullptr;
+    bool                 hasMaterial = false;
+    std::uint32_t        material = 0;
+
+    for (const Item& item : m_items)
+    {
+        const DrawPacket& packet = m_packets[item.packet];
+        if (!packet.program || !packet.arena || !packet.mesh.isValid())
+        {
+            continue;
+        }
+
+        if (packet.program != program)
+        {
+            bindProgram(*packet.program);
+            program = packet.program;
+            ++m_stats.programChanges;
+        }
+        if (packet.arena != arena)
+        {
+            bindArena(*packet.arena);
+            arena = packet.arena;
+            ++m_stats.arenaChanges;
+        }
+        if (!hasMaterial || packet.material != material)
+        {
+            bindMaterial(packet.material);
+            hasMaterial = true;
+            material = packet.material;
+            ++m_stats.materialChanges;
+        }
+
+        draw(*arena, packet);
+    }
+}
+
+void RenderQueue::clear()
+{
+    m_items.clear();
+    m_packets.clear();
+}
+
+void RenderQueue::sort()
+{
+    const std::size_t count = m_items.size();
+    if (count < kRadixThreshold)
+    {
+        std::stable_sort(m_items.begin(), m_items.end(), [](const Item& a, const Item& b) { return a.key < b.key; });
+        return;
+    }
+
+    // One read of the keys fills the histograms of every digit
+    std::array<std::array<std::uint32_t, kBuckets>, kDigits> histograms {};
+    for (const Item& item : m_items)
+    {
+        for (unsigned digit = 0; digit < kDigits; ++digit)
+        {
+            ++histograms[digit][(item.key >> (digit * kRadixBits)) & (kBuckets - 1)];
+        }
+    }
+
+    m_scratch.resize(count);
+    Item* source = m_items.data();
+    Item* target = m_scratch.data();
+
+    for (unsigned digit = 0; digit < kDigits; ++digit)
+    {
+        std::array<std::uint32_t, kBuckets>& histogram = histograms[digit];
+        const unsigned shift = digit * kRadixBits;
+
+        // Every key has the same value here; scattering would not move anything
+        if (histogram[(source[0].key >> shift) & (kBuckets - 1)] == count)
+        {
+            continue;
+        }
+
+        std::uint32_t offset = 0;
+        for (std::uint32_t& bucket : histogram)
+        {
+            const std::uint32_t size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            target[histogram[(source[i].key >> shift) & (kBuckets - 1)]++] = source[i];
+        }
+        std::swap(source, target);
+        ++m_stats.sortPasses;
+    }
+
+    if (source != m_items.data())
+    {
+        m_items.swap(m_scratch);
+    }
+}
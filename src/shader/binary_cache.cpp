@@ -0,0 +1,255 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "shader/binary_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "core/Hash.h"
+#include "shader/stage.h"
+
+namespace
+{
+    constexpr std::uint32_t kMagic = 0x42474F4C; // "LOGB"
+    constexpr std::uint32_t kFormatVersion = 1;
+
+    struct EntryHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t binaryFormat;
+        std::uint32_t length;
+    };
+
+    std::string glString(const GLenum name)
+    {
+        const auto* value = reinterpret_cast<const char*>(glGetString(name));
+        return value ? value : "";
+    }
+} // namespace
+
+ShaderBinaryCache::ShaderBinaryCache(const Core::ShaderCacheConfig& config)
+    : m_directory(config.directory)
+    , m_maxBytes(config.maxBytes)
+    , m_supported(-1)
+{}
+
+std::uint64_t ShaderBinaryCache::makeKey(const std::vector<const ShaderStage*>& stages, const bool separable)
+{
+    if (m_deviceId.empty())
+    {
+        m_deviceId = glString(GL_RENDERER) + "|" + glString(GL_VERSION);
+    }
+
+    std::uint64_t key = Core::fnv1a(m_deviceId);
+    key = Core::fnv1a(std::string_view(separable ? "separable" : "monolithic"), key);
+    for (const ShaderStage* stage : stages)
+    {
+        const GLenum type = stage->getType();
+        key = Core::fnv1a(&type, sizeof(type), key);
+        for (const std::string& define : stage->getDefines())
+        {
+            key = Core::fnv1a(define, key);
+            key = Core::fnv1a(std::string_view("\n"), key);
+        }
+        key = Core::fnv1a(stage->getSource(), key);
+    }
+    return key;
+}
+
+bool ShaderBinaryCache::load(const std::uint64_t key, const GLuint program)
+{
+    if (!isEnabled())
+    {
+        ++m_stats.misses;
+        return false;
+    }
+
+    const std::filesystem::path path = entryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        ++m_stats.misses;
+        return false;
+    }
+
+    std::error_code      sizeError;
+    const std::uintmax_t fileSize = std::filesystem::file_size(path, sizeError);
+
+    EntryHeader header {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    // store() writes the header and exactly header.length bytes, so a length that disagrees with the file
+    // size marks a truncated or corrupt entry; never let it size the allocation
+    std::vector<char> binary;
+    if (file && !sizeError && header.magic == kMagic && header.version == kFormatVersion && header.length > 0 &&
+        header.length == fileSize - sizeof(header))
+    {
+        binary.resize(header.length);
+        file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+        if (file.gcount() != static_cast<std::streamsize>(binary.size()))
+        {
+            binary.clear();
+        }
+    }
+    file.close();
+
+    if (binary.empty())
+    {
+        ++m_stats.misses;
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return false;
+    }
+
+    glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    int success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        // The driver may reject binaries from an older build of itself even
+        // when the version string matches; drop the entry and recompile.
+        ++m_stats.rejected;
+        ++m_stats.misses;
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return false;
+    }
+
+    ++m_stats.hits;
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+void ShaderBinaryCache::store(const std::uint64_t key, const GLuint program)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum binaryFormat = GL_NONE;
+    glGetProgramBinary(program, length, nullptr, &binaryFormat, binary.data());
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+    if (ec)
+    {
+        std::cerr << "[ShaderBinaryCache] cannot create " << m_directory << ": " << ec.message() << std::endl;
+        return;
+    }
+
+    // Write to a temporary name first so a crash never leaves a truncated entry
+    const std::filesystem::path path = entryPath(key);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        const EntryHeader header {kMagic, kFormatVersion, binaryFormat, static_cast<std::uint32_t>(length)};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), length);
+        if (!file)
+        {
+            std::cerr << "[ShaderBinaryCache] failed to write " << temporary << std::endl;
+            std::filesystem::remove(temporary, ec);
+            return;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temporary, ec);
+        return;
+    }
+
+    ++m_stats.stores;
+    evict();
+}
+
+bool ShaderBinaryCache::isEnabled()
+{
+    if (m_supported < 0)
+    {
+        GLint formats = 0;
+        if (GLAD_GL_VERSION_4_1)
+        {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        }
+        m_supported = formats > 0 ? 1 : 0;
+    }
+    return m_supported == 1 && !m_directory.empty();
+}
+
+const ShaderBinaryCache::Stats& ShaderBinaryCache::getStats() const
+{
+    return m_stats;
+}
+
+std::filesystem::path ShaderBinaryCache::entryPath(const std::uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return m_directory / name;
+}
+
+void ShaderBinaryCache::evict()
+{
+    struct Entry
+    {
+        std::filesystem::path           path;
+        std::filesystem::file_time_type lastUsed;
+        std::uintmax_t                  size;
+    };
+
+    std::vector<Entry> entries;
+    std::uintmax_t     total = 0;
+
+    std::error_code ec;
+    for (const auto& item : std::filesystem::directory_iterator(m_directory, ec))
+    {
+        if (!item.is_regular_file(ec) || item.path().extension() != ".bin")
+        {
+            continue;
+        }
+        Entry entry {item.path(), item.last_write_time(ec), item.file_size(ec)};
+        total += entry.size;
+        entries.push_back(std::move(entry));
+    }
+
+    if (total <= m_maxBytes)
+    {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+
+    for (const Entry& entry : entries)
+    {
+        if (total <= m_maxBytes)
+        {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, ec))
+        {
+            total -= entry.size;
+            ++m_stats.evictions;
+        }
+    }
+}
@@ -0,0 +1,259 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "shader/compiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+
+#include "core/Hash.h"
+#include "platform/GLExtensions.h"
+#include "shader/program.h"
+#include "shader/stage.h"
+
+struct ShaderCompiler::Job
+{
+    std::vector<ShaderStageDesc> descs;
+    bool                         separable = false;
+
+    // Written by the worker, read by the context thread once loaded is set
+    std::vector<std::string> sources;
+    std::string              error;
+    std::atomic<bool>        loaded {false};
+
+    // Context thread only
+    Status                       status      = Status::Loading;
+    bool                         waitedFrame = false;
+    std::vector<std::shared_ptr<const ShaderStage>> stages;
+    std::optional<ShaderProgram> program;
+};
+
+ShaderCompiler::Handle::Handle(std::shared_ptr<Job> job)
+    : m_job(std::move(job))
+{}
+
+ShaderCompiler::Status ShaderCompiler::Handle::poll() const
+{
+    return m_job ? m_job->status : Status::Failed;
+}
+
+ShaderProgram ShaderCompiler::Handle::take()
+{
+    if (!m_job || m_job->status != Status::Ready || !m_job->program)
+    {
+        throw std::logic_error("ShaderCompiler::Handle::take() called on a program that is not ready");
+    }
+
+    ShaderProgram program = std::move(*m_job->program);
+    m_job->program.reset();
+    return program;
+}
+
+const std::string& ShaderCompiler::Handle::error() const
+{
+    static const std::string noJob = "empty handle";
+    return m_job ? m_job->error : noJob;
+}
+
+ShaderCompiler::ShaderCompiler(const unsigned workerCount, ShaderBinaryCache* cache)
+    : m_cache(cache)
+    , m_retainStages(false)
+    , m_stopping(false)
+{
+    if (Platform::glExtensions().parallelShaderCompile)
+    {
+        // 0xFFFFFFFF lets the driver pick its own thread count
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+    }
+
+    for (unsigned i = 0; i < std::max(workerCount, 1u); ++i)
+    {
+        m_workers.emplace_back(&ShaderCompiler::workerLoop, this);
+    }
+}
+
+ShaderCompiler::~ShaderCompiler()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+ShaderCompiler::Handle ShaderCompiler::submit(std::vector<ShaderStageDesc> stages, const bool separable)
+{
+    auto job = std::make_shared<Job>();
+    job->descs = std::move(stages);
+    job->separable = separable;
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_loadQueue.push_back(job);
+    }
+    m_wake.notify_one();
+
+    m_inFlight.push_back(job);
+    return Handle(std::move(job));
+}
+
+void ShaderCompiler::update()
+{
+    for (const std::shared_ptr<Job>& pointer : m_inFlight)
+    {
+        Job& job = *pointer;
+
+        if (job.status == Status::Loading && job.loaded.load(std::memory_order_acquire))
+        {
+            if (!job.error.empty())
+            {
+                fail(job, job.error);
+                continue;
+            }
+
+            job.stages.reserve(job.descs.size());
+            for (size_t i = 0; i < job.descs.size(); ++i)
+            {
+                job.stages.push_back(makeStage(job.descs[i], std::move(job.sources[i])));
+            }
+
+            job.program.emplace();
+            if (job.separable)
+            {
+                job.program->setSeparable(true);
+            }
+            for (const std::shared_ptr<const ShaderStage>& stage : job.stages)
+            {
+                job.program->attach(*stage);
+            }
+            job.program->beginLink(m_cache);
+            job.status = Status::Linking;
+            continue;
+        }
+
+        if (job.status == Status::Linking)
+        {
+            // Give the driver at least one frame before asking, even without
+            // GL_COMPLETION_STATUS_KHR to tell us it is done.
+            if (!job.waitedFrame)
+            {
+                job.waitedFrame = true;
+                continue;
+            }
+            if (!job.program->isLinkComplete())
+            {
+                continue;
+            }
+
+            try
+            {
+                if (job.program->finishLink())
+                {
+                    job.status = Status::Ready;
+                }
+                else
+                {
+                    fail(job, "link failed");
+                }
+            }
+            catch (const std::runtime_error& e)
+            {
+                fail(job, e.what());
+            }
+            job.stages.clear();
+        }
+    }
+
+    std::erase_if(m_inFlight, [](const std::shared_ptr<Job>& job) {
+        return job->status == Status::Ready || job->status == Status::Failed;
+    });
+}
+
+size_t ShaderCompiler::pendingCount() const
+{
+    return m_inFlight.size();
+}
+
+void ShaderCompiler::setRetainStages(const bool retain)
+{
+    m_retainStages = retain;
+    if (!retain)
+    {
+        m_retained.clear();
+    }
+}
+
+std::shared_ptr<const ShaderStage> ShaderCompiler::makeStage(const ShaderStageDesc& desc, std::string source)
+{
+    if (!m_retainStages)
+    {
+        return std::make_shared<const ShaderStage>(desc.filepath, desc.type, desc.defines, std::move(source));
+    }
+
+    std::uint64_t key = Core::fnv1a(desc.filepath);
+    key = Core::fnv1a(&desc.type, sizeof(desc.type), key);
+    for (const std::string& define : desc.defines)
+    {
+        key = Core::fnv1a(define, key);
+        key = Core::fnv1a(std::string_view("\n"), key);
+    }
+
+    const std::uint64_t sourceHash = Core::fnv1a(source);
+    RetainedStage& retained = m_retained[key];
+    if (!retained.stage || retained.sourceHash != sourceHash)
+    {
+        retained.sourceHash = sourceHash;
+        retained.stage = std::make_shared<const ShaderStage>(desc.filepath, desc.type, desc.defines, std::move(source));
+    }
+    return retained.stage;
+}
+
+void ShaderCompiler::workerLoop()
+{
+    while (true)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_loadQueue.empty(); });
+            if (m_stopping)
+            {
+                return;
+            }
+            job = std::move(m_loadQueue.front());
+            m_loadQueue.pop_front();
+        }
+
+        try
+        {
+            job->sources.reserve(job->descs.size());
+            for (const ShaderStageDesc& desc : job->descs)
+            {
+                job->sources.push_back(ShaderStage::loadSource(desc.filepath, desc.defines));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            job->error = e.what();
+        }
+
+        job->loaded.store(true, std::memory_order_release);
+    }
+}
+
+void ShaderCompiler::fail(Job& job, std::string error) const
+{
+    std::cerr << "[ShaderCompiler] " << error << std::endl;
+    job.error = std::move(error);
+    job.status = Status::Failed;
+    job.program.reset();
+}
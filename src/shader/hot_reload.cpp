@@ -0,0 +1,200 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "shader/hot_reload.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+#include "shader/preprocessor.h"
+#include "shader/sources.h"
+#include "shader/program.h"
+
+#ifdef __linux__
+#    include <poll.h>
+#    include <sys/inotify.h>
+#    include <unistd.h>
+#endif
+
+ShaderHotReloader::ShaderHotReloader(ShaderCompiler& compiler, std::filesystem::path directory)
+    : m_compiler(compiler)
+    , m_directory(ShaderPreprocessor::normalize(directory))
+    , m_stopping(false)
+    , m_inotify(-1)
+{
+    m_compiler.setRetainStages(true);
+
+#ifdef __linux__
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify < 0)
+    {
+        std::cerr << "[ShaderHotReloader] inotify_init1 failed, hot reload disabled\n";
+        return;
+    }
+    m_thread = std::thread(&ShaderHotReloader::watcherLoop, this);
+#else
+    std::cerr << "[ShaderHotReloader] no file watcher on this platform, hot reload disabled\n";
+#endif
+}
+
+ShaderHotReloader::~ShaderHotReloader()
+{
+    m_stopping = true;
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+#ifdef __linux__
+    if (m_inotify >= 0)
+    {
+        close(m_inotify);
+    }
+#endif
+}
+
+void ShaderHotReloader::watch(ShaderProgram& program, std::vector<ShaderStageDesc> stages)
+{
+    unwatch(program);
+
+    Watched watched {&program, std::move(stages), {}, {}, false};
+    for (const ShaderStageDesc& stage : watched.stages)
+    {
+        watched.files.push_back(ShaderPreprocessor::normalize(ShaderSources::diskPath(stage.filepath)));
+    }
+    m_watched.push_back(std::move(watched));
+}
+
+void ShaderHotReloader::unwatch(const ShaderProgram& program)
+{
+    std::erase_if(m_watched, [&](const Watched& watched) { return watched.program == &program; });
+}
+
+int ShaderHotReloader::update()
+{
+    std::set<std::filesystem::path> modified;
+    {
+        std::lock_guard lock(m_mutex);
+        modified.swap(m_changed);
+    }
+
+    // An edited header affects every stage that includes it
+    std::set<std::filesystem::path> changed;
+    for (const std::filesystem::path& file : modified)
+    {
+        for (std::filesystem::path& affected : ShaderPreprocessor::shared().invalidate(file))
+        {
+            changed.insert(std::move(affected));
+        }
+    }
+
+    int swapped = 0;
+    for (Watched& watched : m_watched)
+    {
+        // A newer edit supersedes a rebuild that is still in flight
+        if (!changed.empty() && dependsOn(watched, changed))
+        {
+            watched.pending = m_compiler.submit(watched.stages, watched.program->isSeparable());
+            watched.rebuilding = true;
+        }
+
+        if (!watched.rebuilding)
+        {
+            continue;
+        }
+
+        switch (watched.pending.poll())
+        {
+            case ShaderCompiler::Status::Ready:
+                *watched.program = watched.pending.take();
+                watched.rebuilding = false;
+                ++swapped;
+                std::cerr << "[ShaderHotReloader] reloaded " << watched.stages.front().filepath << " program\n";
+                break;
+            case ShaderCompiler::Status::Failed:
+                // The compiler already logged the error; keep the old program
+                watched.rebuilding = false;
+                break;
+            default:
+                break;
+        }
+    }
+    return swapped;
+}
+
+void ShaderHotReloader::watcherLoop()
+{
+#ifdef __linux__
+    constexpr uint32_t kMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+    std::unordered_map<int, std::filesystem::path> directories;
+    const auto addWatch = [&](const std::filesystem::path& directory) {
+        const int wd = inotify_add_watch(m_inotify, directory.c_str(), kMask);
+        if (wd < 0)
+        {
+            std::cerr << "[ShaderHotReloader] cannot watch " << directory << ": " << std::strerror(errno)
+                      << ", edits there are not reloaded\n";
+            return;
+        }
+        directories[wd] = directory;
+    };
+
+    std::error_code ec;
+    addWatch(m_directory);
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(m_directory, ec))
+    {
+        if (entry.is_directory(ec))
+        {
+            addWatch(ShaderPreprocessor::normalize(entry.path()));
+        }
+    }
+
+    // Large enough for a burst of events; each is a header plus a short name
+    alignas(inotify_event) char buffer[4096];
+
+    while (!m_stopping)
+    {
+        pollfd descriptor {m_inotify, POLLIN, 0};
+        if (poll(&descriptor, 1, 100) <= 0)
+        {
+            continue;
+        }
+
+        const ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            const auto directory = directories.find(event->wd);
+            if (event->len == 0 || directory == directories.end())
+            {
+                continue;
+            }
+
+            const std::filesystem::path path = directory->second / event->name;
+            if (event->mask & IN_ISDIR)
+            {
+                if (event->mask & IN_CREATE)
+                {
+                    addWatch(path);
+                }
+                continue;
+            }
+
+            std::lock_guard lock(m_mutex);
+            m_changed.insert(path);
+        }
+    }
+#endif
+}
+
+bool ShaderHotReloader::dependsOn(const Watched& watched, const std::set<std::filesystem::path>& changed) const
+{
+    return std::any_of(watched.files.begin(), watched.files.end(),
+                       [&](const std::filesystem::path& file) { return changed.contains(file); });
+}
@@ -0,0 +1,94 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "shader/pipeline.h"
+
+#include <iostream>
+#include <string>
+
+#include "core/Hash.h"
+#include "platform/GLState.h"
+#include "shader/program.h"
+
+ProgramPipelineCache::~ProgramPipelineCache()
+{
+    clear();
+}
+
+GLuint ProgramPipelineCache::get(const std::initializer_list<const ShaderProgram*> programs)
+{
+    if (!GLAD_GL_VERSION_4_1)
+    {
+        return 0;
+    }
+
+    std::uint64_t key = Core::fnv1a("pipeline");
+    for (const ShaderProgram* program : programs)
+    {
+        const std::uint64_t serial = program->getLinkSerial();
+        if (serial == 0 || !program->isSeparable())
+        {
+            return 0;
+        }
+        key = Core::fnv1a(&serial, sizeof(serial), key);
+    }
+
+    if (const auto it = m_pipelines.find(key); it != m_pipelines.end())
+    {
+        ++m_stats.hits;
+        return it->second;
+    }
+
+    GLuint pipeline = 0;
+    glGenProgramPipelines(1, &pipeline);
+    for (const ShaderProgram* program : programs)
+    {
+        glUseProgramStages(pipeline, program->getStageBits(), program->getId());
+    }
+
+    // Interface mismatches between stages only show up here, not at link time
+    glValidateProgramPipeline(pipeline);
+    GLint valid = GL_FALSE;
+    glGetProgramPipelineiv(pipeline, GL_VALIDATE_STATUS, &valid);
+    if (!valid)
+    {
+        GLint length = 0;
+        glGetProgramPipelineiv(pipeline, GL_INFO_LOG_LENGTH, &length);
+        std::string log(static_cast<size_t>(length > 0 ? length : 1), '\0');
+        glGetProgramPipelineInfoLog(pipeline, length, nullptr, log.data());
+        std::cerr << "[ProgramPipelineCache] pipeline " << pipeline << " failed validation: " << log << std::endl;
+    }
+
+    ++m_stats.created;
+    m_pipelines.emplace(key, pipeline);
+    return pipeline;
+}
+
+void ProgramPipelineCache::bind(const GLuint pipeline)
+{
+    // A program in use takes precedence over the bound pipeline
+    Platform::GLState& state = Platform::glState();
+    state.useProgram(0);
+    state.bindProgramPipeline(pipeline);
+}
+
+void ProgramPipelineCache::clear()
+{
+    for (const auto& [key, pipeline] : m_pipelines)
+    {
+        Platform::glState().forgetPipeline(pipeline);
+        glDeleteProgramPipelines(1, &pipeline);
+    }
+    m_pipelines.clear();
+}
+
+size_t ProgramPipelineCache::size() const
+{
+    return m_pipelines.size();
+}
+
+const ProgramPipelineCache::Stats& ProgramPipelineCache::getStats() const
+{
+    return m_stats;
+}
@@ -0,0 +1,287 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "shader/preprocessor.h"
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include <string_view>
+
+#include "core/Hash.h"
+#include "platform/MappedFile.h"
+
+namespace
+{
+    /**
+     * @brief Extracts the file name from an #include line, or returns empty.
+     */
+    std::string_view includeTarget(std::string_view line)
+    {
+        const size_t start = line.find_first_not_of(" \t");
+        if (start == std::string_view::npos || line[start] != '#')
+        {
+            return {};
+        }
+
+        line.remove_prefix(start + 1);
+        line.remove_prefix(std::min(line.find_first_not_of(" \t"), line.size()));
+        if (!line.starts_with("include"))
+        {
+            return {};
+        }
+
+        const size_t open = line.find_first_of("\"<");
+        if (open == std::string_view::npos)
+        {
+            return {};
+        }
+
+        const size_t close = line.find(line[open] == '"' ? '"' : '>', open + 1);
+        if (close == std::string_view::npos)
+        {
+            return {};
+        }
+
+        return line.substr(open + 1, close - open - 1);
+    }
+
+    template <typename LineFn>
+    void forEachLine(std::string_view text, LineFn&& fn)
+    {
+        while (!text.empty())
+        {
+            const size_t end = text.find('\n');
+            fn(text.substr(0, end));
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        }
+    }
+} // namespace
+
+ShaderPreprocessor::ShaderPreprocessor(std::filesystem::path includeRoot)
+    : m_includeRoot(std::move(includeRoot))
+{}
+
+ShaderPreprocessor& ShaderPreprocessor::shared()
+{
+    static ShaderPreprocessor instance;
+    return instance;
+}
+
+std::string ShaderPreprocessor::process(const std::filesystem::path& filepath, const std::vector<std::string>& defines)
+{
+    std::vector<std::filesystem::path> stack;
+    std::string                        source = *expand(normalize(filepath), stack).text;
+
+    injectDefines(source, defines);
+    return source;
+}
+
+std::vector<std::filesystem::path> ShaderPreprocessor::invalidate(const std::filesystem::path& file)
+{
+    std::lock_guard lock(m_mutex);
+
+    std::vector<std::filesystem::path> invalidated;
+    std::set<std::string>              visited;
+    std::deque<std::string>            queue {normalize(file).string()};
+
+    while (!queue.empty())
+    {
+        std::string key = std::move(queue.front());
+        queue.pop_front();
+        if (!visited.insert(key).second)
+        {
+            continue;
+        }
+
+        if (const auto entry = m_files.find(key); entry != m_files.end())
+        {
+            entry->second.stale = true;
+            ++entry->second.generation;
+        }
+
+        if (const auto dependents = m_dependents.find(key); dependents != m_dependents.end())
+        {
+            queue.insert(queue.end(), dependents->second.begin(), dependents->second.end());
+        }
+
+        invalidated.emplace_back(std::move(key));
+    }
+    return invalidated;
+}
+
+void ShaderPreprocessor::injectDefines(std::string& source, const std::vector<std::string>& defines)
+{
+    if (defines.empty())
+    {
+        return;
+    }
+
+    std::string block;
+    for (const std::string& define : defines)
+    {
+        block += "#define " + define + "\n";
+    }
+
+    // #version must stay the first directive, so the defines go right after it
+    size_t insertAt = 0;
+    if (const size_t version = source.find("#version"); version != std::string::npos)
+    {
+        const size_t lineEnd = source.find('\n', version);
+        insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+        if (lineEnd == std::string::npos)
+        {
+            block.insert(0, "\n");
+        }
+    }
+    source.insert(insertAt, block);
+}
+
+std::filesystem::path ShaderPreprocessor::normalize(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    const std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+    return (ec ? path : absolute).lexically_normal();
+}
+
+ShaderPreprocessor::Stats ShaderPreprocessor::getStats() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+ShaderPreprocessor::Expansion ShaderPreprocessor::expand(const std::filesystem::path& file,
+                                                         std::vector<std::filesystem::path>& stack)
+{
+    const std::string key = file.string();
+    std::uint64_t     generation = 0;
+    {
+        std::lock_guard lock(m_mutex);
+        const Entry&    entry = m_files[key];
+        if (!entry.stale)
+        {
+            return {entry.expanded, entry.expandedHash, entry.generation};
+        }
+        generation = entry.generation;
+    }
+
+    if (std::find(stack.begin(), stack.end(), file) != stack.end())
+    {
+        throw std::runtime_error("Include cycle through " + key);
+    }
+
+    // Everything from here to the publish below runs unlocked
+    const Platform::MappedFile mapped(file);
+    if (!mapped.isOpen())
+    {
+        throw std::runtime_error("Failed to open file " + key);
+    }
+    const std::string_view content = mapped.view();
+
+    // First pass: resolve includes and fold their hashes into ours, so an
+    // unchanged file with unchanged includes can keep its cached text.
+    stack.push_back(file);
+    std::vector<std::filesystem::path> includes;
+    std::vector<Expansion>             included;
+    const std::uint64_t                contentHash  = Core::fnv1a(content);
+    std::uint64_t                      expandedHash = contentHash;
+
+    forEachLine(content, [&](const std::string_view line) {
+        const std::string_view target = includeTarget(line);
+        if (target.empty())
+        {
+            return;
+        }
+
+        std::filesystem::path resolved = resolveInclude(file, std::string(target));
+        Expansion             child    = expand(resolved, stack);
+        expandedHash = Core::fnv1a(&child.hash, sizeof(child.hash), expandedHash);
+        includes.push_back(std::move(resolved));
+        included.push_back(std::move(child));
+    });
+    stack.pop_back();
+
+    // An edit landing while this ran leaves the entry stale, so the next
+    // process() reads the file again. That includes edits to an include
+    // whose reverse edge to us is not published yet.
+    const auto current = [&](const Entry& entry) {
+        if (entry.generation != generation)
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < includes.size(); ++i)
+        {
+            const Entry& child = m_files[includes[i].string()];
+            if (child.stale || child.generation != included[i].generation)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    {
+        std::lock_guard lock(m_mutex);
+        Entry&          entry = m_files[key];
+        if (entry.expanded && entry.contentHash == contentHash && entry.expandedHash == expandedHash)
+        {
+            ++m_stats.reuses;
+            entry.stale = !current(entry);
+            return {entry.expanded, expandedHash, generation};
+        }
+    }
+
+    // Second pass: paste the include expansions in place of their directives
+    auto   expanded = std::make_shared<std::string>();
+    expanded->reserve(content.size());
+    size_t next = 0;
+    forEachLine(content, [&](const std::string_view line) {
+        if (includeTarget(line).empty())
+        {
+            expanded->append(line);
+            expanded->push_back('\n');
+            return;
+        }
+
+        const std::string& text = *included[next++].text;
+        expanded->append(text);
+        if (!text.empty() && text.back() != '\n')
+        {
+            expanded->push_back('\n');
+        }
+    });
+
+    std::lock_guard lock(m_mutex);
+    Entry&          entry = m_files[key];
+
+    // Re-point the reverse edges of this file at its current includes
+    for (const std::filesystem::path& old : entry.includes)
+    {
+        m_dependents[old.string()].erase(key);
+    }
+    for (const std::filesystem::path& include : includes)
+    {
+        m_dependents[include.string()].insert(key);
+    }
+
+    entry.stale        = !current(entry);
+    entry.contentHash  = contentHash;
+    entry.expandedHash = expandedHash;
+    entry.expanded     = std::move(expanded);
+    entry.includes     = std::move(includes);
+    ++m_stats.expansions;
+    return {entry.expanded, expandedHash, generation};
+}
+
+std::filesystem::path ShaderPreprocessor::resolveInclude(const std::filesystem::path& includer,
+                                                         const std::string& name) const
+{
+    std::error_code             ec;
+    const std::filesystem::path sibling = (includer.parent_path() / name).lexically_normal();
+    if (std::filesystem::exists(sibling, ec))
+    {
+        return sibling;
+    }
+    return normalize(m_includeRoot / name);
+}
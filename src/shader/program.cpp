@@ -3,11 +3,110 @@
 //
 
 #include "shader/program.h"
+#include "platform/GLExtensions.h"
+#include "platform/GLState.h"
+#include "shader/binary_cache.h"
+#include "shader/sources.h"
 #include "shader/stage.h"
+#include "shader/telemetry.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <iostream>
+#include <unordered_map>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    UniformStats  s_frameStats;
+    std::uint64_t s_nextLinkSerial = 1;
+
+    double millisecondsSince(const Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    GLbitfield stageBitOf(const GLenum type)
+    {
+        switch (type)
+        {
+            case GL_VERTEX_SHADER: return GL_VERTEX_SHADER_BIT;
+            case GL_FRAGMENT_SHADER: return GL_FRAGMENT_SHADER_BIT;
+            case GL_GEOMETRY_SHADER: return GL_GEOMETRY_SHADER_BIT;
+            case GL_TESS_CONTROL_SHADER: return GL_TESS_CONTROL_SHADER_BIT;
+            case GL_TESS_EVALUATION_SHADER: return GL_TESS_EVALUATION_SHADER_BIT;
+            default: return 0;
+        }
+    }
+
+    std::unordered_map<std::string, GLuint>& blockBindings()
+    {
+        static std::unordered_map<std::string, GLuint> bindings;
+        return bindings;
+    }
+
+    enum class ShadowKind
+    {
+        None,
+        Float,
+        Int,
+        Uint
+    };
+
+    struct ShadowLayout
+    {
+        ShadowKind   kind;
+        std::uint8_t words;
+    };
+
+    ShadowLayout shadowLayoutOf(const GLenum type)
+    {
+        switch (type)
+        {
+            case GL_FLOAT: return {ShadowKind::Float, 1};
+            case GL_FLOAT_VEC2: return {ShadowKind::Float, 2};
+            case GL_FLOAT_VEC3: return {ShadowKind::Float, 3};
+            case GL_FLOAT_VEC4: return {ShadowKind::Float, 4};
+            case GL_FLOAT_MAT2: return {ShadowKind::Float, 4};
+            case GL_FLOAT_MAT3: return {ShadowKind::Float, 9};
+            case GL_FLOAT_MAT4: return {ShadowKind::Float, 16};
+            case GL_FLOAT_MAT2x3:
+            case GL_FLOAT_MAT3x2: return {ShadowKind::Float, 6};
+            case GL_FLOAT_MAT2x4:
+            case GL_FLOAT_MAT4x2: return {ShadowKind::Float, 8};
+            case GL_FLOAT_MAT3x4:
+            case GL_FLOAT_MAT4x3: return {ShadowKind::Float, 12};
+            case GL_INT_VEC2:
+            case GL_BOOL_VEC2: return {ShadowKind::Int, 2};
+            case GL_INT_VEC3:
+            case GL_BOOL_VEC3: return {ShadowKind::Int, 3};
+            case GL_INT_VEC4:
+            case GL_BOOL_VEC4: return {ShadowKind::Int, 4};
+            case GL_UNSIGNED_INT: return {ShadowKind::Uint, 1};
+            case GL_UNSIGNED_INT_VEC2: return {ShadowKind::Uint, 2};
+            case GL_UNSIGNED_INT_VEC3: return {ShadowKind::Uint, 3};
+            case GL_UNSIGNED_INT_VEC4: return {ShadowKind::Uint, 4};
+            case GL_DOUBLE:
+            case GL_DOUBLE_VEC2:
+            case GL_DOUBLE_VEC3:
+            case GL_DOUBLE_VEC4: return {ShadowKind::None, 0};
+            default:
+                // GL_INT, GL_BOOL and every sampler / image type hold one int
+                return {ShadowKind::Int, 1};
+        }
+    }
+} // namespace
 
 ShaderProgram::ShaderProgram()
+    : m_cache(nullptr)
+    , m_cacheKey(0)
+    , m_restored(false)
+    , m_separable(false)
+    , m_stageBits(0)
+    , m_linkSerial(0)
+    , m_linkBlockingMs(0.0)
 {
     m_id = glCreateProgram();
 }
@@ -16,12 +115,26 @@ ShaderProgram::~ShaderProgram()
 {
     if (m_id != 0)
     {
+        Platform::glState().forgetProgram(m_id);
         glDeleteProgram(m_id);
     }
 }
 
 ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept
     : m_id(other.m_id)
+    , m_stages(std::move(other.m_stages))
+    , m_linking(std::move(other.m_linking))
+    , m_uniforms(std::move(other.m_uniforms))
+    , m_blocks(std::move(other.m_blocks))
+    , m_cache(other.m_cache)
+    , m_cacheKey(other.m_cacheKey)
+    , m_restored(other.m_restored)
+    , m_separable(other.m_separable)
+    , m_stageBits(other.m_stageBits)
+    , m_linkSerial(other.m_linkSerial)
+    , m_linkStart(other.m_linkStart)
+    , m_linkBlockingMs(other.m_linkBlockingMs)
+    , m_submitMs(std::move(other.m_submitMs))
 {
     other.m_id = 0;
 }
@@ -30,42 +143,216 @@ ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept
 {
     if (this != &other)
     {
+        Platform::glState().forgetProgram(m_id);
         glDeleteProgram(m_id);
         m_id = other.m_id;
+        m_stages = std::move(other.m_stages);
+        m_linking = std::move(other.m_linking);
+        m_uniforms = std::move(other.m_uniforms);
+        m_blocks = std::move(other.m_blocks);
+        m_cache = other.m_cache;
+        m_cacheKey = other.m_cacheKey;
+        m_restored = other.m_restored;
+        m_separable = other.m_separable;
+        m_stageBits = other.m_stageBits;
+        m_linkSerial = other.m_linkSerial;
+        m_linkStart = other.m_linkStart;
+        m_linkBlockingMs = other.m_linkBlockingMs;
+        m_submitMs = std::move(other.m_submitMs);
         other.m_id = 0;
     }
     return *this;
 }
 
-void ShaderProgram::attach(const ShaderStage& stage) const
+void ShaderProgram::attach(const ShaderStage& stage)
+{
+    if (m_stages.empty())
+    {
+        m_stageBits = 0;
+    }
+    m_stages.push_back(&stage);
+    m_stageBits |= stageBitOf(stage.getType());
+}
+
+void ShaderProgram::setSeparable(const bool separable)
+{
+    if (!GLAD_GL_VERSION_4_1)
+    {
+        std::cerr << "[ShaderProgram] separable programs need GL 4.1, ignoring setSeparable()" << std::endl;
+        return;
+    }
+    m_separable = separable;
+    glProgramParameteri(m_id, GL_PROGRAM_SEPARABLE, separable ? GL_TRUE : GL_FALSE);
+}
+
+bool ShaderProgram::isSeparable() const
+{
+    return m_separable;
+}
+
+GLbitfield ShaderProgram::getStageBits() const
 {
-    glAttachShader(m_id, stage.getID());
+    return m_stageBits;
 }
 
-bool ShaderProgram::link() const
+std::uint64_t ShaderProgram::getLinkSerial() const
 {
+    return m_linkSerial;
+}
+
+bool ShaderProgram::link(ShaderBinaryCache* cache)
+{
+    beginLink(cache);
+    return finishLink();
+}
+
+void ShaderProgram::beginLink(ShaderBinaryCache* cache)
+{
+    m_linkStart = Clock::now();
+    m_linking = std::move(m_stages);
+    m_stages.clear();
+    m_cache = cache && cache->isEnabled() ? cache : nullptr;
+    m_restored = false;
+    m_submitMs.assign(m_linking.size(), -1.0);
+
+    if (m_cache)
+    {
+        m_cacheKey = m_cache->makeKey(m_linking, m_separable);
+        if (m_cache->load(m_cacheKey, m_id))
+        {
+            m_restored = true;
+            m_linkBlockingMs = millisecondsSince(m_linkStart);
+            return;
+        }
+        glProgramParameteri(m_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    for (size_t i = 0; i < m_linking.size(); ++i)
+    {
+        const Clock::time_point submitStart = Clock::now();
+        if (m_linking[i]->compile())
+        {
+            m_submitMs[i] = millisecondsSince(submitStart);
+        }
+        glAttachShader(m_id, m_linking[i]->getID());
+    }
+
     glLinkProgram(m_id);
+    m_linkBlockingMs = millisecondsSince(m_linkStart);
+}
 
-    int success;
-    glGetProgramiv(m_id, GL_LINK_STATUS, &success);
-    if (!success)
+bool ShaderProgram::isLinkComplete() const
+{
+    if (m_restored || !Platform::glExtensions().parallelShaderCompile)
     {
-        char infoLog[512];
-        glGetProgramInfoLog(m_id, sizeof(infoLog), nullptr, infoLog);
-        std::cerr << "Failed to link program: " + std::string(infoLog) << std::endl;
-        return false;
+        return true;
     }
+
+    GLint complete = GL_FALSE;
+    glGetProgramiv(m_id, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+bool ShaderProgram::finishLink()
+{
+    const Clock::time_point finishStart = Clock::now();
+    const std::vector<const ShaderStage*> stages = std::move(m_linking);
+    m_linking.clear();
+
+    if (!m_restored)
+    {
+        int success;
+        glGetProgramiv(m_id, GL_LINK_STATUS, &success);
+
+        for (const ShaderStage* stage : stages)
+        {
+            glDetachShader(m_id, stage->getID());
+        }
+
+        if (!success)
+        {
+            m_linkBlockingMs += millisecondsSince(finishStart);
+            recordTelemetry(stages, false);
+
+            // Compile errors surface here rather than per stage, so a
+            // successful build never waits on GL_COMPILE_STATUS.
+            for (const ShaderStage* stage : stages)
+            {
+                stage->checkCompileStatus();
+            }
+
+            char infoLog[512];
+            glGetProgramInfoLog(m_id, sizeof(infoLog), nullptr, infoLog);
+            std::cerr << "Failed to link program: " + std::string(infoLog) << std::endl;
+            return false;
+        }
+
+        if (m_cache)
+        {
+            m_cache->store(m_cacheKey, m_id);
+        }
+    }
+
+    reflectUniforms();
+    bindUniformBlocks();
+    m_linkSerial = s_nextLinkSerial++;
+
+    m_linkBlockingMs += millisecondsSince(finishStart);
+    recordTelemetry(stages, true);
     return true;
 }
 
+void ShaderProgram::recordTelemetry(const std::vector<const ShaderStage*>& stages, const bool linked) const
+{
+    ShaderTelemetry& telemetry = ShaderTelemetry::shared();
+    ShaderTelemetry::ProgramRecord program;
+
+    // The link status has been read already, so these queries do not stall
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+        const ShaderStage& stage = *stages[i];
+        program.name += (i ? " + " : "") + stage.getFilepath();
+
+        if (m_restored || i >= m_submitMs.size() || m_submitMs[i] < 0.0)
+        {
+            continue;
+        }
+
+        ShaderTelemetry::StageRecord record;
+        record.filepath = stage.getFilepath();
+        record.type = stage.getType();
+        for (const std::string& define : stage.getDefines())
+        {
+            record.defines += (record.defines.empty() ? "" : ";") + define;
+        }
+        record.sourceBytes = ShaderSources::sourceBytes(stage.getFilepath());
+        record.preprocessedBytes = stage.getSource().size();
+        record.submitMs = m_submitMs[i];
+
+        GLint logLength = 0;
+        glGetShaderiv(stage.getID(), GL_INFO_LOG_LENGTH, &logLength);
+        record.infoLogBytes = static_cast<size_t>(std::max(logLength, 0));
+        telemetry.recordStage(std::move(record));
+    }
+
+    GLint logLength = 0;
+    glGetProgramiv(m_id, GL_INFO_LOG_LENGTH, &logLength);
+    program.infoLogBytes = static_cast<size_t>(std::max(logLength, 0));
+    program.blockingMs = m_linkBlockingMs;
+    program.latencyMs = millisecondsSince(m_linkStart);
+    program.cacheHit = m_restored;
+    program.linked = linked;
+    telemetry.recordProgram(std::move(program));
+}
+
 void ShaderProgram::bind() const
 {
-    glUseProgram(m_id);
+    Platform::glState().useProgram(m_id);
 }
 
 void ShaderProgram::unbind() const
 {
-    glUseProgram(0);
+    Platform::glState().useProgram(0);
 }
 
 GLuint ShaderProgram::getId() const
@@ -73,17 +360,252 @@ GLuint ShaderProgram::getId() const
     return m_id;
 }
 
-void ShaderProgram::setUniform(const std::string& name, int value)
+const UniformInfo* ShaderProgram::findUniform(const UniformHandle handle) const
+{
+    return const_cast<ShaderProgram*>(this)->lookup(handle);
+}
+
+UniformInfo* ShaderProgram::lookup(const UniformHandle handle)
+{
+    const auto it =
+        std::lower_bound(m_uniforms.begin(), m_uniforms.end(), handle.hash,
+                         [](const UniformInfo& info, const std::uint64_t hash) { return info.hash < hash; });
+
+    if (it == m_uniforms.end() || it->hash != handle.hash)
+    {
+        return nullptr;
+    }
+    return &*it;
+}
+
+const std::vector<UniformInfo>& ShaderProgram::getUniforms() const
+{
+    return m_uniforms;
+}
+
+void ShaderProgram::setUniform(const UniformHandle handle, const int value)
 {
-    /// TODO
+    UniformInfo* info = lookup(handle);
+    if (!info || !updateShadow(*info, &value, 1))
+    {
+        return;
+    }
+
+    if (m_separable)
+    {
+        glProgramUniform1i(m_id, info->location, value);
+    }
+    else
+    {
+        glUniform1i(info->location, value);
+    }
+}
+
+void ShaderProgram::setUniform(const UniformHandle handle, const float value)
+{
+    UniformInfo* info = lookup(handle);
+    if (!info)
+    {
+        return;
+    }
+
+    assert(info->type == GL_FLOAT && "setUniform(float) on a non-float uniform");
+    if (!updateShadow(*info, &value, 1))
+    {
+        return;
+    }
+
+    if (m_separable)
+    {
+        glProgramUniform1f(m_id, info->location, value);
+    }
+    else
+    {
+        glUniform1f(info->location, value);
+    }
+}
+
+void ShaderProgram::setUniform(const UniformHandle handle, const glm::mat4& mat4)
+{
+    UniformInfo* info = lookup(handle);
+    if (!info)
+    {
+        return;
+    }
+
+    assert(info->type == GL_FLOAT_MAT4 && "setUniform(mat4) on a non-mat4 uniform");
+    if (!updateShadow(*info, glm::value_ptr(mat4), 16))
+    {
+        return;
+    }
+
+    if (m_separable)
+    {
+        glProgramUniformMatrix4fv(m_id, info->location, 1, GL_FALSE, glm::value_ptr(mat4));
+    }
+    else
+    {
+        glUniformMatrix4fv(info->location, 1, GL_FALSE, glm::value_ptr(mat4));
+    }
+}
+
+void ShaderProgram::setUniform(const std::string_view name, const int value)
+{
+    setUniform(UniformHandle(name), value);
+}
+
+void ShaderProgram::setUniform(const std::string_view name, const float value)
+{
+    setUniform(UniformHandle(name), value);
+}
+
+void ShaderProgram::setUniform(const std::string_view name, const glm::mat4& mat4)
+{
+    setUniform(UniformHandle(name), mat4);
 }
 
-void ShaderProgram::setUniform(const std::string& name, float value)
+const std::vector<UniformBlockInfo>& ShaderProgram::getUniformBlocks() const
 {
-    /// TODO
+    return m_blocks;
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::mat4& mat4)
+void ShaderProgram::registerBlockBinding(const std::string& blockName, const GLuint bindingPoint)
 {
-    /// TODO
+    blockBindings()[blockName] = bindingPoint;
+}
+
+const UniformStats& ShaderProgram::getFrameUniformStats()
+{
+    return s_frameStats;
+}
+
+void ShaderProgram::resetFrameUniformStats()
+{
+    s_frameStats = {};
+}
+
+bool ShaderProgram::updateShadow(UniformInfo& info, const void* value, const std::uint8_t words)
+{
+    const size_t bytes = words * sizeof(std::uint32_t);
+    if (info.shadowWords == words && std::memcmp(info.shadow.data(), value, bytes) == 0)
+    {
+        ++s_frameStats.skipped;
+        return false;
+    }
+
+    // A size mismatch means the type is not shadowed; store nothing and always issue
+    if (info.shadowWords == words)
+    {
+        std::memcpy(info.shadow.data(), value, bytes);
+    }
+    ++s_frameStats.issued;
+    return true;
+}
+
+void ShaderProgram::reflectUniforms()
+{
+    m_uniforms.clear();
+
+    GLint count = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    std::string name(static_cast<size_t>(std::max(maxNameLength, 1)), '\0');
+    m_uniforms.reserve(static_cast<size_t>(count));
+
+    for (GLint i = 0; i < count; ++i)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = GL_NONE;
+        glGetActiveUniform(m_id, static_cast<GLuint>(i), maxNameLength, &length, &size, &type, name.data());
+
+        std::string baseName(name.data(), static_cast<size_t>(length));
+        if (baseName.ends_with("[0]"))
+        {
+            baseName.resize(baseName.size() - 3);
+        }
+
+        // Members of uniform blocks have no location and are not set through here
+        const GLint location = glGetUniformLocation(m_id, baseName.c_str());
+        if (location < 0)
+        {
+            continue;
+        }
+
+        UniformInfo info {Core::fnv1a(baseName), location, type, size, std::move(baseName)};
+
+        // Seed the shadow with the linked default so the first identical write is skipped
+        const ShadowLayout layout = shadowLayoutOf(type);
+        switch (layout.kind)
+        {
+            case ShadowKind::Float:
+            {
+                GLfloat value[16];
+                glGetUniformfv(m_id, location, value);
+                std::memcpy(info.shadow.data(), value, layout.words * sizeof(GLfloat));
+                break;
+            }
+            case ShadowKind::Int:
+            {
+                GLint value[16];
+                glGetUniformiv(m_id, location, value);
+                std::memcpy(info.shadow.data(), value, layout.words * sizeof(GLint));
+                break;
+            }
+            case ShadowKind::Uint:
+            {
+                GLuint value[16];
+                glGetUniformuiv(m_id, location, value);
+                std::memcpy(info.shadow.data(), value, layout.words * sizeof(GLuint));
+                break;
+            }
+            case ShadowKind::None:
+                break;
+        }
+        info.shadowWords = layout.words;
+
+        m_uniforms.push_back(std::move(info));
+    }
+
+    std::sort(m_uniforms.begin(), m_uniforms.end(),
+              [](const UniformInfo& a, const UniformInfo& b) { return a.hash < b.hash; });
+
+    for (size_t i = 1; i < m_uniforms.size(); ++i)
+    {
+        if (m_uniforms[i].hash == m_uniforms[i - 1].hash)
+        {
+            std::cerr << "[ShaderProgram] uniform hash collision: " << m_uniforms[i - 1].name << " / "
+                      << m_uniforms[i].name << std::endl;
+        }
+    }
+}
+
+void ShaderProgram::bindUniformBlocks()
+{
+    m_blocks.clear();
+
+    GLint count = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxNameLength);
+
+    std::string name(static_cast<size_t>(std::max(maxNameLength, 1)), '\0');
+    for (GLint i = 0; i < count; ++i)
+    {
+        const auto index = static_cast<GLuint>(i);
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(m_id, index, maxNameLength, &length, name.data());
+
+        UniformBlockInfo block {std::string(name.data(), static_cast<size_t>(length)), index, 0, -1};
+        glGetActiveUniformBlockiv(m_id, index, GL_UNIFORM_BLOCK_DATA_SIZE, &block.dataSize);
+
+        if (const auto binding = blockBindings().find(block.name); binding != blockBindings().end())
+        {
+            glUniformBlockBinding(m_id, index, binding->second);
+            block.binding = static_cast<GLint>(binding->second);
+        }
+        m_blocks.push_back(std::move(block));
+    }
 }
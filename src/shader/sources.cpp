@@ -0,0 +1,109 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "shader/sources.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "embedded_shaders.h"
+#include "shader/preprocessor.h"
+
+namespace
+{
+    std::filesystem::path s_overrideRoot;
+
+    const EmbeddedShaders::File* findEntry(const std::string& filepath)
+    {
+        const std::string key = std::filesystem::path(filepath).lexically_normal().generic_string();
+
+        const auto* begin = std::begin(EmbeddedShaders::kFiles);
+        const auto* end   = std::end(EmbeddedShaders::kFiles);
+        const auto* file  = std::lower_bound(begin, end, key,
+                                             [](const EmbeddedShaders::File& entry, const std::string& path)
+                                             { return entry.path < path; });
+
+        if (file == end || file->path != key || key.empty())
+        {
+            return nullptr;
+        }
+        return file;
+    }
+} // namespace
+
+void ShaderSources::setOverrideRoot(std::filesystem::path root)
+{
+    s_overrideRoot = std::move(root);
+}
+
+const std::filesystem::path& ShaderSources::getOverrideRoot()
+{
+    return s_overrideRoot;
+}
+
+std::string ShaderSources::load(const std::string& filepath, const std::vector<std::string>& defines)
+{
+    if (!s_overrideRoot.empty())
+    {
+        std::error_code             ec;
+        const std::filesystem::path file = diskPath(filepath);
+        if (std::filesystem::is_regular_file(file, ec))
+        {
+            return ShaderPreprocessor::shared().process(file, defines);
+        }
+    }
+
+    if (const std::optional<std::string_view> embedded = findEmbedded(filepath))
+    {
+        std::string source(*embedded);
+        ShaderPreprocessor::injectDefines(source, defines);
+        return source;
+    }
+
+    return ShaderPreprocessor::shared().process(filepath, defines);
+}
+
+std::optional<std::string_view> ShaderSources::findEmbedded(const std::string& filepath)
+{
+    if (const EmbeddedShaders::File* file = findEntry(filepath))
+    {
+        return file->source;
+    }
+    return std::nullopt;
+}
+
+size_t ShaderSources::sourceBytes(const std::string& filepath)
+{
+    std::error_code ec;
+    if (!s_overrideRoot.empty())
+    {
+        if (const std::uintmax_t size = std::filesystem::file_size(diskPath(filepath), ec); !ec)
+        {
+            return static_cast<size_t>(size);
+        }
+    }
+
+    if (const EmbeddedShaders::File* file = findEntry(filepath))
+    {
+        return file->fileBytes;
+    }
+
+    const std::uintmax_t size = std::filesystem::file_size(filepath, ec);
+    return ec ? 0 : static_cast<size_t>(size);
+}
+
+std::filesystem::path ShaderSources::diskPath(const std::filesystem::path& filepath)
+{
+    if (s_overrideRoot.empty() || filepath.is_absolute())
+    {
+        return filepath;
+    }
+    return s_overrideRoot / filepath;
+}
+
+size_t ShaderSources::embeddedCount()
+{
+    return std::count_if(std::begin(EmbeddedShaders::kFiles), std::end(EmbeddedShaders::kFiles),
+                         [](const EmbeddedShaders::File& file) { return !file.path.empty(); });
+}
@@ -3,20 +3,28 @@
 //
 
 #include "shader/stage.h"
+#include "shader/sources.h"
 
-#include <fstream>
-#include <sstream>
+#include <stdexcept>
 #include <utility>
 
-ShaderStage::ShaderStage(std::string filepath, const GLenum type)
+ShaderStage::ShaderStage(std::string filepath, const GLenum type, std::vector<std::string> defines)
     : m_id(0)
     , m_type(type)
     , m_filepath(std::move(filepath))
+    , m_defines(std::move(defines))
 {
-    const std::string source = loadShaderSource();
-    compile(source);
+    m_source = loadSource(m_filepath, m_defines);
 }
 
+ShaderStage::ShaderStage(std::string filepath, const GLenum type, std::vector<std::string> defines, std::string source)
+    : m_id(0)
+    , m_type(type)
+    , m_filepath(std::move(filepath))
+    , m_defines(std::move(defines))
+    , m_source(std::move(source))
+{}
+
 ShaderStage::~ShaderStage()
 {
     if (m_id != 0)
@@ -26,9 +34,11 @@ ShaderStage::~ShaderStage()
 }
 
 ShaderStage::ShaderStage(ShaderStage&& other) noexcept
-    : m_id(0)
+    : m_id(other.m_id)
     , m_type(other.m_type)
     , m_filepath(std::move(other.m_filepath))
+    , m_defines(std::move(other.m_defines))
+    , m_source(std::move(other.m_source))
 {
     other.m_id = 0;
 }
@@ -41,6 +51,8 @@ ShaderStage& ShaderStage::operator=(ShaderStage&& other) noexcept
         m_id = other.m_id;
         m_type = other.m_type;
         m_filepath = std::move(other.m_filepath);
+        m_defines = std::move(other.m_defines);
+        m_source = std::move(other.m_source);
         other.m_id = 0;
     }
     return *this;
@@ -56,27 +68,42 @@ GLenum ShaderStage::getType() const
     return m_type;
 }
 
-std::string ShaderStage::loadShaderSource() const
+const std::string& ShaderStage::getFilepath() const
 {
-    std::ifstream file(m_filepath);
-    std::stringstream buffer;
+    return m_filepath;
+}
 
-    if (!file.is_open())
-    {
-        throw std::runtime_error("Failed to open file " + m_filepath);
-    }
+const std::string& ShaderStage::getSource() const
+{
+    return m_source;
+}
 
-    buffer << file.rdbuf();
-    return buffer.str();
+const std::vector<std::string>& ShaderStage::getDefines() const
+{
+    return m_defines;
 }
 
-void ShaderStage::compile(const std::string& source)
+std::string ShaderStage::loadSource(const std::string& filepath, const std::vector<std::string>& defines)
 {
-    const char* sourceCString = source.c_str();
+    return ShaderSources::load(filepath, defines);
+}
+
+bool ShaderStage::compile() const
+{
+    if (m_id != 0)
+    {
+        return false;
+    }
+
+    const char* sourceCString = m_source.c_str();
     m_id = glCreateShader(m_type);
     glShaderSource(m_id, 1, &sourceCString, nullptr);
     glCompileShader(m_id);
+    return true;
+}
 
+void ShaderStage::checkCompileStatus() const
+{
     int success;
     glGetShaderiv(m_id, GL_COMPILE_STATUS, &success);
 
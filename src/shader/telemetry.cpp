@@ -0,0 +1,190 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "shader/telemetry.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    const char* stageName(const GLenum type)
+    {
+        switch (type)
+        {
+            case GL_VERTEX_SHADER: return "vertex";
+            case GL_FRAGMENT_SHADER: return "fragment";
+            case GL_GEOMETRY_SHADER: return "geometry";
+            case GL_TESS_CONTROL_SHADER: return "tess_control";
+            case GL_TESS_EVALUATION_SHADER: return "tess_evaluation";
+            default: return "unknown";
+        }
+    }
+
+    void writeString(std::ostream& out, const std::string& text)
+    {
+        out << '"';
+        for (const char c : text)
+        {
+            switch (c)
+            {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                        out << escaped;
+                    }
+                    else
+                    {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+} // namespace
+
+ShaderTelemetry& ShaderTelemetry::shared()
+{
+    static ShaderTelemetry instance;
+    return instance;
+}
+
+void ShaderTelemetry::recordStage(StageRecord record)
+{
+    std::lock_guard lock(m_mutex);
+    m_stages.push_back(std::move(record));
+}
+
+void ShaderTelemetry::recordProgram(ProgramRecord record)
+{
+    std::lock_guard lock(m_mutex);
+    m_programs.push_back(std::move(record));
+}
+
+void ShaderTelemetry::recordWarmup(WarmupRecord record)
+{
+    std::lock_guard lock(m_mutex);
+    m_warmups.push_back(std::move(record));
+}
+
+std::vector<ShaderTelemetry::StageRecord> ShaderTelemetry::getStages() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_stages;
+}
+
+std::vector<ShaderTelemetry::ProgramRecord> ShaderTelemetry::getPrograms() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_programs;
+}
+
+std::vector<ShaderTelemetry::WarmupRecord> ShaderTelemetry::getWarmups() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_warmups;
+}
+
+bool ShaderTelemetry::writeJson(const std::filesystem::path& path) const
+{
+    std::lock_guard lock(m_mutex);
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "[ShaderTelemetry] cannot write " << path << std::endl;
+        return false;
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"stages\": [";
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        const StageRecord& stage = m_stages[i];
+        out << (i ? ",\n" : "\n") << "    {\"file\": ";
+        writeString(out, stage.filepath);
+        out << ", \"type\": \"" << stageName(stage.type) << "\", \"defines\": ";
+        writeString(out, stage.defines);
+        out << ", \"source_bytes\": " << stage.sourceBytes << ", \"preprocessed_bytes\": " << stage.preprocessedBytes
+            << ", \"submit_ms\": " << stage.submitMs << ", \"info_log_bytes\": " << stage.infoLogBytes << "}";
+    }
+    out << (m_stages.empty() ? "],\n" : "\n  ],\n");
+
+    out << "  \"programs\": [";
+    for (size_t i = 0; i < m_programs.size(); ++i)
+    {
+        const ProgramRecord& program = m_programs[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": ";
+        writeString(out, program.name);
+        out << ", \"blocking_ms\": " << program.blockingMs << ", \"latency_ms\": " << program.latencyMs
+            << ", \"cache\": \"" << (program.cacheHit ? "hit" : "miss") << "\""
+            << ", \"linked\": " << (program.linked ? "true" : "false")
+            << ", \"info_log_bytes\": " << program.infoLogBytes << "}";
+    }
+    out << (m_programs.empty() ? "],\n" : "\n  ],\n");
+
+    out << "  \"warmups\": [";
+    for (size_t i = 0; i < m_warmups.size(); ++i)
+    {
+        out << (i ? ",\n" : "\n") << "    {\"name\": ";
+        writeString(out, m_warmups[i].name);
+        out << ", \"draw_ms\": " << m_warmups[i].drawMs << "}";
+    }
+    out << (m_warmups.empty() ? "]\n}\n" : "\n  ]\n}\n");
+
+    return static_cast<bool>(out);
+}
+
+void ShaderTelemetry::printSlowest(std::ostream& out, const std::size_t count) const
+{
+    struct Row
+    {
+        double      ms;
+        const char* kind;
+        std::string detail;
+        std::string name;
+    };
+
+    std::vector<Row> rows;
+    {
+        std::lock_guard lock(m_mutex);
+        for (const ProgramRecord& program : m_programs)
+        {
+            rows.push_back({program.blockingMs, "build", program.cacheHit ? "cache hit" : "cache miss", program.name});
+        }
+        for (const WarmupRecord& warmup : m_warmups)
+        {
+            rows.push_back({warmup.drawMs, "warmup", "", warmup.name});
+        }
+    }
+
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.ms > b.ms; });
+    rows.resize(std::min(rows.size(), count));
+
+    out << "[ShaderTelemetry] slowest shaders:\n";
+    out << "  " << std::setw(10) << "ms" << "  " << std::left << std::setw(8) << "kind" << std::setw(12) << "detail"
+        << "name\n" << std::right;
+    for (const Row& row : rows)
+    {
+        out << "  " << std::fixed << std::setprecision(3) << std::setw(10) << row.ms << "  " << std::left
+            << std::setw(8) << row.kind << std::setw(12) << row.detail << row.name << '\n' << std::right;
+    }
+}
+
+void ShaderTelemetry::clear()
+{
+    std::lock_guard lock(m_mutex);
+    m_stages.clear();
+    m_programs.clear();
+    m_warmups.clear();
+}
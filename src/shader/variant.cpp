@@ -0,0 +1,205 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "shader/variant.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "shader/program.h"
+#include "shader/stage.h"
+
+ShaderVariantManager::ShaderVariantManager(std::string name, std::vector<ShaderStageDesc> stages,
+                                           std::vector<std::string> features, ShaderBinaryCache* cache)
+    : m_name(std::move(name))
+    , m_stages(std::move(stages))
+    , m_features(std::move(features))
+    , m_cache(cache)
+{
+    if (m_features.size() > 64)
+    {
+        throw std::invalid_argument("ShaderVariantManager supports at most 64 features (" + m_name + ")");
+    }
+}
+
+ShaderVariantManager::~ShaderVariantManager() = default;
+
+ShaderVariantManager::Key ShaderVariantManager::keyOf(const std::initializer_list<std::string_view> features) const
+{
+    Key key = 0;
+    for (const std::string_view feature : features)
+    {
+        for (size_t bit = 0; bit < m_features.size(); ++bit)
+        {
+            if (m_features[bit] == feature)
+            {
+                key |= Key {1} << bit;
+            }
+        }
+    }
+    return key;
+}
+
+ShaderProgram& ShaderVariantManager::get(const Key key)
+{
+    if (const auto it = m_variants.find(key); it != m_variants.end())
+    {
+        m_used.insert(key);
+        return *it->second;
+    }
+
+    ShaderProgram& program = build(key);
+    m_used.insert(key);
+    return program;
+}
+
+void ShaderVariantManager::precompile(const std::vector<Key>& keys)
+{
+    for (const Key key : keys)
+    {
+        if (!m_variants.contains(key))
+        {
+            build(key);
+        }
+    }
+}
+
+std::vector<ShaderStageDesc> ShaderVariantManager::stagesFor(const Key key) const
+{
+    std::vector<std::string> defines;
+    for (size_t bit = 0; bit < m_features.size(); ++bit)
+    {
+        if (key & (Key {1} << bit))
+        {
+            defines.push_back(m_features[bit]);
+        }
+    }
+
+    std::vector<ShaderStageDesc> stages = m_stages;
+    for (ShaderStageDesc& stage : stages)
+    {
+        stage.defines.insert(stage.defines.end(), defines.begin(), defines.end());
+    }
+    return stages;
+}
+
+const std::string& ShaderVariantManager::getName() const
+{
+    return m_name;
+}
+
+const std::set<ShaderVariantManager::Key>& ShaderVariantManager::getUsedKeys() const
+{
+    return m_used;
+}
+
+size_t ShaderVariantManager::getBuiltCount() const
+{
+    return m_variants.size();
+}
+
+bool ShaderVariantManager::saveWarmupList(const std::filesystem::path& path,
+                                          const std::vector<const ShaderVariantManager*>& managers)
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "[ShaderVariantManager] cannot write warmup list " << path << std::endl;
+        return false;
+    }
+
+    // Features are written by name so the list survives reordering them
+    for (const ShaderVariantManager* manager : managers)
+    {
+        for (const Key key : manager->m_used)
+        {
+            file << manager->m_name;
+            for (size_t bit = 0; bit < manager->m_features.size(); ++bit)
+            {
+                if (key & (Key {1} << bit))
+                {
+                    file << ' ' << manager->m_features[bit];
+                }
+            }
+            file << '\n';
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+size_t ShaderVariantManager::warmup(const std::filesystem::path& path,
+                                    const std::vector<ShaderVariantManager*>& managers)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return 0;
+    }
+
+    size_t built = 0;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream tokens(line);
+        std::string name;
+        tokens >> name;
+
+        for (ShaderVariantManager* manager : managers)
+        {
+            if (manager->m_name != name)
+            {
+                continue;
+            }
+
+            Key key = 0;
+            bool known = true;
+            for (std::string feature; tokens >> feature;)
+            {
+                const Key bit = manager->keyOf({feature});
+                known = known && bit != 0;
+                key |= bit;
+            }
+
+            // A feature that no longer exists means the entry is stale
+            if (known && !manager->m_variants.contains(key))
+            {
+                try
+                {
+                    manager->build(key);
+                    ++built;
+                }
+                catch (const std::runtime_error& e)
+                {
+                    std::cerr << "[ShaderVariantManager] warmup of " << line << " failed: " << e.what() << std::endl;
+                }
+            }
+            break;
+        }
+    }
+    return built;
+}
+
+ShaderProgram& ShaderVariantManager::build(const Key key)
+{
+    std::vector<ShaderStage> stages;
+    for (ShaderStageDesc& desc : stagesFor(key))
+    {
+        stages.emplace_back(std::move(desc.filepath), desc.type, std::move(desc.defines));
+    }
+
+    auto program = std::make_unique<ShaderProgram>();
+    for (const ShaderStage& stage : stages)
+    {
+        program->attach(stage);
+    }
+
+    if (!program->link(m_cache))
+    {
+        throw std::runtime_error("Failed to link variant " + std::to_string(key) + " of " + m_name);
+    }
+
+    return *m_variants.emplace(key, std::move(program)).first->second;
+}
@@ -0,0 +1,277 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "shader/warmup.h"
+
+#include <chrono>
+#include <iostream>
+
+#include "core/Hash.h"
+#include "platform/GLState.h"
+#include "shader/program.h"
+#include "shader/telemetry.h"
+
+namespace
+{
+    constexpr GLsizei kSize = 4;
+
+    // Large enough for three vertices of the widest attribute, a dmat4 column set
+    constexpr GLsizeiptr kZeroBytes = 3 * 4 * 4 * sizeof(double);
+
+    enum class AttributeKind
+    {
+        Float,
+        Int,
+        Unsigned,
+        Double,
+    };
+
+    struct AttributeShape
+    {
+        AttributeKind kind;
+        GLint         components; ///< Per location.
+        GLint         locations;  ///< Columns, for matrices.
+    };
+
+    AttributeShape shapeOf(const GLenum type)
+    {
+        switch (type)
+        {
+            case GL_FLOAT: return {AttributeKind::Float, 1, 1};
+            case GL_FLOAT_VEC2: return {AttributeKind::Float, 2, 1};
+            case GL_FLOAT_VEC3: return {AttributeKind::Float, 3, 1};
+            case GL_FLOAT_VEC4: return {AttributeKind::Float, 4, 1};
+            case GL_INT: return {AttributeKind::Int, 1, 1};
+            case GL_INT_VEC2: return {AttributeKind::Int, 2, 1};
+            case GL_INT_VEC3: return {AttributeKind::Int, 3, 1};
+            case GL_INT_VEC4: return {AttributeKind::Int, 4, 1};
+            case GL_UNSIGNED_INT: return {AttributeKind::Unsigned, 1, 1};
+            case GL_UNSIGNED_INT_VEC2: return {AttributeKind::Unsigned, 2, 1};
+            case GL_UNSIGNED_INT_VEC3: return {AttributeKind::Unsigned, 3, 1};
+            case GL_UNSIGNED_INT_VEC4: return {AttributeKind::Unsigned, 4, 1};
+            case GL_FLOAT_MAT2: return {AttributeKind::Float, 2, 2};
+            case GL_FLOAT_MAT3: return {AttributeKind::Float, 3, 3};
+            case GL_FLOAT_MAT4: return {AttributeKind::Float, 4, 4};
+            case GL_FLOAT_MAT2x3: return {AttributeKind::Float, 3, 2};
+            case GL_FLOAT_MAT2x4: return {AttributeKind::Float, 4, 2};
+            case GL_FLOAT_MAT3x2: return {AttributeKind::Float, 2, 3};
+            case GL_FLOAT_MAT3x4: return {AttributeKind::Float, 4, 3};
+            case GL_FLOAT_MAT4x2: return {AttributeKind::Float, 2, 4};
+            case GL_FLOAT_MAT4x3: return {AttributeKind::Float, 3, 4};
+            case GL_DOUBLE: return {AttributeKind::Double, 1, 1};
+            case GL_DOUBLE_VEC2: return {AttributeKind::Double, 2, 1};
+            case GL_DOUBLE_VEC3: return {AttributeKind::Double, 3, 1};
+            case GL_DOUBLE_VEC4: return {AttributeKind::Double, 4, 1};
+            default: return {AttributeKind::Float, 4, 1};
+        }
+    }
+
+    struct Attribute
+    {
+        GLint  location;
+        GLenum type;
+    };
+
+    std::vector<Attribute> activeAttributes(const GLuint program)
+    {
+        GLint count = 0;
+        GLint maxLength = 0;
+        glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count);
+        glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+
+        std::vector<Attribute> attributes;
+        std::string            name(static_cast<size_t>(maxLength > 0 ? maxLength : 1), '\0');
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLint   size = 0;
+            GLenum  type = GL_NONE;
+            GLsizei length = 0;
+            glGetActiveAttrib(program, static_cast<GLuint>(i), maxLength, &length, &size, &type, name.data());
+
+            // Built-ins such as gl_VertexID have no location
+            const GLint location = glGetAttribLocation(program, name.c_str());
+            if (location >= 0)
+            {
+                attributes.push_back({location, type});
+            }
+        }
+        return attributes;
+    }
+} // namespace
+
+ShaderWarmup::ShaderWarmup()
+    : m_framebuffer(0)
+    , m_color(0)
+    , m_depth(0)
+    , m_zeroBuffer(0)
+{
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+    glGenRenderbuffers(1, &m_color);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, kSize, kSize);
+
+    glGenRenderbuffers(1, &m_depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, kSize, kSize);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depth);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "[ShaderWarmup] warmup framebuffer is incomplete" << std::endl;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+
+    const std::vector<char> zeros(kZeroBytes, 0);
+    glGenBuffers(1, &m_zeroBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_zeroBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, kZeroBytes, zeros.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+ShaderWarmup::~ShaderWarmup()
+{
+    Platform::GLState& state = Platform::glState();
+    for (const auto& [signature, vertexArray] : m_vertexArrays)
+    {
+        state.forgetVertexArray(vertexArray);
+        glDeleteVertexArrays(1, &vertexArray);
+    }
+    state.forgetBuffer(m_zeroBuffer);
+    glDeleteBuffers(1, &m_zeroBuffer);
+    glDeleteFramebuffers(1, &m_framebuffer);
+    glDeleteRenderbuffers(1, &m_depth);
+    glDeleteRenderbuffers(1, &m_color);
+}
+
+void ShaderWarmup::add(const ShaderProgram& program, std::string name)
+{
+    if (program.isSeparable())
+    {
+        std::cerr << "[ShaderWarmup] skipping separable program " << name << std::endl;
+        return;
+    }
+    m_pending.push_back({&program, std::move(name)});
+}
+
+std::vector<ShaderWarmup::Result> ShaderWarmup::run()
+{
+    std::vector<Result> results;
+    if (m_pending.empty())
+    {
+        return results;
+    }
+
+    GLint previousFramebuffer = 0;
+    GLint previousProgram = 0;
+    GLint previousVertexArray = 0;
+    GLint previousViewport[4] = {};
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousVertexArray);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    // Restoring through the state cache keeps its shadow in step
+    Platform::GLState& state = Platform::glState();
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+    state.setViewport(0, 0, kSize, kSize);
+
+    // Settle any pending work so it is not billed to the first program
+    glFinish();
+
+    for (const Pending& pending : m_pending)
+    {
+        const GLuint program = pending.program->getId();
+        const GLuint vertexArray = vertexArrayFor(program);
+
+        const auto start = std::chrono::steady_clock::now();
+        state.useProgram(program);
+        state.bindVertexArray(vertexArray);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glFinish();
+        const double drawMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        ShaderTelemetry::shared().recordWarmup({pending.name, drawMs});
+        results.push_back({pending.name, drawMs});
+    }
+    m_pending.clear();
+
+    state.bindVertexArray(static_cast<GLuint>(previousVertexArray));
+    state.useProgram(static_cast<GLuint>(previousProgram));
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    state.setViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    return results;
+}
+
+GLuint ShaderWarmup::vertexArrayFor(const GLuint program)
+{
+    const std::vector<Attribute> attributes = activeAttributes(program);
+
+    std::uint64_t signature = Core::fnv1a("warmup");
+    for (const Attribute& attribute : attributes)
+    {
+        signature = Core::fnv1a(&attribute.location, sizeof(attribute.location), signature);
+        signature = Core::fnv1a(&attribute.type, sizeof(attribute.type), signature);
+    }
+
+    if (const auto it = m_vertexArrays.find(signature); it != m_vertexArrays.end())
+    {
+        return it->second;
+    }
+
+    GLint previousArrayBuffer = 0;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousArrayBuffer);
+
+    Platform::GLState& state = Platform::glState();
+    GLuint             vertexArray = 0;
+    glGenVertexArrays(1, &vertexArray);
+    state.bindVertexArray(vertexArray);
+    state.bindBuffer(GL_ARRAY_BUFFER, m_zeroBuffer);
+
+    for (const Attribute& attribute : attributes)
+    {
+        const AttributeShape shape = shapeOf(attribute.type);
+        const GLint scalarSize = shape.kind == AttributeKind::Double ? 8 : 4;
+        const GLsizei stride = shape.components * shape.locations * scalarSize;
+
+        for (GLint column = 0; column < shape.locations; ++column)
+        {
+            const auto location = static_cast<GLuint>(attribute.location + column);
+            const auto columnOffset = static_cast<uintptr_t>(column * shape.components * scalarSize);
+            const auto* offset = reinterpret_cast<const void*>(columnOffset);
+            switch (shape.kind)
+            {
+                case AttributeKind::Float:
+                    glVertexAttribPointer(location, shape.components, GL_FLOAT, GL_FALSE, stride, offset);
+                    break;
+                case AttributeKind::Int:
+                    glVertexAttribIPointer(location, shape.components, GL_INT, stride, offset);
+                    break;
+                case AttributeKind::Unsigned:
+                    glVertexAttribIPointer(location, shape.components, GL_UNSIGNED_INT, stride, offset);
+                    break;
+                case AttributeKind::Double:
+                    // 64-bit attributes need GL 4.1; older contexts fall back to the constant value
+                    if (!GLAD_GL_VERSION_4_1)
+                    {
+                        continue;
+                    }
+                    glVertexAttribLPointer(location, shape.components, GL_DOUBLE, stride, offset);
+                    break;
+            }
+            glEnableVertexAttribArray(location);
+        }
+    }
+
+    state.bindVertexArray(0);
+    state.bindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(previousArrayBuffer));
+    m_vertexArrays.emplace(signature, vertexArray);
+    return vertexArray;
+}
@@ -0,0 +1,115 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "uniform_ring.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "platform/GLState.h"
+
+UniformRing::UniformRing(const size_t bytesPerFrame, const unsigned frames)
+    : m_id(0)
+    , m_regionSize(0)
+    , m_frames(std::clamp(frames, 1u, kMaxFrames))
+    , m_frame(0)
+    , m_alignment(256)
+    , m_cursor(0)
+    , m_mapped(nullptr)
+    , m_fences {}
+{
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment > 0)
+    {
+        m_alignment = static_cast<size_t>(alignment);
+    }
+
+    // Regions start on an aligned offset so allocation offsets stay bindable
+    m_regionSize = (bytesPerFrame + m_alignment - 1) / m_alignment * m_alignment;
+
+    glGenBuffers(1, &m_id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(m_regionSize * m_frames), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+UniformRing::~UniformRing()
+{
+    for (GLsync& fence : m_fences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+    }
+    if (m_id != 0)
+    {
+        Platform::glState().forgetBuffer(m_id);
+        glDeleteBuffers(1, &m_id);
+    }
+}
+
+void UniformRing::beginFrame()
+{
+    if (GLsync& fence = m_fences[m_frame])
+    {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    m_cursor = 0;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    m_mapped = static_cast<char*>(glMapBufferRange(
+        GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(m_frame * m_regionSize), static_cast<GLsizeiptr>(m_regionSize),
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+UniformRing::Allocation UniformRing::allocate(const size_t size, void** data)
+{
+    const size_t offset = (m_cursor + m_alignment - 1) / m_alignment * m_alignment;
+    if (!m_mapped || offset + size > m_regionSize)
+    {
+        throw std::runtime_error("UniformRing: frame region of " + std::to_string(m_regionSize) +
+                                 " bytes exhausted or not mapped");
+    }
+
+    m_cursor = offset + size;
+    *data = m_mapped + offset;
+    return {static_cast<GLintptr>(m_frame * m_regionSize + offset), static_cast<GLsizeiptr>(size)};
+}
+
+void UniformRing::flush()
+{
+    if (!m_mapped)
+    {
+        return;
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    m_mapped = nullptr;
+}
+
+void UniformRing::bind(const GLuint bindingPoint, const Allocation& allocation) const
+{
+    Platform::glState().bindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, m_id, allocation.offset, allocation.size);
+}
+
+void UniformRing::endFrame()
+{
+    flush();
+    m_fences[m_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_frame = (m_frame + 1) % m_frames;
+}
+
+size_t UniformRing::getUsedBytes() const
+{
+    return m_cursor;
+}
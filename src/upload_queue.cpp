@@ -0,0 +1,228 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "upload_queue.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // Keeps every staged offset valid for glTexSubImage with any unpack alignment
+    constexpr size_t kAlignment = 16;
+
+    size_t alignUp(const size_t value)
+    {
+        return (value + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    struct Copy
+    {
+        GLintptr           source = 0;
+        GLuint             buffer = 0;
+        GLintptr           offset = 0;
+        GLsizeiptr         size   = 0;
+        UploadQueue::Apply apply;
+    };
+} // namespace
+
+UploadQueue::UploadQueue(const Core::UploadQueueConfig& config)
+    : m_budget(alignUp(std::max(config.bytesPerFrame, kAlignment)))
+    , m_staging(VertexBuffer::createStreaming(m_budget, config.frames))
+    , m_nextTicket(0)
+    , m_pendingBytes(0)
+    , m_completed(0)
+    , m_staged(0)
+{}
+
+UploadQueue::~UploadQueue()
+{
+    for (const InFlight& inFlight : m_inFlight)
+    {
+        glDeleteSync(inFlight.fence);
+    }
+}
+
+UploadQueue::Ticket UploadQueue::enqueue(const GLuint buffer, const GLintptr offset, const void* data,
+                                         const size_t size)
+{
+    Request request;
+    request.data.resize(size);
+    std::memcpy(request.data.data(), data, size);
+    request.buffer = buffer;
+    request.offset = offset;
+    return push(std::move(request));
+}
+
+UploadQueue::Ticket UploadQueue::enqueue(Apply apply, const void* data, const size_t size)
+{
+    if (size > m_budget)
+    {
+        throw std::logic_error("UploadQueue: an upload of " + std::to_string(size) +
+                               " bytes does not fit the per-frame budget of " + std::to_string(m_budget));
+    }
+
+    Request request;
+    request.data.resize(size);
+    std::memcpy(request.data.data(), data, size);
+    request.apply = std::move(apply);
+    return push(std::move(request));
+}
+
+UploadQueue::Ticket UploadQueue::push(Request request)
+{
+    std::lock_guard lock(m_mutex);
+    request.ticket = ++m_nextTicket;
+    m_pendingBytes += request.data.size();
+    ++m_stats.enqueued;
+    m_requests.push_back(std::move(request));
+    return m_nextTicket;
+}
+
+void UploadQueue::update()
+{
+    retire(false);
+    if (stage())
+    {
+        std::lock_guard lock(m_mutex);
+        ++m_stats.budgetFrames;
+    }
+}
+
+void UploadQueue::drain()
+{
+    while (stage())
+    {
+    }
+    retire(true);
+}
+
+size_t UploadQueue::getPendingBytes() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_pendingBytes;
+}
+
+UploadQueue::Stats UploadQueue::getStats() const
+{
+    std::lock_guard lock(m_mutex);
+    Stats stats     = m_stats;
+    stats.completed = m_completed.load(std::memory_order_acquire);
+    return stats;
+}
+
+void UploadQueue::retire(const bool wait)
+{
+    while (!m_inFlight.empty())
+    {
+        const InFlight& front = m_inFlight.front();
+
+        GLenum result = glClientWaitSync(front.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, 0);
+        while (wait && result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(front.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000'000);
+        }
+        if (result == GL_TIMEOUT_EXPIRED)
+        {
+            return;
+        }
+
+        glDeleteSync(front.fence);
+        m_completed.store(front.ticket, std::memory_order_release);
+        m_inFlight.pop_front();
+    }
+}
+
+bool UploadQueue::stage()
+{
+    std::vector<Copy> copies;
+    size_t            used     = 0;
+    bool              leftover = false;
+
+    while (true)
+    {
+        Request* request;
+        {
+            // Only this thread pops, and push_back never moves deque elements,
+            // so the front stays valid while the lock is released for the copy
+            std::lock_guard lock(m_mutex);
+            if (m_requests.empty())
+            {
+                break;
+            }
+            request = &m_requests.front();
+        }
+
+        const size_t remaining = request->data.size() - request->consumed;
+        const size_t space     = m_budget - used;
+        const size_t chunk     = request->apply ? remaining : std::min(remaining, space);
+
+        if (chunk > space || (chunk == 0 && remaining > 0))
+        {
+            leftover = true;
+            break;
+        }
+
+        if (copies.empty())
+        {
+            m_staging.beginFrame();
+        }
+
+        const VertexBuffer::Allocation allocation =
+            m_staging.write(request->data.data() + request->consumed, chunk, kAlignment);
+        used += alignUp(chunk);
+
+        Copy copy;
+        copy.source = allocation.offset;
+        copy.buffer = request->buffer;
+        copy.offset = request->offset + static_cast<GLintptr>(request->consumed);
+        copy.size   = static_cast<GLsizeiptr>(chunk);
+
+        std::lock_guard lock(m_mutex);
+        request->consumed += chunk;
+        m_pendingBytes -= chunk;
+        m_stats.bytesUploaded += chunk;
+
+        if (request->consumed == request->data.size())
+        {
+            copy.apply = std::move(request->apply);
+            m_staged   = request->ticket;
+            m_requests.pop_front();
+        }
+        copies.push_back(std::move(copy));
+    }
+
+    if (copies.empty())
+    {
+        return leftover;
+    }
+
+    m_staging.flush();
+    glBindBuffer(GL_COPY_READ_BUFFER, m_staging.getID());
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_staging.getID());
+
+    for (const Copy& copy : copies)
+    {
+        if (copy.apply)
+        {
+            copy.apply(copy.source);
+            continue;
+        }
+        if (copy.size > 0)
+        {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, copy.buffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, copy.source, copy.offset, copy.size);
+        }
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    m_staging.endFrame();
+    m_inFlight.push_back({glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), m_staged});
+    return leftover;
+}
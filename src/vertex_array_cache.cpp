@@ -0,0 +1,267 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "vertex_array_cache.h"
+
+#include "core/Hash.h"
+#include "platform/GLExtensions.h"
+#include "platform/GLState.h"
+
+namespace
+{
+    // Vertex buffer binding indices of the DSA path
+    constexpr GLuint kVertexBinding   = 0;
+    constexpr GLuint kInstanceBinding = 1;
+} // namespace
+
+VertexArrayCache::VertexArrayCache()
+    : m_directStateAccess(Platform::glExtensions().directStateAccess)
+{}
+
+VertexArrayCache::~VertexArrayCache()
+{
+    clear();
+}
+
+GLuint VertexArrayCache::get(const VertexLayout& layout, const GLuint vertexBuffer, const GLuint indexBuffer,
+                             const GLintptr vertexOffset)
+{
+    return acquire(layout, nullptr, vertexBuffer, indexBuffer, vertexOffset).vao;
+}
+
+GLuint VertexArrayCache::bind(const VertexLayout& layout, const GLuint vertexBuffer, const GLuint indexBuffer,
+                              const GLintptr vertexOffset)
+{
+    const GLuint vao = get(layout, vertexBuffer, indexBuffer, vertexOffset);
+    Platform::glState().bindVertexArray(vao);
+    return vao;
+}
+
+GLuint VertexArrayCache::bindInstanced(const VertexLayout& layout, const GLuint vertexBuffer,
+                                       const GLuint indexBuffer, const VertexLayout& instanceLayout,
+                                       const GLuint instanceBuffer, const GLintptr instanceOffset)
+{
+    Platform::GLState& state = Platform::glState();
+    Entry&             entry = acquire(layout, &instanceLayout, vertexBuffer, indexBuffer, 0);
+    state.bindVertexArray(entry.vao);
+
+    if (entry.instanceBuffer == instanceBuffer && entry.instanceOffset == instanceOffset)
+    {
+        ++m_stats.bufferSkipped;
+        return entry.vao;
+    }
+
+    if (m_directStateAccess)
+    {
+        glVertexArrayVertexBuffer(entry.vao, kInstanceBinding, instanceBuffer, instanceOffset, instanceLayout.stride);
+    }
+    else
+    {
+        state.bindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        for (const VertexAttribute& attribute : instanceLayout.attributes)
+        {
+            const GLintptr attributeOffset = instanceOffset + static_cast<GLintptr>(attribute.offset);
+            glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized,
+                                  instanceLayout.stride, reinterpret_cast<const void*>(attributeOffset));
+        }
+        state.bindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    entry.instanceBuffer = instanceBuffer;
+    entry.instanceOffset = instanceOffset;
+    ++m_stats.bufferBinds;
+    return entry.vao;
+}
+
+VertexArrayCache::Entry& VertexArrayCache::acquire(const VertexLayout& layout, const VertexLayout* instanceLayout,
+                                                   const GLuint vertexBuffer, const GLuint indexBuffer,
+                                                   const GLintptr vertexOffset)
+{
+    std::uint64_t key = layout.hash();
+    if (instanceLayout)
+    {
+        const std::uint64_t instanceKey = instanceLayout->hash();
+        key = Core::fnv1a(&instanceKey, sizeof(instanceKey), key);
+    }
+    if (!m_directStateAccess)
+    {
+        const GLuint buffers[] = {vertexBuffer, indexBuffer};
+        key = Core::fnv1a(buffers, sizeof(buffers), key);
+        key = Core::fnv1a(&vertexOffset, sizeof(vertexOffset), key);
+    }
+
+    auto it = m_arrays.find(key);
+    if (it == m_arrays.end())
+    {
+        ++m_stats.created;
+        const Entry entry = m_directStateAccess
+                                ? createDirect(layout, instanceLayout)
+                                : createBound(layout, instanceLayout, vertexBuffer, indexBuffer, vertexOffset);
+        it = m_arrays.emplace(key, entry).first;
+    }
+    else
+    {
+        ++m_stats.hits;
+    }
+
+    Entry& entry = it->second;
+    if (!m_directStateAccess)
+    {
+        return entry;
+    }
+
+    if (entry.vertexBuffer != vertexBuffer || entry.vertexOffset != vertexOffset)
+    {
+        glVertexArrayVertexBuffer(entry.vao, kVertexBinding, vertexBuffer, vertexOffset, layout.stride);
+        entry.vertexBuffer = vertexBuffer;
+        entry.vertexOffset = vertexOffset;
+        ++m_stats.bufferBinds;
+    }
+    else
+    {
+        ++m_stats.bufferSkipped;
+    }
+
+    if (entry.indexBuffer != indexBuffer)
+    {
+        glVertexArrayElementBuffer(entry.vao, indexBuffer);
+        entry.indexBuffer = indexBuffer;
+        ++m_stats.bufferBinds;
+    }
+    else
+    {
+        ++m_stats.bufferSkipped;
+    }
+    return entry;
+}
+
+void VertexArrayCache::forget(const GLuint buffer)
+{
+    if (buffer == 0)
+    {
+        return;
+    }
+
+    for (auto it = m_arrays.begin(); it != m_arrays.end();)
+    {
+        Entry& entry = it->second;
+
+        // Instance attributes are re-pointed on the next bindInstanced()
+        if (entry.instanceBuffer == buffer)
+        {
+            if (m_directStateAccess)
+            {
+                glVertexArrayVertexBuffer(entry.vao, kInstanceBinding, 0, 0, 0);
+            }
+            entry.instanceBuffer = 0;
+            entry.instanceOffset = 0;
+        }
+
+        if (m_directStateAccess)
+        {
+            if (entry.vertexBuffer == buffer)
+            {
+                glVertexArrayVertexBuffer(entry.vao, kVertexBinding, 0, 0, 0);
+                entry.vertexBuffer = 0;
+            }
+            if (entry.indexBuffer == buffer)
+            {
+                glVertexArrayElementBuffer(entry.vao, 0);
+                entry.indexBuffer = 0;
+            }
+            ++it;
+            continue;
+        }
+
+        // Bound-path VAOs are keyed by their vertex and index buffers
+        if (entry.vertexBuffer == buffer || entry.indexBuffer == buffer)
+        {
+            Platform::glState().forgetVertexArray(entry.vao);
+            glDeleteVertexArrays(1, &entry.vao);
+            it = m_arrays.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void VertexArrayCache::clear()
+{
+    for (const auto& [key, entry] : m_arrays)
+    {
+        Platform::glState().forgetVertexArray(entry.vao);
+        glDeleteVertexArrays(1, &entry.vao);
+    }
+    m_arrays.clear();
+}
+
+VertexArrayCache::Entry VertexArrayCache::createDirect(const VertexLayout& layout, const VertexLayout* instanceLayout)
+{
+    Entry entry;
+    glCreateVertexArrays(1, &entry.vao);
+
+    for (const VertexAttribute& attribute : layout.attributes)
+    {
+        glEnableVertexArrayAttrib(entry.vao, attribute.location);
+        glVertexArrayAttribFormat(entry.vao, attribute.location, attribute.components, attribute.type,
+                                  attribute.normalized, attribute.offset);
+        glVertexArrayAttribBinding(entry.vao, attribute.location, kVertexBinding);
+    }
+
+    if (instanceLayout)
+    {
+        for (const VertexAttribute& attribute : instanceLayout->attributes)
+        {
+            glEnableVertexArrayAttrib(entry.vao, attribute.location);
+            glVertexArrayAttribFormat(entry.vao, attribute.location, attribute.components, attribute.type,
+                                      attribute.normalized, attribute.offset);
+            glVertexArrayAttribBinding(entry.vao, attribute.location, kInstanceBinding);
+        }
+        glVertexArrayBindingDivisor(entry.vao, kInstanceBinding, 1);
+    }
+    return entry;
+}
+
+VertexArrayCache::Entry VertexArrayCache::createBound(const VertexLayout& layout, const VertexLayout* instanceLayout,
+                                                      const GLuint vertexBuffer, const GLuint indexBuffer,
+                                                      const GLintptr vertexOffset)
+{
+    Entry entry;
+    entry.vertexBuffer = vertexBuffer;
+    entry.indexBuffer  = indexBuffer;
+    entry.vertexOffset = vertexOffset;
+
+    Platform::GLState& state = Platform::glState();
+    glGenVertexArrays(1, &entry.vao);
+    state.bindVertexArray(entry.vao);
+
+    // Shift every attribute pointer by the vertex offset
+    VertexLayout shifted = layout;
+    for (VertexAttribute& attribute : shifted.attributes)
+    {
+        attribute.offset += static_cast<GLuint>(vertexOffset);
+    }
+
+    state.bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    shifted.apply();
+    state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+    // Pointers are set by bindInstanced(), which knows the instance buffer
+    if (instanceLayout)
+    {
+        for (const VertexAttribute& attribute : instanceLayout->attributes)
+        {
+            glEnableVertexAttribArray(attribute.location);
+            glVertexAttribDivisor(attribute.location, 1);
+        }
+    }
+
+    // Unbind the VAO first, or it would record the element buffer unbind
+    state.bindVertexArray(0);
+    state.bindBuffer(GL_ARRAY_BUFFER, 0);
+    state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    return entry;
+}
@@ -0,0 +1,264 @@
+//
+// Created by Kyrylo Pylinskyi on 22/11/2025.
+//
+
+#include "vertex_buffer.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "platform/GLExtensions.h"
+#include "platform/GLState.h"
+#include "upload_queue.h"
+
+VertexBuffer::VertexBuffer()
+    : m_id(0)
+    , m_size(0)
+    , m_mode(Mode::Static)
+    , m_regionSize(0)
+    , m_frames(1)
+    , m_frame(0)
+    , m_cursor(0)
+    , m_persistent(nullptr)
+    , m_mapped(nullptr)
+    , m_stalls(0)
+    , m_fences {}
+{}
+
+VertexBuffer::VertexBuffer(const void* data, const size_t size, const GLenum usage)
+    : VertexBuffer()
+{
+    createBuffer(data, size, usage);
+}
+
+VertexBuffer::VertexBuffer(const std::vector<float>& vertices, const GLenum usage)
+    : VertexBuffer(vertices.data(), vertices.size() * sizeof(float), usage)
+{}
+
+VertexBuffer VertexBuffer::createStreaming(const size_t bytesPerFrame, const unsigned frames)
+{
+    VertexBuffer buffer;
+    buffer.m_regionSize = bytesPerFrame;
+
+    glGenBuffers(1, &buffer.m_id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer.m_id);
+
+    if (Platform::glExtensions().bufferStorage)
+    {
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        buffer.m_mode = Mode::Persistent;
+        buffer.m_frames = std::clamp(frames, 1u, kMaxFrames);
+        buffer.m_size = bytesPerFrame * buffer.m_frames;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(buffer.m_size), nullptr, flags);
+        buffer.m_persistent = static_cast<char*>(
+            glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(buffer.m_size), flags));
+    }
+    else
+    {
+        // Orphaning gives every frame fresh storage, so one region is enough
+        buffer.m_mode = Mode::Orphaning;
+        buffer.m_frames = 1;
+        buffer.m_size = bytesPerFrame;
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(buffer.m_size), nullptr, GL_STREAM_DRAW);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    if (buffer.m_mode == Mode::Persistent && !buffer.m_persistent)
+    {
+        throw std::runtime_error("VertexBuffer: failed to map a persistent buffer of " +
+                                 std::to_string(buffer.m_size) + " bytes");
+    }
+    return buffer;
+}
+
+VertexBuffer::VertexBuffer(VertexBuffer&& other) noexcept
+    : m_id(std::exchange(other.m_id, 0))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_mode(other.m_mode)
+    , m_regionSize(other.m_regionSize)
+    , m_frames(other.m_frames)
+    , m_frame(other.m_frame)
+    , m_cursor(other.m_cursor)
+    , m_persistent(std::exchange(other.m_persistent, nullptr))
+    , m_mapped(std::exchange(other.m_mapped, nullptr))
+    , m_stalls(other.m_stalls)
+    , m_fences(std::exchange(other.m_fences, {}))
+{}
+
+VertexBuffer& VertexBuffer::operator=(VertexBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        m_id = std::exchange(other.m_id, 0);
+        m_size = std::exchange(other.m_size, 0);
+        m_mode = other.m_mode;
+        m_regionSize = other.m_regionSize;
+        m_frames = other.m_frames;
+        m_frame = other.m_frame;
+        m_cursor = other.m_cursor;
+        m_persistent = std::exchange(other.m_persistent, nullptr);
+        m_mapped = std::exchange(other.m_mapped, nullptr);
+        m_stalls = other.m_stalls;
+        m_fences = std::exchange(other.m_fences, {});
+    }
+    return *this;
+}
+
+VertexBuffer::~VertexBuffer()
+{
+    release();
+}
+
+void VertexBuffer::bind() const
+{
+    Platform::glState().bindBuffer(GL_ARRAY_BUFFER, m_id);
+}
+
+void VertexBuffer::unbind() const
+{
+    Platform::glState().bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void VertexBuffer::updateData(const void* data, const size_t size, const size_t offset)
+{
+    if (isStreaming())
+    {
+        throw std::logic_error("VertexBuffer::updateData() called on a streaming buffer");
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+std::uint64_t VertexBuffer::updateDataAsync(UploadQueue& queue, const void* data, const size_t size,
+                                            const size_t offset)
+{
+    if (isStreaming())
+    {
+        throw std::logic_error("VertexBuffer::updateDataAsync() called on a streaming buffer");
+    }
+    return queue.enqueue(m_id, static_cast<GLintptr>(offset), data, size);
+}
+
+void VertexBuffer::beginFrame()
+{
+    m_cursor = 0;
+
+    if (m_mode == Mode::Persistent)
+    {
+        if (GLsync& fence = m_fences[m_frame])
+        {
+            GLenum result = glClientWaitSync(fence, 0, 0);
+            if (result == GL_TIMEOUT_EXPIRED)
+            {
+                ++m_stalls;
+                do
+                {
+                    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000'000);
+                } while (result == GL_TIMEOUT_EXPIRED);
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+        m_mapped = m_persistent + m_frame * m_regionSize;
+        return;
+    }
+
+    if (m_mode == Mode::Orphaning)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(m_size), nullptr, GL_STREAM_DRAW);
+        m_mapped = static_cast<char*>(glMapBufferRange(
+            GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(m_size),
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+}
+
+VertexBuffer::Allocation VertexBuffer::allocate(const size_t size, void** data, const size_t alignment)
+{
+    // Align the absolute offset, so firstVertex() is exact in every region
+    const size_t base = m_frame * m_regionSize;
+    const size_t absolute = (base + m_cursor + alignment - 1) / alignment * alignment;
+    const size_t offset = absolute - base;
+
+    if (!m_mapped || offset + size > m_regionSize)
+    {
+        throw std::runtime_error("VertexBuffer: frame region of " + std::to_string(m_regionSize) +
+                                 " bytes exhausted or not mapped");
+    }
+
+    m_cursor = offset + size;
+    *data = m_mapped + offset;
+    return {static_cast<GLintptr>(absolute), static_cast<GLsizeiptr>(size)};
+}
+
+void VertexBuffer::flush()
+{
+    if (m_mode != Mode::Orphaning || !m_mapped)
+    {
+        return;
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    m_mapped = nullptr;
+}
+
+void VertexBuffer::endFrame()
+{
+    flush();
+    m_mapped = nullptr;
+
+    if (m_mode == Mode::Persistent)
+    {
+        m_fences[m_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    m_frame = (m_frame + 1) % m_frames;
+}
+
+void VertexBuffer::createBuffer(const void* data, const size_t size, const GLenum usage)
+{
+    m_size = size;
+    glGenBuffers(1, &m_id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size), data, usage);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void VertexBuffer::release()
+{
+    for (GLsync& fence : m_fences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    if (m_id == 0)
+    {
+        return;
+    }
+
+    if (m_persistent || m_mapped)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        m_persistent = nullptr;
+        m_mapped = nullptr;
+    }
+
+    Platform::glState().forgetBuffer(m_id);
+    glDeleteBuffers(1, &m_id);
+    m_id = 0;
+}
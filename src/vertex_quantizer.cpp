@@ -0,0 +1,415 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "vertex_quantizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/packing.hpp>
+#include <limits>
+
+#if defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER))
+#    define LEARNOPENGL_QUANTIZE_AVX2
+#    include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#    define LEARNOPENGL_QUANTIZE_SSE2
+#    include <emmintrin.h>
+#    if defined(__F16C__)
+#        include <immintrin.h>
+#    endif
+#endif
+
+namespace
+{
+    constexpr float kSnorm16 = 32767.0f;
+    constexpr float kMinL1   = std::numeric_limits<float>::min(); ///< Keeps zero vectors finite in octahedral().
+
+    unsigned char* at(void* out, const std::size_t index, const std::size_t stride)
+    {
+        return static_cast<unsigned char*>(out) + index * stride;
+    }
+
+    // Scalar reference paths; the SIMD loops below fall back to them for the tail
+
+    void positionsScalar(const float* positions, std::size_t first, const std::size_t count, const glm::vec3 center,
+                         const glm::vec3 scale, void* out, const std::size_t outStride)
+    {
+        for (; first < count; ++first)
+        {
+            const glm::vec3     p      = glm::make_vec3(positions + first * 3);
+            const std::uint64_t packed = glm::packSnorm4x16(glm::vec4((p - center) * scale, 1.0f));
+            std::memcpy(at(out, first, outStride), &packed, sizeof(packed));
+        }
+    }
+
+    glm::vec2 octahedral(glm::vec3 n)
+    {
+        // A zero vector would divide 0 by 0; the clamp maps it to (0, 0), which decodes as +Z
+        n /= std::max(std::abs(n.x) + std::abs(n.y) + std::abs(n.z), kMinL1);
+        if (n.z >= 0.0f)
+        {
+            return {n.x, n.y};
+        }
+        // Fold the lower hemisphere over the diagonals
+        return {(1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f)};
+    }
+
+    void octahedralScalar(const float* vectors, std::size_t first, const std::size_t count, void* out,
+                          const std::size_t outStride)
+    {
+        for (; first < count; ++first)
+        {
+            const glm::uint packed = glm::packSnorm2x16(octahedral(glm::make_vec3(vectors + first * 3)));
+            std::memcpy(at(out, first, outStride), &packed, sizeof(packed));
+        }
+    }
+
+    void halfScalar(const float* uvs, std::size_t first, const std::size_t count, void* out,
+                    const std::size_t outStride)
+    {
+        for (; first < count; ++first)
+        {
+            const glm::uint packed = glm::packHalf2x16(glm::make_vec2(uvs + first * 2));
+            std::memcpy(at(out, first, outStride), &packed, sizeof(packed));
+        }
+    }
+
+#if defined(LEARNOPENGL_QUANTIZE_SSE2) || defined(LEARNOPENGL_QUANTIZE_AVX2)
+    // Writes the low and high 8 bytes of two packed positions
+    void storePositionPair(const __m128i pair, unsigned char* first, unsigned char* second)
+    {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(first), pair);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(second), _mm_unpackhi_epi64(pair, pair));
+    }
+
+    // Interleaves two int32 lanes of snorm16 values into x | y << 16
+    __m128i packSnormPairs(const __m128i x, const __m128i y)
+    {
+        return _mm_or_si128(_mm_and_si128(x, _mm_set1_epi32(0xffff)), _mm_slli_epi32(y, 16));
+    }
+
+    void storeLanes(const __m128i lanes, void* out, const std::size_t first, const std::size_t outStride)
+    {
+        alignas(16) std::uint32_t values[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(values), lanes);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            std::memcpy(at(out, first + i, outStride), &values[i], sizeof(std::uint32_t));
+        }
+    }
+#endif
+
+#if defined(LEARNOPENGL_QUANTIZE_SSE2)
+    __m128 gather3(const float* base, const std::size_t first, const int component)
+    {
+        const float* p = base + first * 3 + component;
+        return _mm_setr_ps(p[0], p[3], p[6], p[9]);
+    }
+
+    __m128 snormClamp(const __m128 value)
+    {
+        return _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+    }
+
+    std::size_t positionsSimd(const float* positions, const std::size_t count, const glm::vec3 center,
+                              const glm::vec3 scale, void* out, const std::size_t outStride)
+    {
+        const __m128  cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), cz = _mm_set1_ps(center.z);
+        const __m128  sx = _mm_set1_ps(scale.x * kSnorm16), sy = _mm_set1_ps(scale.y * kSnorm16),
+                      sz = _mm_set1_ps(scale.z * kSnorm16);
+        const __m128  limit = _mm_set1_ps(kSnorm16);
+        const __m128i one   = _mm_set1_epi32(32767);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const auto quantize = [&](const __m128 v, const __m128 c, const __m128 s) {
+                const __m128 q = _mm_mul_ps(_mm_sub_ps(v, c), s);
+                return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(q, _mm_sub_ps(_mm_setzero_ps(), limit)), limit));
+            };
+
+            __m128 x = _mm_castsi128_ps(quantize(gather3(positions, i, 0), cx, sx));
+            __m128 y = _mm_castsi128_ps(quantize(gather3(positions, i, 1), cy, sy));
+            __m128 z = _mm_castsi128_ps(quantize(gather3(positions, i, 2), cz, sz));
+            __m128 w = _mm_castsi128_ps(one);
+
+            // Rows of x, y, z, w become one column per vertex
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+
+            const __m128i v01 = _mm_packs_epi32(_mm_castps_si128(x), _mm_castps_si128(y));
+            const __m128i v23 = _mm_packs_epi32(_mm_castps_si128(z), _mm_castps_si128(w));
+            storePositionPair(v01, at(out, i, outStride), at(out, i + 1, outStride));
+            storePositionPair(v23, at(out, i + 2, outStride), at(out, i + 3, outStride));
+        }
+        return i;
+    }
+
+    std::size_t octahedralSimd(const float* vectors, const std::size_t count, void* out, const std::size_t outStride)
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 one      = _mm_set1_ps(1.0f);
+        const __m128 scale    = _mm_set1_ps(kSnorm16);
+        const __m128 minL1    = _mm_set1_ps(kMinL1);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 x = gather3(vectors, i, 0);
+            const __m128 y = gather3(vectors, i, 1);
+            const __m128 z = gather3(vectors, i, 2);
+
+            const __m128 sum = _mm_max_ps(_mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)),
+                                                     _mm_andnot_ps(signMask, z)),
+                                          minL1);
+            const __m128 nx  = _mm_div_ps(x, sum);
+            const __m128 ny  = _mm_div_ps(y, sum);
+
+            // Lower hemisphere: (1 - |y|, 1 - |x|) with the signs of x and y
+            const __m128 fx = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, ny)), _mm_and_ps(signMask, nx));
+            const __m128 fy = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, nx)), _mm_and_ps(signMask, ny));
+            const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+
+            const __m128 ex = _mm_or_ps(_mm_and_ps(lower, fx), _mm_andnot_ps(lower, nx));
+            const __m128 ey = _mm_or_ps(_mm_and_ps(lower, fy), _mm_andnot_ps(lower, ny));
+
+            const __m128i qx = _mm_cvtps_epi32(_mm_mul_ps(snormClamp(ex), scale));
+            const __m128i qy = _mm_cvtps_epi32(_mm_mul_ps(snormClamp(ey), scale));
+            storeLanes(packSnormPairs(qx, qy), out, i, outStride);
+        }
+        return i;
+    }
+
+    std::size_t halfSimd(const float* uvs, const std::size_t count, void* out, const std::size_t outStride)
+    {
+#    if defined(__F16C__)
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            const __m128i halves = _mm_cvtps_ph(_mm_loadu_ps(uvs + i * 2), _MM_FROUND_TO_NEAREST_INT);
+            const auto    first  = static_cast<std::uint32_t>(_mm_cvtsi128_si32(halves));
+            const auto    second = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(halves, 4)));
+            std::memcpy(at(out, i, outStride), &first, sizeof(first));
+            std::memcpy(at(out, i + 1, outStride), &second, sizeof(second));
+        }
+        return i;
+#    else
+        // No hardware half conversion without F16C; glm's bit twiddling is as fast as an emulation
+        (void)uvs;
+        (void)count;
+        (void)out;
+        (void)outStride;
+        return 0;
+#    endif
+    }
+#endif
+
+#if defined(LEARNOPENGL_QUANTIZE_AVX2)
+    __m256 gather3(const float* base, const std::size_t first, const int component)
+    {
+        const __m256i offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+        return _mm256_i32gather_ps(base + first * 3 + component, offsets, sizeof(float));
+    }
+
+    __m256 snormClamp(const __m256 value)
+    {
+        return _mm256_min_ps(_mm256_max_ps(value, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    }
+
+    std::size_t positionsSimd(const float* positions, const std::size_t count, const glm::vec3 center,
+                              const glm::vec3 scale, void* out, const std::size_t outStride)
+    {
+        const __m256 cx = _mm256_set1_ps(center.x), cy = _mm256_set1_ps(center.y), cz = _mm256_set1_ps(center.z);
+        const __m256 sx = _mm256_set1_ps(scale.x), sy = _mm256_set1_ps(scale.y), sz = _mm256_set1_ps(scale.z);
+        const __m256 limit = _mm256_set1_ps(kSnorm16);
+        const __m256 w     = _mm256_castsi256_ps(_mm256_set1_epi32(32767));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const auto quantize = [&](const __m256 v, const __m256 c, const __m256 s) {
+                return _mm256_castsi256_ps(
+                    _mm256_cvtps_epi32(_mm256_mul_ps(snormClamp(_mm256_mul_ps(_mm256_sub_ps(v, c), s)), limit)));
+            };
+
+            const __m256 x = quantize(gather3(positions, i, 0), cx, sx);
+            const __m256 y = quantize(gather3(positions, i, 1), cy, sy);
+            const __m256 z = quantize(gather3(positions, i, 2), cz, sz);
+
+            // 4x4 transpose inside each 128-bit lane: lane 0 holds vertices 0-3, lane 1 vertices 4-7
+            const __m256 xy0 = _mm256_unpacklo_ps(x, y);
+            const __m256 xy1 = _mm256_unpackhi_ps(x, y);
+            const __m256 zw0 = _mm256_unpacklo_ps(z, w);
+            const __m256 zw1 = _mm256_unpackhi_ps(z, w);
+
+            const __m256i c0 = _mm256_castps_si256(_mm256_shuffle_ps(xy0, zw0, _MM_SHUFFLE(1, 0, 1, 0)));
+            const __m256i c1 = _mm256_castps_si256(_mm256_shuffle_ps(xy0, zw0, _MM_SHUFFLE(3, 2, 3, 2)));
+            const __m256i c2 = _mm256_castps_si256(_mm256_shuffle_ps(xy1, zw1, _MM_SHUFFLE(1, 0, 1, 0)));
+            const __m256i c3 = _mm256_castps_si256(_mm256_shuffle_ps(xy1, zw1, _MM_SHUFFLE(3, 2, 3, 2)));
+
+            // packs works per lane: v0 v1 | v4 v5 and v2 v3 | v6 v7
+            const __m256i p01 = _mm256_packs_epi32(c0, c1);
+            const __m256i p23 = _mm256_packs_epi32(c2, c3);
+
+            storePositionPair(_mm256_castsi256_si128(p01), at(out, i, outStride), at(out, i + 1, outStride));
+            storePositionPair(_mm256_castsi256_si128(p23), at(out, i + 2, outStride), at(out, i + 3, outStride));
+            storePositionPair(_mm256_extracti128_si256(p01, 1), at(out, i + 4, outStride), at(out, i + 5, outStride));
+            storePositionPair(_mm256_extracti128_si256(p23, 1), at(out, i + 6, outStride), at(out, i + 7, outStride));
+        }
+        return i;
+    }
+
+    std::size_t octahedralSimd(const float* vectors, const std::size_t count, void* out, const std::size_t outStride)
+    {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256 one      = _mm256_set1_ps(1.0f);
+        const __m256 scale    = _mm256_set1_ps(kSnorm16);
+        const __m256 minL1    = _mm256_set1_ps(kMinL1);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 x = gather3(vectors, i, 0);
+            const __m256 y = gather3(vectors, i, 1);
+            const __m256 z = gather3(vectors, i, 2);
+
+            const __m256 sum = _mm256_max_ps(
+                _mm256_add_ps(_mm256_add_ps(_mm256_andnot_ps(signMask, x), _mm256_andnot_ps(signMask, y)),
+                              _mm256_andnot_ps(signMask, z)),
+                minL1);
+            const __m256 nx = _mm256_div_ps(x, sum);
+            const __m256 ny = _mm256_div_ps(y, sum);
+
+            const __m256 fx =
+                _mm256_or_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signMask, ny)), _mm256_and_ps(signMask, nx));
+            const __m256 fy =
+                _mm256_or_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signMask, nx)), _mm256_and_ps(signMask, ny));
+            const __m256 lower = _mm256_cmp_ps(z, _mm256_setzero_ps(), _CMP_LT_OQ);
+
+            const __m256i qx = _mm256_cvtps_epi32(_mm256_mul_ps(snormClamp(_mm256_blendv_ps(nx, fx, lower)), scale));
+            const __m256i qy = _mm256_cvtps_epi32(_mm256_mul_ps(snormClamp(_mm256_blendv_ps(ny, fy, lower)), scale));
+
+            storeLanes(packSnormPairs(_mm256_castsi256_si128(qx), _mm256_castsi256_si128(qy)), out, i, outStride);
+            storeLanes(packSnormPairs(_mm256_extracti128_si256(qx, 1), _mm256_extracti128_si256(qy, 1)), out,
+                       i + 4, outStride);
+        }
+        return i;
+    }
+
+    std::size_t halfSimd(const float* uvs, const std::size_t count, void* out, const std::size_t outStride)
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            // Four UVs are eight contiguous floats, converted in one instruction
+            const __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(uvs + i * 2), _MM_FROUND_TO_NEAREST_INT);
+            storeLanes(halves, out, i, outStride);
+        }
+        return i;
+    }
+#endif
+} // namespace
+
+glm::vec3 VertexQuantizer::Bounds::extent() const
+{
+    // A flat axis still needs a non-zero scale to divide by
+    return glm::max((max - min) * 0.5f, glm::vec3(1e-20f));
+}
+
+glm::mat4 VertexQuantizer::Bounds::dequantizeMatrix() const
+{
+    return glm::scale(glm::translate(glm::mat4(1.0f), center()), extent());
+}
+
+const char* VertexQuantizer::simdPath()
+{
+#if defined(LEARNOPENGL_QUANTIZE_AVX2)
+    return "AVX2";
+#elif defined(LEARNOPENGL_QUANTIZE_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+VertexQuantizer::Bounds VertexQuantizer::computeBounds(const float* positions, const std::size_t count)
+{
+    if (count == 0)
+    {
+        return {};
+    }
+
+    Bounds bounds {glm::make_vec3(positions), glm::make_vec3(positions)};
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        const glm::vec3 p = glm::make_vec3(positions + i * 3);
+        bounds.min        = glm::min(bounds.min, p);
+        bounds.max        = glm::max(bounds.max, p);
+    }
+    return bounds;
+}
+
+void VertexQuantizer::quantizePositions(const float* positions, const std::size_t count, const Bounds& bounds,
+                                        void* out, const std::size_t outStride)
+{
+    const glm::vec3 center = bounds.center();
+    const glm::vec3 scale  = 1.0f / bounds.extent();
+
+    std::size_t done = 0;
+#if defined(LEARNOPENGL_QUANTIZE_SSE2) || defined(LEARNOPENGL_QUANTIZE_AVX2)
+    done = positionsSimd(positions, count, center, scale, out, outStride);
+#endif
+    positionsScalar(positions, done, count, center, scale, out, outStride);
+}
+
+void VertexQuantizer::encodeOctahedral(const float* vectors, const std::size_t count, void* out,
+                                       const std::size_t outStride)
+{
+    std::size_t done = 0;
+#if defined(LEARNOPENGL_QUANTIZE_SSE2) || defined(LEARNOPENGL_QUANTIZE_AVX2)
+    done = octahedralSimd(vectors, count, out, outStride);
+#endif
+    octahedralScalar(vectors, done, count, out, outStride);
+}
+
+void VertexQuantizer::packHalf2(const float* uvs, const std::size_t count, void* out, const std::size_t outStride)
+{
+    std::size_t done = 0;
+#if defined(LEARNOPENGL_QUANTIZE_SSE2) || defined(LEARNOPENGL_QUANTIZE_AVX2)
+    done = halfSimd(uvs, count, out, outStride);
+#endif
+    halfScalar(uvs, done, count, out, outStride);
+}
+
+VertexQuantizer::Bounds VertexQuantizer::quantize(const float* positions, const float* normals, const float* uvs,
+                                                  const std::size_t count, QuantizedVertex* out)
+{
+    const Bounds bounds = computeBounds(positions, count);
+    quantizePositions(positions, count, bounds, out->position, sizeof(QuantizedVertex));
+
+    if (normals)
+    {
+        encodeOctahedral(normals, count, out->normal, sizeof(QuantizedVertex));
+    }
+    if (uvs)
+    {
+        packHalf2(uvs, count, out->uv, sizeof(QuantizedVertex));
+    }
+
+    for (std::size_t i = 0; i < count && (!normals || !uvs); ++i)
+    {
+        if (!normals)
+        {
+            std::fill(std::begin(out[i].normal), std::end(out[i].normal), std::int16_t {0});
+        }
+        if (!uvs)
+        {
+            std::fill(std::begin(out[i].uv), std::end(out[i].uv), std::uint16_t {0});
+        }
+    }
+    return bounds;
+}
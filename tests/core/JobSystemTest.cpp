@@ -0,0 +1,248 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/JobSystem.h"
+
+namespace
+{
+    Core::JobSystemConfig withWorkers(const int workers, const std::size_t queueCapacity = 4096)
+    {
+        Core::JobSystemConfig config;
+        config.workerThreads = workers;
+        config.queueCapacity = queueCapacity;
+        return config;
+    }
+
+    TEST(JobSystemTest, CounterDrainsOnceEveryJobHasRun)
+    {
+        Core::JobSystem          jobs(withWorkers(3));
+        Core::JobSystem::Counter counter;
+        std::atomic<int>         ran {0};
+
+        EXPECT_TRUE(counter.isDone());
+        for (int i = 0; i < 1000; ++i)
+        {
+            jobs.run([&] { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.wait(counter);
+
+        EXPECT_TRUE(counter.isDone());
+        EXPECT_EQ(ran.load(), 1000);
+        EXPECT_GE(jobs.getStats().executed, 1000u);
+    }
+
+    TEST(JobSystemTest, ZeroWorkersRunsJobsInsideWait)
+    {
+        Core::JobSystem          jobs(withWorkers(0));
+        Core::JobSystem::Counter counter;
+        bool                     ran = false;
+
+        EXPECT_EQ(jobs.getThreadCount(), 1u);
+        jobs.run([&] { ran = true; }, &counter);
+        EXPECT_FALSE(ran);
+        jobs.wait(counter);
+        EXPECT_TRUE(ran);
+    }
+
+    TEST(JobSystemTest, RunAfterHoldsJobsUntilTheDependencyDrains)
+    {
+        Core::JobSystem jobs(withWorkers(3));
+        for (int frame = 0; frame < 100; ++frame)
+        {
+            Core::JobSystem::Counter first, second, third;
+            std::atomic<int>         firstDone {0};
+            std::atomic<bool>        early {false};
+            int                      stage = 0;
+
+            for (int i = 0; i < 32; ++i)
+            {
+                jobs.run([&] { firstDone.fetch_add(1); }, &first);
+            }
+            jobs.runAfter(
+                first,
+                [&]
+                {
+                    early = early || firstDone.load() != 32;
+                    stage = 1;
+                },
+                &second);
+            jobs.runAfter(
+                second,
+                [&]
+                {
+                    early = early || stage != 1;
+                    stage = 2;
+                },
+                &third);
+            jobs.wait(third);
+
+            ASSERT_FALSE(early.load());
+            ASSERT_EQ(stage, 2);
+        }
+    }
+
+    TEST(JobSystemTest, RunAfterADrainedCounterRunsAtOnce)
+    {
+        Core::JobSystem          jobs(withWorkers(1));
+        Core::JobSystem::Counter drained, counter;
+        bool                     ran = false;
+
+        jobs.runAfter(drained, [&] { ran = true; }, &counter);
+        jobs.wait(counter);
+        EXPECT_TRUE(ran);
+    }
+
+    TEST(JobSystemTest, JobsSpawnJobs)
+    {
+        Core::JobSystem          jobs(withWorkers(3));
+        Core::JobSystem::Counter counter;
+        std::atomic<int>         ran {0};
+
+        for (int i = 0; i < 20; ++i)
+        {
+            jobs.run(
+                [&]
+                {
+                    for (int k = 0; k < 50; ++k)
+                    {
+                        jobs.run([&] { ran.fetch_add(1); }, &counter);
+                    }
+                    ran.fetch_add(1);
+                },
+                &counter);
+        }
+        jobs.wait(counter);
+        EXPECT_EQ(ran.load(), 20 * 51);
+    }
+
+    TEST(JobSystemTest, FullDequeRunsJobsInline)
+    {
+        Core::JobSystem          jobs(withWorkers(0, 4));
+        Core::JobSystem::Counter counter;
+        std::atomic<int>         ran {0};
+
+        for (int i = 0; i < 100; ++i)
+        {
+            jobs.run([&] { ran.fetch_add(1); }, &counter);
+        }
+        jobs.wait(counter);
+
+        EXPECT_EQ(ran.load(), 100);
+        EXPECT_GT(jobs.getStats().inlined, 0u);
+    }
+
+    TEST(JobSystemTest, ParallelForVisitsEveryIndexOnce)
+    {
+        Core::JobSystem jobs(withWorkers(3));
+        for (const std::size_t grain : {std::size_t {1}, std::size_t {7}, std::size_t {1000}})
+        {
+            std::vector<std::atomic<int>> visits(10007);
+            jobs.parallelFor(
+                0, visits.size(),
+                [&](const std::size_t first, const std::size_t last)
+                {
+                    EXPECT_LT(first, last);
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        visits[i].fetch_add(1, std::memory_order_relaxed);
+                    }
+                },
+                nullptr, grain);
+
+            for (std::size_t i = 0; i < visits.size(); ++i)
+            {
+                ASSERT_EQ(visits[i].load(), 1) << "index " << i << ", grain " << grain;
+            }
+        }
+    }
+
+    TEST(JobSystemTest, ParallelForOnAnEmptyRangeDoesNothing)
+    {
+        Core::JobSystem          jobs(withWorkers(1));
+        Core::JobSystem::Counter counter;
+        jobs.parallelFor(5, 5, [](std::size_t, std::size_t) { FAIL(); }, &counter);
+        EXPECT_TRUE(counter.isDone());
+    }
+
+    // Leaves the body's stack frame before any chunk is guaranteed to run
+    void spawnSum(Core::JobSystem& jobs, Core::JobSystem::Counter& counter, std::atomic<std::uint64_t>& sum)
+    {
+        std::vector<std::uint64_t> values(4096);
+        std::iota(values.begin(), values.end(), 0);
+        jobs.parallelFor(
+            0, values.size(),
+            [values, &sum](const std::size_t first, const std::size_t last)
+            {
+                std::uint64_t local = 0;
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    local += values[i];
+                }
+                sum.fetch_add(local, std::memory_order_relaxed);
+            },
+            &counter, 16);
+    }
+
+    TEST(JobSystemTest, ParallelForOwnsATemporaryBody)
+    {
+        Core::JobSystem jobs(withWorkers(3));
+        for (int frame = 0; frame < 50; ++frame)
+        {
+            Core::JobSystem::Counter   counter;
+            std::atomic<std::uint64_t> sum {0};
+            spawnSum(jobs, counter, sum);
+            jobs.wait(counter);
+            ASSERT_EQ(sum.load(), 4096ull * 4095 / 2);
+        }
+    }
+
+    TEST(JobSystemTest, StolenJobsReturnToTheSpawningThread)
+    {
+        Core::JobSystem jobs(withWorkers(3));
+        auto            frame = [&]
+        {
+            Core::JobSystem::Counter counter;
+            for (int i = 0; i < 8; ++i)
+            {
+                jobs.run([] { std::this_thread::yield(); }, &counter);
+            }
+            jobs.wait(counter);
+        };
+
+        frame();
+        const std::uint64_t warm = jobs.getStats().pooled;
+        for (int i = 0; i < 2000; ++i)
+        {
+            frame();
+        }
+        EXPECT_EQ(jobs.getStats().pooled, warm);
+    }
+
+    TEST(JobSystemTest, ForeignThreadsCannotSpawn)
+    {
+        Core::JobSystem jobs(withWorkers(1));
+        bool            threw = false;
+        std::thread     foreign(
+            [&]
+            {
+                try
+                {
+                    jobs.run([] {});
+                }
+                catch (const std::logic_error&)
+                {
+                    threw = true;
+                }
+            });
+        foreign.join();
+        EXPECT_TRUE(threw);
+    }
+} // namespace
@@ -0,0 +1,115 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "core/WorkStealingDeque.h"
+
+namespace
+{
+    TEST(WorkStealingDequeTest, RoundsCapacityUpToPowerOfTwo)
+    {
+        EXPECT_EQ(Core::WorkStealingDeque<int>(5).capacity(), 8u);
+        EXPECT_EQ(Core::WorkStealingDeque<int>(64).capacity(), 64u);
+    }
+
+    TEST(WorkStealingDequeTest, PopIsLifoAndStealIsFifo)
+    {
+        Core::WorkStealingDeque<int> deque(8);
+        int                          items[3] = {0, 1, 2};
+        for (int& item : items)
+        {
+            ASSERT_TRUE(deque.push(&item));
+        }
+
+        EXPECT_EQ(deque.steal(), &items[0]);
+        EXPECT_EQ(deque.pop(), &items[2]);
+        EXPECT_EQ(deque.pop(), &items[1]);
+        EXPECT_EQ(deque.pop(), nullptr);
+        EXPECT_EQ(deque.steal(), nullptr);
+        EXPECT_EQ(deque.size(), 0u);
+    }
+
+    TEST(WorkStealingDequeTest, PushFailsWhenFull)
+    {
+        Core::WorkStealingDeque<int> deque(4);
+        int                          item = 0;
+        for (std::size_t i = 0; i < deque.capacity(); ++i)
+        {
+            ASSERT_TRUE(deque.push(&item));
+        }
+        EXPECT_FALSE(deque.push(&item));
+
+        // Stealing frees a slot at the top
+        EXPECT_EQ(deque.steal(), &item);
+        EXPECT_TRUE(deque.push(&item));
+    }
+
+    TEST(WorkStealingDequeTest, EveryItemIsTakenExactlyOnceUnderContention)
+    {
+        constexpr int                kItems = 200000;
+        constexpr int                kThieves = 3;
+        Core::WorkStealingDeque<int> deque(256);
+        std::vector<int>             items(kItems);
+        std::vector<std::atomic<int>> taken(kItems);
+        std::atomic<bool>            done {false};
+
+        auto take = [&](const int* item)
+        {
+            taken[item - items.data()].fetch_add(1, std::memory_order_relaxed);
+        };
+
+        std::vector<std::thread> thieves;
+        for (int i = 0; i < kThieves; ++i)
+        {
+            thieves.emplace_back(
+                [&]
+                {
+                    while (!done.load(std::memory_order_acquire) || deque.size() > 0)
+                    {
+                        if (const int* item = deque.steal())
+                        {
+                            take(item);
+                        }
+                    }
+                });
+        }
+
+        // The owner alternates pushes and pops so the last-item race is hit often
+        for (int i = 0; i < kItems; ++i)
+        {
+            while (!deque.push(&items[i]))
+            {
+                if (const int* item = deque.pop())
+                {
+                    take(item);
+                }
+            }
+            if (i % 3 == 0)
+            {
+                if (const int* item = deque.pop())
+                {
+                    take(item);
+                }
+            }
+        }
+        while (const int* item = deque.pop())
+        {
+            take(item);
+        }
+        done.store(true, std::memory_order_release);
+
+        for (std::thread& thief : thieves)
+        {
+            thief.join();
+        }
+        for (int i = 0; i < kItems; ++i)
+        {
+            ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+        }
+    }
+} // namespace
@@ -0,0 +1,134 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "shader/preprocessor.h"
+
+namespace
+{
+    class ShaderPreprocessorTest : public ::testing::Test
+    {
+      protected:
+        std::filesystem::path m_root;
+
+        void SetUp() override
+        {
+            m_root = std::filesystem::temp_directory_path() /
+                     ("preprocessor_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_" +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+            std::filesystem::remove_all(m_root);
+            std::filesystem::create_directories(m_root);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(m_root);
+        }
+
+        std::filesystem::path write(const std::string& name, const std::string& text) const
+        {
+            const std::filesystem::path path = m_root / name;
+            std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+            return path;
+        }
+    };
+
+    TEST_F(ShaderPreprocessorTest, ExpandsIncludesAndInjectsDefines)
+    {
+        write("common.glsl", "float common;\n");
+        const std::filesystem::path main =
+            write("main.vert", "#version 410\n#include \"common.glsl\"\nvoid main() {}\n");
+
+        ShaderPreprocessor preprocessor(m_root);
+        EXPECT_EQ(preprocessor.process(main, {"SKINNED"}),
+                  "#version 410\n#define SKINNED\nfloat common;\nvoid main() {}\n");
+    }
+
+    TEST_F(ShaderPreprocessorTest, InvalidateReachesEveryIncluder)
+    {
+        const std::filesystem::path common = write("common.glsl", "float a;\n");
+        write("lighting.glsl", "#include \"common.glsl\"\n");
+        const std::filesystem::path main = write("main.frag", "#include \"lighting.glsl\"\n");
+
+        ShaderPreprocessor preprocessor(m_root);
+        EXPECT_EQ(preprocessor.process(main), "float a;\n");
+
+        write("common.glsl", "float b;\n");
+        EXPECT_EQ(preprocessor.process(main), "float a;\n") << "served from the memo until invalidated";
+
+        const std::vector<std::filesystem::path> invalidated = preprocessor.invalidate(common);
+        EXPECT_EQ(invalidated.size(), 3u);
+        EXPECT_EQ(preprocessor.process(main), "float b;\n");
+    }
+
+    TEST_F(ShaderPreprocessorTest, UnchangedSaveReusesTheExpansion)
+    {
+        const std::filesystem::path common = write("common.glsl", "float a;\n");
+        const std::filesystem::path main = write("main.frag", "#include \"common.glsl\"\n");
+
+        ShaderPreprocessor preprocessor(m_root);
+        preprocessor.process(main);
+        const ShaderPreprocessor::Stats before = preprocessor.getStats();
+
+        preprocessor.invalidate(common);
+        preprocessor.process(main);
+        const ShaderPreprocessor::Stats after = preprocessor.getStats();
+        EXPECT_EQ(after.expansions, before.expansions);
+        EXPECT_EQ(after.reuses, before.reuses + 2);
+    }
+
+    TEST_F(ShaderPreprocessorTest, ReportsCyclesAndMissingFiles)
+    {
+        write("a.glsl", "#include \"b.glsl\"\n");
+        write("b.glsl", "#include \"a.glsl\"\n");
+
+        ShaderPreprocessor preprocessor(m_root);
+        EXPECT_THROW(preprocessor.process(m_root / "a.glsl"), std::runtime_error);
+        EXPECT_THROW(preprocessor.process(m_root / "missing.glsl"), std::runtime_error);
+    }
+
+    TEST_F(ShaderPreprocessorTest, EditsDuringConcurrentExpansionAreNotLost)
+    {
+        const std::filesystem::path common = write("common.glsl", "// 0\n");
+        const std::filesystem::path main = write("main.frag", "#include \"common.glsl\"\nvoid main() {}\n");
+
+        ShaderPreprocessor       preprocessor(m_root);
+        std::atomic<bool>        done {false};
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 3; ++i)
+        {
+            readers.emplace_back(
+                [&]
+                {
+                    while (!done.load())
+                    {
+                        preprocessor.process(main);
+                    }
+                });
+        }
+
+        // The files are replaced, not rewritten, so a mapped reader never sees a torn file
+        for (int edit = 1; edit <= 200; ++edit)
+        {
+            const std::filesystem::path next = write("common.tmp", "// " + std::to_string(edit) + "\n");
+            std::filesystem::rename(next, common);
+            preprocessor.invalidate(common);
+        }
+        done.store(true);
+        for (std::thread& reader : readers)
+        {
+            reader.join();
+        }
+
+        EXPECT_EQ(preprocessor.process(main), "// 200\nvoid main() {}\n");
+    }
+} // namespace
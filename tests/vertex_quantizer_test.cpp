@@ -0,0 +1,216 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "vertex_quantizer.h"
+
+namespace
+{
+    // Counts that leave every possible tail after the 4- and 8-wide loops
+    constexpr std::size_t kCounts[] = {1, 3, 4, 7, 8, 9, 15, 16, 17, 1000};
+
+    std::vector<float> randomFloats(const std::size_t count, const float min, const float max, const unsigned seed)
+    {
+        std::mt19937                          random(seed);
+        std::uniform_real_distribution<float> distribution(min, max);
+        std::vector<float>                    values(count);
+        for (float& value : values)
+        {
+            value = distribution(random);
+        }
+        return values;
+    }
+
+    std::vector<float> randomUnitVectors(const std::size_t count, const unsigned seed)
+    {
+        std::vector<float> vectors = randomFloats(count * 3, -1.0f, 1.0f, seed);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            glm::vec3 v(vectors[i * 3], vectors[i * 3 + 1], vectors[i * 3 + 2]);
+            v = glm::length(v) > 1e-3f ? glm::normalize(v) : glm::vec3(0.0f, 0.0f, 1.0f);
+            std::memcpy(&vectors[i * 3], &v, sizeof(v));
+        }
+        return vectors;
+    }
+
+    // Same as octDecode() in shaders/quantized.glsl
+    glm::vec3 octDecode(const glm::vec2 e)
+    {
+        glm::vec3   n(e, 1.0f - std::abs(e.x) - std::abs(e.y));
+        const float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    // glm::packSnorm2x16 of the scalar octahedral mapping
+    glm::vec2 octEncodeReference(glm::vec3 n)
+    {
+        n /= std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        if (n.z >= 0.0f)
+        {
+            return {n.x, n.y};
+        }
+        return {(1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f)};
+    }
+
+    TEST(VertexQuantizerTest, PositionsMatchGlmAndRoundTripWithinHalfAStep)
+    {
+        for (const std::size_t count : kCounts)
+        {
+            const std::vector<float>              positions = randomFloats(count * 3, -50.0f, 120.0f, 1);
+            const VertexQuantizer::Bounds bounds = VertexQuantizer::computeBounds(positions.data(), count);
+            std::vector<std::uint64_t>            packed(count);
+            VertexQuantizer::quantizePositions(positions.data(), count, bounds, packed.data(), sizeof(std::uint64_t));
+
+            const glm::vec3 center = bounds.center();
+            const glm::vec3 extent = bounds.extent();
+            const glm::mat4 dequantize = bounds.dequantizeMatrix();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const glm::vec3 p(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]);
+                const glm::vec4 normalized((p - center) / extent, 1.0f);
+                const glm::vec4 expected = glm::unpackSnorm4x16(glm::packSnorm4x16(normalized));
+                const glm::vec4 actual = glm::unpackSnorm4x16(packed[i]);
+
+                // One unit apart at most: the SIMD paths round ties to even
+                for (int axis = 0; axis < 4; ++axis)
+                {
+                    ASSERT_NEAR(actual[axis], expected[axis], 1.0f / 32767.0f + 1e-7f) << "count " << count;
+                }
+                ASSERT_EQ(actual.w, 1.0f);
+
+                const glm::vec3 restored = glm::vec3(dequantize * actual);
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    ASSERT_LE(std::abs(restored[axis] - p[axis]), extent[axis] / 32767.0f * 0.5f + 1e-4f)
+                        << "vertex " << i << " axis " << axis;
+                }
+            }
+        }
+    }
+
+    TEST(VertexQuantizerTest, OctahedralMatchesGlmAndDecodesToTheSameDirection)
+    {
+        for (const std::size_t count : kCounts)
+        {
+            const std::vector<float>   normals = randomUnitVectors(count, 2);
+            std::vector<std::uint32_t> packed(count);
+            VertexQuantizer::encodeOctahedral(normals.data(), count, packed.data(), sizeof(std::uint32_t));
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const glm::vec3 n(normals[i * 3], normals[i * 3 + 1], normals[i * 3 + 2]);
+                const glm::vec2 expected = glm::unpackSnorm2x16(glm::packSnorm2x16(octEncodeReference(n)));
+                const glm::vec2 actual = glm::unpackSnorm2x16(packed[i]);
+                ASSERT_NEAR(actual.x, expected.x, 1.0f / 32767.0f + 1e-7f);
+                ASSERT_NEAR(actual.y, expected.y, 1.0f / 32767.0f + 1e-7f);
+
+                // Snorm16 octahedral error sits below what a float dot product can resolve (~0.03 degrees)
+                const double cosine = std::min(1.0, static_cast<double>(glm::dot(octDecode(actual), n)));
+                ASSERT_LT(glm::degrees(std::acos(cosine)), 0.05) << "vertex " << i;
+            }
+        }
+    }
+
+    TEST(VertexQuantizerTest, ZeroVectorsEncodeAsPositiveZ)
+    {
+        for (const std::size_t count : kCounts)
+        {
+            // Zeros at every other vertex, so both SIMD lanes and the scalar tail see them
+            std::vector<float> vectors = randomUnitVectors(count, 8);
+            for (std::size_t i = 0; i < count; i += 2)
+            {
+                vectors[i * 3] = vectors[i * 3 + 1] = vectors[i * 3 + 2] = 0.0f;
+            }
+            vectors[0] = -0.0f;
+
+            std::vector<std::uint32_t> packed(count);
+            VertexQuantizer::encodeOctahedral(vectors.data(), count, packed.data(), sizeof(std::uint32_t));
+
+            for (std::size_t i = 0; i < count; i += 2)
+            {
+                ASSERT_EQ(packed[i], 0u) << "count " << count << ", vertex " << i;
+                const glm::vec3 decoded = octDecode(glm::unpackSnorm2x16(packed[i]));
+                EXPECT_EQ(decoded, glm::vec3(0.0f, 0.0f, 1.0f));
+            }
+        }
+    }
+
+    TEST(VertexQuantizerTest, HalfUvsMatchGlmAndRoundTrip)
+    {
+        for (const std::size_t count : kCounts)
+        {
+            const std::vector<float>   uvs = randomFloats(count * 2, -4.0f, 4.0f, 3);
+            std::vector<std::uint32_t> packed(count);
+            VertexQuantizer::packHalf2(uvs.data(), count, packed.data(), sizeof(std::uint32_t));
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const glm::vec2 uv(uvs[i * 2], uvs[i * 2 + 1]);
+                const glm::vec2 expected = glm::unpackHalf2x16(glm::packHalf2x16(uv));
+                const glm::vec2 actual = glm::unpackHalf2x16(packed[i]);
+                for (int axis = 0; axis < 2; ++axis)
+                {
+                    // Half floats keep 11 significant bits; glm and F16C may round a tie apart
+                    const float ulp = std::ldexp(1.0f, std::ilogb(std::max(std::abs(uv[axis]), 6.1e-5f)) - 10);
+                    ASSERT_LE(std::abs(actual[axis] - expected[axis]), ulp);
+                    ASSERT_LE(std::abs(actual[axis] - uv[axis]), ulp * 0.5f + 1e-7f);
+                }
+            }
+        }
+    }
+
+    TEST(VertexQuantizerTest, QuantizeFillsInterleavedVertices)
+    {
+        constexpr std::size_t        kCount = 13;
+        const std::vector<float>     positions = randomFloats(kCount * 3, -1.0f, 1.0f, 4);
+        const std::vector<float>     normals = randomUnitVectors(kCount, 5);
+        const std::vector<float>     uvs = randomFloats(kCount * 2, 0.0f, 1.0f, 6);
+        std::vector<QuantizedVertex> vertices(kCount);
+
+        const VertexQuantizer::Bounds bounds =
+            VertexQuantizer::quantize(positions.data(), normals.data(), uvs.data(), kCount, vertices.data());
+
+        std::vector<std::uint64_t> expectedPositions(kCount);
+        std::vector<std::uint32_t> expectedNormals(kCount);
+        std::vector<std::uint32_t> expectedUvs(kCount);
+        VertexQuantizer::quantizePositions(positions.data(), kCount, bounds, expectedPositions.data(), 8);
+        VertexQuantizer::encodeOctahedral(normals.data(), kCount, expectedNormals.data(), 4);
+        VertexQuantizer::packHalf2(uvs.data(), kCount, expectedUvs.data(), 4);
+
+        for (std::size_t i = 0; i < kCount; ++i)
+        {
+            EXPECT_EQ(std::memcmp(vertices[i].position, &expectedPositions[i], 8), 0);
+            EXPECT_EQ(std::memcmp(vertices[i].normal, &expectedNormals[i], 4), 0);
+            EXPECT_EQ(std::memcmp(vertices[i].uv, &expectedUvs[i], 4), 0);
+        }
+    }
+
+    TEST(VertexQuantizerTest, MissingStreamsAreZeroed)
+    {
+        const std::vector<float>     positions = randomFloats(5 * 3, -1.0f, 1.0f, 7);
+        std::vector<QuantizedVertex> vertices(5);
+        std::memset(vertices.data(), 0xFF, vertices.size() * sizeof(QuantizedVertex));
+
+        VertexQuantizer::quantize(positions.data(), nullptr, nullptr, vertices.size(), vertices.data());
+        for (const QuantizedVertex& vertex : vertices)
+        {
+            EXPECT_EQ(vertex.normal[0], 0);
+            EXPECT_EQ(vertex.normal[1], 0);
+            EXPECT_EQ(vertex.uv[0], 0);
+            EXPECT_EQ(vertex.uv[1], 0);
+        }
+    }
+} // namespace
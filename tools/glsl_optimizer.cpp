@@ -0,0 +1,1304 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#include "glsl_optimizer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace
+{
+    // -------------------------------------------------------
+    // Lexing
+    // -------------------------------------------------------
+
+    enum class TokenKind
+    {
+        Identifier,
+        Number,
+        Punct,
+        Directive, ///< A whole preprocessor line.
+    };
+
+    struct Token
+    {
+        TokenKind   kind;
+        std::string text;
+    };
+
+    bool isIdentStart(const char c)
+    {
+        return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+    }
+
+    bool isIdentChar(const char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    }
+
+    // Longest first, so maximal munch is a linear scan
+    constexpr std::string_view kOperators[] = {
+        "<<=", ">>=", "++", "--", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<",
+        ">>",  "<=",  ">=", "==", "!=", "&&", "||", "^^",
+    };
+
+    size_t punctLength(const std::string_view text, const size_t at)
+    {
+        for (const std::string_view op : kOperators)
+        {
+            if (text.substr(at, op.size()) == op)
+            {
+                return op.size();
+            }
+        }
+        return 1;
+    }
+
+    size_t numberLength(const std::string_view text, const size_t at)
+    {
+        size_t end = at;
+        const bool hex = text.substr(at, 2) == "0x" || text.substr(at, 2) == "0X";
+        while (end < text.size())
+        {
+            const char c = text[end];
+            if (isIdentChar(c) || c == '.')
+            {
+                ++end;
+            }
+            else if ((c == '+' || c == '-') && !hex && (text[end - 1] == 'e' || text[end - 1] == 'E'))
+            {
+                ++end;
+            }
+            else
+            {
+                break;
+            }
+        }
+        return end - at;
+    }
+
+    /**
+     * @brief Splits code (no directives) into tokens, appending to @p out.
+     */
+    void tokenize(const std::string_view code, std::vector<Token>& out)
+    {
+        size_t i = 0;
+        while (i < code.size())
+        {
+            const char c = code[i];
+            if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                ++i;
+            }
+            else if (isIdentStart(c))
+            {
+                size_t end = i;
+                while (end < code.size() && isIdentChar(code[end]))
+                {
+                    ++end;
+                }
+                out.push_back({TokenKind::Identifier, std::string(code.substr(i, end - i))});
+                i = end;
+            }
+            else if (std::isdigit(static_cast<unsigned char>(c)) ||
+                     (c == '.' && i + 1 < code.size() && std::isdigit(static_cast<unsigned char>(code[i + 1]))))
+            {
+                const size_t length = numberLength(code, i);
+                out.push_back({TokenKind::Number, std::string(code.substr(i, length))});
+                i += length;
+            }
+            else
+            {
+                const size_t length = punctLength(code, i);
+                out.push_back({TokenKind::Punct, std::string(code.substr(i, length))});
+                i += length;
+            }
+        }
+    }
+
+    /**
+     * @brief Replaces comments with a space, keeping the newlines of block
+     *        comments so directive lines stay on their own line.
+     */
+    std::string stripComments(const std::string_view source)
+    {
+        std::string out;
+        out.reserve(source.size());
+
+        size_t i = 0;
+        while (i < source.size())
+        {
+            if (source.substr(i, 2) == "//")
+            {
+                while (i < source.size() && source[i] != '\n')
+                {
+                    ++i;
+                }
+                out.push_back(' ');
+            }
+            else if (source.substr(i, 2) == "/*")
+            {
+                i += 2;
+                while (i < source.size() && source.substr(i, 2) != "*/")
+                {
+                    if (source[i] == '\n')
+                    {
+                        out.push_back('\n');
+                    }
+                    ++i;
+                }
+                i = std::min(i + 2, source.size());
+                out.push_back(' ');
+            }
+            else if (source.substr(i, 2) == "\\\n")
+            {
+                i += 2; // line continuation
+            }
+            else
+            {
+                out.push_back(source[i++]);
+            }
+        }
+        return out;
+    }
+
+    std::string collapseWhitespace(const std::string_view text)
+    {
+        std::string out;
+        bool        space = false;
+        for (const char c : text)
+        {
+            if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                space = !out.empty();
+                continue;
+            }
+            if (space)
+            {
+                out.push_back(' ');
+            }
+            out.push_back(c);
+            space = false;
+        }
+        return out;
+    }
+
+    std::vector<std::string> identifiersIn(const std::string_view text)
+    {
+        std::vector<std::string> names;
+        size_t                   i = 0;
+        while (i < text.size())
+        {
+            if (isIdentStart(text[i]) && (i == 0 || !isIdentChar(text[i - 1])))
+            {
+                size_t end = i;
+                while (end < text.size() && isIdentChar(text[end]))
+                {
+                    ++end;
+                }
+                names.emplace_back(text.substr(i, end - i));
+                i = end;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        return names;
+    }
+
+    // -------------------------------------------------------
+    // Conditional folding
+    // -------------------------------------------------------
+
+    /**
+     * @brief What is known about macros at a point in the file.
+     *
+     * A macro is known to be defined (with its value, if object-like) or
+     * known to be undefined only when the file says so unconditionally.
+     * Everything else may be injected at runtime and stays unknown.
+     */
+    struct MacroState
+    {
+        std::map<std::string, std::optional<std::string>> defined; ///< nullopt for function-like macros.
+        std::set<std::string>                             undefined;
+    };
+
+    using Value = std::optional<long long>;
+
+    /**
+     * @brief Evaluates a #if expression; nullopt if it depends on unknown macros.
+     */
+    class ConditionEvaluator
+    {
+      public:
+        ConditionEvaluator(const MacroState& macros, const std::string_view expression, const int depth = 0)
+            : m_macros(macros)
+            , m_depth(depth)
+        {
+            tokenize(expression, m_tokens);
+        }
+
+        Value evaluate()
+        {
+            if (m_depth > 8)
+            {
+                return std::nullopt;
+            }
+            const Value value = conditional();
+            return m_pos == m_tokens.size() ? value : std::nullopt;
+        }
+
+      private:
+        const MacroState&  m_macros;
+        int                m_depth;
+        std::vector<Token> m_tokens;
+        size_t             m_pos = 0;
+
+        bool accept(const std::string_view text)
+        {
+            if (m_pos < m_tokens.size() && m_tokens[m_pos].kind == TokenKind::Punct && m_tokens[m_pos].text == text)
+            {
+                ++m_pos;
+                return true;
+            }
+            return false;
+        }
+
+        Value conditional()
+        {
+            const Value condition = logicalOr();
+            if (!accept("?"))
+            {
+                return condition;
+            }
+            const Value a = conditional();
+            if (!accept(":"))
+            {
+                return std::nullopt;
+            }
+            const Value b = conditional();
+            if (!condition)
+            {
+                return a && b && *a == *b ? a : std::nullopt;
+            }
+            return *condition ? a : b;
+        }
+
+        Value logicalOr()
+        {
+            Value left = logicalAnd();
+            while (accept("||"))
+            {
+                const Value right = logicalAnd();
+                if ((left && *left) || (right && *right))
+                {
+                    left = 1;
+                }
+                else if (left && right)
+                {
+                    left = 0;
+                }
+                else
+                {
+                    left = std::nullopt;
+                }
+            }
+            return left;
+        }
+
+        Value logicalAnd()
+        {
+            Value left = binary(0);
+            while (accept("&&"))
+            {
+                const Value right = binary(0);
+                if ((left && !*left) || (right && !*right))
+                {
+                    left = 0;
+                }
+                else if (left && right)
+                {
+                    left = 1;
+                }
+                else
+                {
+                    left = std::nullopt;
+                }
+            }
+            return left;
+        }
+
+        // Binary operators from loosest to tightest, below && and ||
+        Value binary(const int level)
+        {
+            static const std::vector<std::vector<std::string_view>> kLevels = {
+                {"|"}, {"^"}, {"&"}, {"==", "!="}, {"<", ">", "<=", ">="}, {"<<", ">>"}, {"+", "-"}, {"*", "/", "%"},
+            };
+            if (level == static_cast<int>(kLevels.size()))
+            {
+                return unary();
+            }
+
+            Value left = binary(level + 1);
+            for (;;)
+            {
+                std::string_view op;
+                for (const std::string_view candidate : kLevels[level])
+                {
+                    if (accept(candidate))
+                    {
+                        op = candidate;
+                        break;
+                    }
+                }
+                if (op.empty())
+                {
+                    return left;
+                }
+
+                const Value right = binary(level + 1);
+                left = apply(op, left, right);
+            }
+        }
+
+        static Value apply(const std::string_view op, const Value a, const Value b)
+        {
+            if (!a || !b)
+            {
+                return std::nullopt;
+            }
+            if (op == "|")
+            {
+                return *a | *b;
+            }
+            if (op == "^")
+            {
+                return *a ^ *b;
+            }
+            if (op == "&")
+            {
+                return *a & *b;
+            }
+            if (op == "==")
+            {
+                return *a == *b;
+            }
+            if (op == "!=")
+            {
+                return *a != *b;
+            }
+            if (op == "<")
+            {
+                return *a < *b;
+            }
+            if (op == ">")
+            {
+                return *a > *b;
+            }
+            if (op == "<=")
+            {
+                return *a <= *b;
+            }
+            if (op == ">=")
+            {
+                return *a >= *b;
+            }
+            if (op == "<<")
+            {
+                return *b >= 0 && *b < 63 ? Value(*a << *b) : std::nullopt;
+            }
+            if (op == ">>")
+            {
+                return *b >= 0 && *b < 63 ? Value(*a >> *b) : std::nullopt;
+            }
+            if (op == "+")
+            {
+                return *a + *b;
+            }
+            if (op == "-")
+            {
+                return *a - *b;
+            }
+            if (op == "*")
+            {
+                return *a * *b;
+            }
+            if (*b == 0)
+            {
+                return std::nullopt;
+            }
+            if (op == "/")
+            {
+                return *a / *b;
+            }
+            return *a % *b;
+        }
+
+        Value unary()
+        {
+            if (accept("!"))
+            {
+                const Value value = unary();
+                return value ? Value(!*value) : std::nullopt;
+            }
+            if (accept("-"))
+            {
+                const Value value = unary();
+                return value ? Value(-*value) : std::nullopt;
+            }
+            if (accept("~"))
+            {
+                const Value value = unary();
+                return value ? Value(~*value) : std::nullopt;
+            }
+            if (accept("+"))
+            {
+                return unary();
+            }
+            return primary();
+        }
+
+        Value primary()
+        {
+            if (m_pos >= m_tokens.size())
+            {
+                return std::nullopt;
+            }
+
+            if (accept("("))
+            {
+                const Value value = conditional();
+                return accept(")") ? value : std::nullopt;
+            }
+
+            const Token& token = m_tokens[m_pos++];
+            if (token.kind == TokenKind::Number)
+            {
+                std::string digits = token.text;
+                while (!digits.empty() && (digits.back() == 'u' || digits.back() == 'U'))
+                {
+                    digits.pop_back();
+                }
+                try
+                {
+                    const bool leadingZero = digits.size() > 1 && digits[0] == '0';
+                    const bool hex         = leadingZero && (digits[1] == 'x' || digits[1] == 'X');
+                    size_t     used        = 0;
+                    const int  base        = hex ? 16 : leadingZero ? 8 : 10;
+                    const long long value = std::stoll(digits, &used, base);
+                    return used == digits.size() ? Value(value) : std::nullopt;
+                }
+                catch (const std::exception&)
+                {
+                    return std::nullopt;
+                }
+            }
+
+            if (token.kind != TokenKind::Identifier)
+            {
+                return std::nullopt;
+            }
+
+            if (token.text == "defined")
+            {
+                const bool parens = accept("(");
+                if (m_pos >= m_tokens.size() || m_tokens[m_pos].kind != TokenKind::Identifier)
+                {
+                    return std::nullopt;
+                }
+                const std::string& name = m_tokens[m_pos++].text;
+                if (parens && !accept(")"))
+                {
+                    return std::nullopt;
+                }
+                return isDefined(name);
+            }
+
+            if (const auto it = m_macros.defined.find(token.text); it != m_macros.defined.end())
+            {
+                if (!it->second || it->second->empty())
+                {
+                    return std::nullopt;
+                }
+                return ConditionEvaluator(m_macros, *it->second, m_depth + 1).evaluate();
+            }
+            if (m_macros.undefined.contains(token.text))
+            {
+                return 0;
+            }
+            return std::nullopt;
+        }
+
+        Value isDefined(const std::string& name) const
+        {
+            if (m_macros.defined.contains(name))
+            {
+                return 1;
+            }
+            if (m_macros.undefined.contains(name))
+            {
+                return 0;
+            }
+            return std::nullopt;
+        }
+    };
+
+    struct Directive
+    {
+        std::string keyword;
+        std::string rest;
+    };
+
+    std::optional<Directive> parseDirective(const std::string_view line)
+    {
+        const size_t hash = line.find_first_not_of(" \t\r");
+        if (hash == std::string_view::npos || line[hash] != '#')
+        {
+            return std::nullopt;
+        }
+
+        size_t       i     = line.find_first_not_of(" \t", hash + 1);
+        const size_t start = i == std::string_view::npos ? line.size() : i;
+        i = start;
+        while (i < line.size() && isIdentChar(line[i]))
+        {
+            ++i;
+        }
+
+        Directive directive;
+        directive.keyword = std::string(line.substr(start, i - start));
+        directive.rest    = collapseWhitespace(line.substr(i));
+        return directive;
+    }
+
+    /**
+     * @brief Folds the conditionals that can be decided now and turns the
+     *        rest into tokens, one Directive token per surviving directive line.
+     */
+    std::vector<Token> foldConditionals(const std::string& source, const GlslOptimizer::Options& options,
+                                        size_t& folded)
+    {
+        enum class Frame
+        {
+            Keep,     ///< Undecidable; its directives are kept and every branch is emitted.
+            Taking,   ///< Folded, inside the branch that is taken.
+            Skipping, ///< Folded, no branch taken yet.
+            Done,     ///< Folded, a previous branch was taken.
+            Dead,     ///< Nested inside a branch that is dropped.
+        };
+
+        MacroState macros;
+        for (const auto& [name, value] : options.defines)
+        {
+            macros.defined[name] = value;
+        }
+
+        std::vector<Frame> frames;
+        std::vector<Token> tokens;
+
+        const auto active = [&] {
+            return std::all_of(frames.begin(), frames.end(),
+                               [](const Frame f) { return f == Frame::Keep || f == Frame::Taking; });
+        };
+        const auto insideKeep = [&] { return std::find(frames.begin(), frames.end(), Frame::Keep) != frames.end(); };
+        const auto emit = [&](const std::string& keyword, const std::string& rest) {
+            tokens.push_back({TokenKind::Directive, "#" + keyword + (rest.empty() ? "" : " " + rest)});
+        };
+        const auto evaluate = [&](const Directive& directive) -> Value {
+            if (!options.foldConditionals)
+            {
+                return std::nullopt;
+            }
+            if (directive.keyword == "ifdef")
+            {
+                return ConditionEvaluator(macros, "defined(" + directive.rest + ")").evaluate();
+            }
+            if (directive.keyword == "ifndef")
+            {
+                return ConditionEvaluator(macros, "!defined(" + directive.rest + ")").evaluate();
+            }
+            return ConditionEvaluator(macros, directive.rest).evaluate();
+        };
+
+        size_t lineStart = 0;
+        while (lineStart <= source.size())
+        {
+            size_t lineEnd = source.find('\n', lineStart);
+            if (lineEnd == std::string::npos)
+            {
+                lineEnd = source.size();
+            }
+            const std::string_view line(source.data() + lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 1;
+
+            const std::optional<Directive> directive = parseDirective(line);
+            if (!directive)
+            {
+                if (active())
+                {
+                    tokenize(line, tokens);
+                }
+                continue;
+            }
+
+            const std::string& keyword = directive->keyword;
+            if (keyword == "if" || keyword == "ifdef" || keyword == "ifndef")
+            {
+                if (!active())
+                {
+                    frames.push_back(Frame::Dead);
+                    continue;
+                }
+                const Value condition = evaluate(*directive);
+                if (condition)
+                {
+                    frames.push_back(*condition ? Frame::Taking : Frame::Skipping);
+                    ++folded;
+                }
+                else
+                {
+                    frames.push_back(Frame::Keep);
+                    emit(keyword, directive->rest);
+                }
+            }
+            else if (keyword == "elif" || keyword == "else")
+            {
+                if (frames.empty())
+                {
+                    emit(keyword, directive->rest);
+                    continue;
+                }
+                Frame& frame = frames.back();
+                switch (frame)
+                {
+                    case Frame::Keep:
+                        emit(keyword, directive->rest);
+                        break;
+                    case Frame::Taking:
+                        frame = Frame::Done;
+                        break;
+                    case Frame::Skipping:
+                    {
+                        const Value condition = keyword == "else" ? Value(1) : evaluate(*directive);
+                        if (condition)
+                        {
+                            frame = *condition ? Frame::Taking : Frame::Skipping;
+                        }
+                        else
+                        {
+                            // Earlier branches were all false and dropped, so this one opens the block
+                            frame = Frame::Keep;
+                            emit("if", directive->rest);
+                        }
+                        break;
+                    }
+                    case Frame::Done:
+                    case Frame::Dead:
+                        break;
+                }
+            }
+            else if (keyword == "endif")
+            {
+                if (frames.empty() || frames.back() == Frame::Keep)
+                {
+                    emit(keyword, directive->rest);
+                }
+                if (!frames.empty())
+                {
+                    frames.pop_back();
+                }
+            }
+            else if (active())
+            {
+                if (keyword == "define" || keyword == "undef")
+                {
+                    size_t nameEnd = 0;
+                    while (nameEnd < directive->rest.size() && isIdentChar(directive->rest[nameEnd]))
+                    {
+                        ++nameEnd;
+                    }
+                    const std::string name = directive->rest.substr(0, nameEnd);
+
+                    macros.defined.erase(name);
+                    macros.undefined.erase(name);
+                    if (!insideKeep())
+                    {
+                        if (keyword == "undef")
+                        {
+                            macros.undefined.insert(name);
+                        }
+                        else if (nameEnd < directive->rest.size() && directive->rest[nameEnd] == '(')
+                        {
+                            macros.defined[name] = std::nullopt;
+                        }
+                        else
+                        {
+                            macros.defined[name] = collapseWhitespace(directive->rest.substr(nameEnd));
+                        }
+                    }
+                }
+                emit(keyword, directive->rest);
+            }
+        }
+        return tokens;
+    }
+
+    // -------------------------------------------------------
+    // Functions
+    // -------------------------------------------------------
+
+    struct Function
+    {
+        std::string name;
+        size_t      start;      ///< First token of the return type.
+        size_t      nameIndex;
+        size_t      paramsOpen;
+        size_t      paramsClose;
+        size_t      end;        ///< Closing '}' or the prototype's ';'.
+        bool        definition;
+        bool        pinned;     ///< Range holds a directive; never removed.
+    };
+
+    bool isPunct(const std::vector<Token>& tokens, const size_t i, const std::string_view text)
+    {
+        return i < tokens.size() && tokens[i].kind == TokenKind::Punct && tokens[i].text == text;
+    }
+
+    size_t matching(const std::vector<Token>& tokens, size_t i, const std::string_view open,
+                    const std::string_view close)
+    {
+        int depth = 0;
+        for (; i < tokens.size(); ++i)
+        {
+            if (isPunct(tokens, i, open))
+            {
+                ++depth;
+            }
+            else if (isPunct(tokens, i, close) && --depth == 0)
+            {
+                return i;
+            }
+        }
+        return tokens.size();
+    }
+
+    std::vector<Function> findFunctions(const std::vector<Token>& tokens)
+    {
+        std::vector<Function> functions;
+        size_t                statementStart = 0;
+        int                   depth          = 0;
+
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            const Token& token = tokens[i];
+            if (token.kind == TokenKind::Directive)
+            {
+                if (depth == 0)
+                {
+                    statementStart = i + 1;
+                }
+                continue;
+            }
+            if (token.kind == TokenKind::Punct)
+            {
+                if (token.text == "{")
+                {
+                    ++depth;
+                }
+                else if (token.text == "}")
+                {
+                    --depth;
+                }
+                if (depth == 0 && (token.text == ";" || (token.text == "}" && !isPunct(tokens, i + 1, ";"))))
+                {
+                    statementStart = i + 1;
+                }
+                continue;
+            }
+
+            // name '(' preceded by a return type at file scope
+            if (depth != 0 || token.kind != TokenKind::Identifier || !isPunct(tokens, i + 1, "(") || i == 0 ||
+                i == statementStart ||
+                !(tokens[i - 1].kind == TokenKind::Identifier || isPunct(tokens, i - 1, "]")))
+            {
+                continue;
+            }
+
+            const size_t close = matching(tokens, i + 1, "(", ")");
+            if (close >= tokens.size())
+            {
+                break;
+            }
+
+            Function function {token.text, statementStart, i, i + 1, close, close, false, false};
+            if (isPunct(tokens, close + 1, "{"))
+            {
+                function.definition = true;
+                function.end        = matching(tokens, close + 1, "{", "}");
+                if (function.end >= tokens.size())
+                {
+                    break;
+                }
+            }
+            else if (isPunct(tokens, close + 1, ";"))
+            {
+                function.end = close + 1;
+            }
+            else
+            {
+                continue;
+            }
+
+            for (size_t k = function.start; k <= function.end; ++k)
+            {
+                function.pinned = function.pinned || tokens[k].kind == TokenKind::Directive;
+            }
+            functions.push_back(function);
+            i              = function.end;
+            statementStart = function.end + 1;
+        }
+        return functions;
+    }
+
+    /**
+     * @brief Names that must keep their spelling: everything outside function
+     *        ranges, everything a directive mentions and every member access.
+     */
+    std::set<std::string> protectedNames(const std::vector<Token>& tokens, const std::vector<Function>& functions)
+    {
+        std::vector<bool> inFunction(tokens.size(), false);
+        for (const Function& function : functions)
+        {
+            std::fill(inFunction.begin() + static_cast<std::ptrdiff_t>(function.start),
+                      inFunction.begin() + static_cast<std::ptrdiff_t>(function.end) + 1, true);
+        }
+
+        std::set<std::string> names;
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            const Token& token = tokens[i];
+            if (token.kind == TokenKind::Directive)
+            {
+                for (std::string& name : identifiersIn(token.text))
+                {
+                    names.insert(std::move(name));
+                }
+            }
+            else if (token.kind == TokenKind::Identifier && (!inFunction[i] || isPunct(tokens, i - 1, ".")))
+            {
+                names.insert(token.text);
+            }
+        }
+        return names;
+    }
+
+    std::vector<Token> removeDeadFunctions(const std::vector<Token>& tokens, size_t& removed)
+    {
+        const std::vector<Function> functions = findFunctions(tokens);
+        const std::set<std::string> roots     = protectedNames(tokens, functions);
+
+        std::map<std::string, std::vector<const Function*>> byName;
+        for (const Function& function : functions)
+        {
+            byName[function.name].push_back(&function);
+        }
+
+        std::set<std::string>    reachable;
+        std::vector<std::string> work;
+        const auto reach = [&](const std::string& name) {
+            if (byName.contains(name) && reachable.insert(name).second)
+            {
+                work.push_back(name);
+            }
+        };
+
+        reach("main");
+        for (const Function& function : functions)
+        {
+            if (function.pinned || roots.contains(function.name))
+            {
+                reach(function.name);
+            }
+        }
+
+        while (!work.empty())
+        {
+            const std::string name = std::move(work.back());
+            work.pop_back();
+            for (const Function* function : byName[name])
+            {
+                for (size_t k = function->start; k <= function->end; ++k)
+                {
+                    if (k != function->nameIndex && tokens[k].kind == TokenKind::Identifier)
+                    {
+                        reach(tokens[k].text);
+                    }
+                }
+            }
+        }
+
+        std::vector<bool> drop(tokens.size(), false);
+        for (const Function& function : functions)
+        {
+            if (reachable.contains(function.name))
+            {
+                continue;
+            }
+            removed += function.definition ? 1 : 0;
+            std::fill(drop.begin() + static_cast<std::ptrdiff_t>(function.start),
+                      drop.begin() + static_cast<std::ptrdiff_t>(function.end) + 1, true);
+        }
+
+        std::vector<Token> kept;
+        kept.reserve(tokens.size());
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            if (!drop[i])
+            {
+                kept.push_back(tokens[i]);
+            }
+        }
+        return kept;
+    }
+
+    // -------------------------------------------------------
+    // Identifier minification
+    // -------------------------------------------------------
+
+    bool isTypeName(const std::string& name, const std::set<std::string>& structs)
+    {
+        static const std::set<std::string> kTypes = {
+            "void",   "bool",   "int",    "uint",   "float",  "double", "vec2",   "vec3",   "vec4",
+            "dvec2",  "dvec3",  "dvec4",  "bvec2",  "bvec3",  "bvec4",  "ivec2",  "ivec3",  "ivec4",
+            "uvec2",  "uvec3",  "uvec4",  "mat2",   "mat3",   "mat4",   "mat2x2", "mat2x3", "mat2x4",
+            "mat3x2", "mat3x3", "mat3x4", "mat4x2", "mat4x3", "mat4x4", "dmat2",  "dmat3",  "dmat4",
+        };
+        static const std::string_view kOpaquePrefixes[] = {"sampler", "isampler", "usampler",
+                                                          "image",   "iimage",   "uimage"};
+
+        if (kTypes.contains(name) || structs.contains(name))
+        {
+            return true;
+        }
+        return std::any_of(std::begin(kOpaquePrefixes), std::end(kOpaquePrefixes),
+                           [&](const std::string_view prefix) { return name.starts_with(prefix); });
+    }
+
+    bool isQualifier(const std::string& name)
+    {
+        static const std::set<std::string> kQualifiers = {"const", "in",    "out",     "inout",     "highp",
+                                                          "mediump", "lowp", "precise", "invariant", "flat",
+                                                          "smooth",  "noperspective"};
+        return kQualifiers.contains(name);
+    }
+
+    /**
+     * @brief Collects the names declared by a parameter list or a declaration
+     *        statement starting at @p i, in order of appearance.
+     */
+    void collectParameters(const std::vector<Token>& tokens, const Function& function,
+                           const std::set<std::string>& structs, std::vector<size_t>& declared)
+    {
+        size_t paramStart = function.paramsOpen + 1;
+        int    depth      = 0;
+        for (size_t k = paramStart; k <= function.paramsClose; ++k)
+        {
+            if (isPunct(tokens, k, "(") || isPunct(tokens, k, "["))
+            {
+                ++depth;
+            }
+            else if ((isPunct(tokens, k, ")") || isPunct(tokens, k, "]")) && depth > 0)
+            {
+                --depth;
+            }
+            else if (depth == 0 && (isPunct(tokens, k, ",") || k == function.paramsClose))
+            {
+                // The name is the last identifier before an optional array suffix,
+                // provided a type precedes it
+                size_t end = k;
+                if (end > paramStart && isPunct(tokens, end - 1, "]"))
+                {
+                    while (end > paramStart && !isPunct(tokens, end - 1, "["))
+                    {
+                        --end;
+                    }
+                    --end;
+                }
+                if (end >= paramStart + 2 && tokens[end - 1].kind == TokenKind::Identifier &&
+                    !isTypeName(tokens[end - 1].text, structs) && !isQualifier(tokens[end - 1].text))
+                {
+                    declared.push_back(end - 1);
+                }
+                paramStart = k + 1;
+            }
+        }
+    }
+
+    void collectLocals(const std::vector<Token>& tokens, const Function& function, const std::set<std::string>& structs,
+                       std::vector<size_t>& declared)
+    {
+        const size_t bodyOpen = function.paramsClose + 1;
+        for (size_t k = bodyOpen + 1; k < function.end; ++k)
+        {
+            const bool statementStart = isPunct(tokens, k - 1, "{") || isPunct(tokens, k - 1, ";") ||
+                                        isPunct(tokens, k - 1, "}") || tokens[k - 1].kind == TokenKind::Directive ||
+                                        (isPunct(tokens, k - 1, "(") && k >= 2 && tokens[k - 2].text == "for");
+            if (!statementStart)
+            {
+                continue;
+            }
+
+            size_t i = k;
+            while (i < function.end && tokens[i].kind == TokenKind::Identifier && isQualifier(tokens[i].text))
+            {
+                ++i;
+            }
+            if (i >= function.end || tokens[i].kind != TokenKind::Identifier || !isTypeName(tokens[i].text, structs))
+            {
+                continue;
+            }
+            ++i;
+            if (isPunct(tokens, i, "["))
+            {
+                i = matching(tokens, i, "[", "]") + 1;
+            }
+
+            // type name [= init] {, name [= init]} ;
+            while (i < function.end && tokens[i].kind == TokenKind::Identifier)
+            {
+                declared.push_back(i);
+                int depth = 0;
+                for (++i; i < function.end; ++i)
+                {
+                    if (isPunct(tokens, i, "(") || isPunct(tokens, i, "[") || isPunct(tokens, i, "{"))
+                    {
+                        ++depth;
+                    }
+                    else if (isPunct(tokens, i, ")") || isPunct(tokens, i, "]") || isPunct(tokens, i, "}"))
+                    {
+                        --depth;
+                    }
+                    else if (depth == 0 && (isPunct(tokens, i, ",") || isPunct(tokens, i, ";")))
+                    {
+                        break;
+                    }
+                    if (depth < 0)
+                    {
+                        break;
+                    }
+                }
+                if (!isPunct(tokens, i, ","))
+                {
+                    break;
+                }
+                ++i;
+            }
+        }
+    }
+
+    std::string shortName(size_t index)
+    {
+        std::string name;
+        do
+        {
+            name.insert(name.begin(), static_cast<char>('a' + index % 26));
+            index /= 26;
+        } while (index-- > 0);
+        return "_" + name;
+    }
+
+    size_t minifyIdentifiers(std::vector<Token>& tokens)
+    {
+        const std::vector<Function> functions = findFunctions(tokens);
+        std::set<std::string>       fixed     = protectedNames(tokens, functions);
+
+        std::set<std::string> userFunctions;
+        for (const Function& function : functions)
+        {
+            userFunctions.insert(function.name);
+        }
+
+        std::set<std::string> structs;
+        std::set<std::string> existing;
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            if (tokens[i].kind == TokenKind::Identifier)
+            {
+                existing.insert(tokens[i].text);
+            }
+
+            // A local may shadow a built-in function, e.g. `float length`; calls
+            // to the built-in elsewhere must keep the name
+            if (tokens[i].kind == TokenKind::Identifier && isPunct(tokens, i + 1, "(") &&
+                !userFunctions.contains(tokens[i].text))
+            {
+                fixed.insert(tokens[i].text);
+            }
+            if (tokens[i].text == "struct" && i + 1 < tokens.size() && tokens[i + 1].kind == TokenKind::Identifier)
+            {
+                structs.insert(tokens[i + 1].text);
+            }
+        }
+
+        std::vector<size_t> declared;
+        for (const Function& function : functions)
+        {
+            declared.push_back(function.nameIndex);
+            collectParameters(tokens, function, structs, declared);
+            if (function.definition)
+            {
+                collectLocals(tokens, function, structs, declared);
+            }
+        }
+        std::sort(declared.begin(), declared.end());
+
+        // First declaration order keeps the mapping, and so the output, stable
+        std::map<std::string, std::string> renames;
+        size_t                             next = 0;
+        for (const size_t index : declared)
+        {
+            const std::string& name = tokens[index].text;
+            if (name == "main" || name.starts_with("gl_") || fixed.contains(name) || renames.contains(name))
+            {
+                continue;
+            }
+
+            std::string replacement;
+            do
+            {
+                replacement = shortName(next++);
+            } while (existing.contains(replacement));
+
+            if (replacement.size() < name.size())
+            {
+                renames.emplace(name, std::move(replacement));
+            }
+        }
+
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            if (tokens[i].kind != TokenKind::Identifier || isPunct(tokens, i - 1, "."))
+            {
+                continue;
+            }
+            if (const auto it = renames.find(tokens[i].text); it != renames.end())
+            {
+                tokens[i].text = it->second;
+            }
+        }
+        return renames.size();
+    }
+
+    // -------------------------------------------------------
+    // Output
+    // -------------------------------------------------------
+
+    bool needsSpace(const std::string& previous, const std::string& next)
+    {
+        if (previous.empty() || next.empty())
+        {
+            return false;
+        }
+        if (isIdentChar(previous.back()) && isIdentChar(next.front()))
+        {
+            return true;
+        }
+
+        // Operators that would merge into a different token, e.g. "- -" or "/ *"
+        const std::string joined = previous + next.front();
+        if (joined.ends_with("//") || joined.ends_with("/*"))
+        {
+            return true;
+        }
+        return !isIdentChar(previous.back()) && punctLength(joined, 0) > previous.size();
+    }
+
+    std::string emit(const std::vector<Token>& tokens)
+    {
+        std::string out;
+        std::string previous;
+        int         depth = 0;
+
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            const Token& token = tokens[i];
+            if (token.kind == TokenKind::Directive)
+            {
+                if (!out.empty() && out.back() != '\n')
+                {
+                    out.push_back('\n');
+                }
+                out += token.text;
+                out.push_back('\n');
+                previous.clear();
+                continue;
+            }
+
+            if (needsSpace(previous, token.text))
+            {
+                out.push_back(' ');
+            }
+            out += token.text;
+            previous = token.text;
+
+            if (token.text == "{")
+            {
+                ++depth;
+            }
+            else if (token.text == "}")
+            {
+                --depth;
+            }
+
+            // One declaration per line keeps driver error messages readable
+            if (depth == 0 && (token.text == ";" || (token.text == "}" && !isPunct(tokens, i + 1, ";"))))
+            {
+                out.push_back('\n');
+                previous.clear();
+            }
+        }
+
+        if (!out.empty() && out.back() != '\n')
+        {
+            out.push_back('\n');
+        }
+        return out;
+    }
+} // namespace
+
+GlslOptimizer::GlslOptimizer()
+    : GlslOptimizer(Options {})
+{}
+
+GlslOptimizer::GlslOptimizer(Options options)
+    : m_options(std::move(options))
+{}
+
+std::string GlslOptimizer::optimize(const std::string_view source, Stats* stats) const
+{
+    Stats local;
+    local.inputBytes = source.size();
+
+    std::vector<Token> tokens = foldConditionals(stripComments(source), m_options, local.foldedConditionals);
+    if (m_options.stripDeadFunctions)
+    {
+        tokens = removeDeadFunctions(tokens, local.removedFunctions);
+    }
+    if (m_options.minifyIdentifiers)
+    {
+        local.renamedIdentifiers = minifyIdentifiers(tokens);
+    }
+
+    std::string out = emit(tokens);
+    local.outputBytes = out.size();
+    if (stats)
+    {
+        *stats = local;
+    }
+    return out;
+}
@@ -0,0 +1,69 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+#ifndef LEARNOPENGL_GLSL_OPTIMIZER_H
+#define LEARNOPENGL_GLSL_OPTIMIZER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Source-to-source GLSL shrinker run by shader_embed at build time.
+ *
+ * The driver's front end scales with the text it is handed, so this pass
+ * removes what it would otherwise parse and throw away:
+ *  - comments and redundant whitespace;
+ *  - #if / #ifdef / #ifndef blocks whose condition depends only on macros
+ *    the file itself (or Options::defines) defines or #undefs. Macros the
+ *    file does not mention may still be injected at runtime as variant
+ *    defines, so conditions on them are kept untouched;
+ *  - functions that main() cannot reach;
+ *  - the names of functions, parameters and locals, which are renamed to
+ *    short `_x` identifiers. Anything visible outside a function body —
+ *    uniforms, inputs, outputs, blocks, struct members — and every name a
+ *    directive mentions keeps its spelling, so reflection and variant
+ *    defines see the same interface.
+ *
+ * The output depends only on the input text and the options, so unchanged
+ * shaders produce byte-identical output and program binary cache keys stay
+ * valid across builds.
+ */
+class GlslOptimizer
+{
+  public:
+    struct Options
+    {
+        bool foldConditionals   = true;
+        bool stripDeadFunctions = true;
+        bool minifyIdentifiers  = true;
+
+        /// Macros known at build time, as name / value pairs.
+        std::vector<std::pair<std::string, std::string>> defines;
+    };
+
+    struct Stats
+    {
+        std::size_t inputBytes         = 0;
+        std::size_t outputBytes        = 0;
+        std::size_t foldedConditionals = 0;
+        std::size_t removedFunctions   = 0;
+        std::size_t renamedIdentifiers = 0;
+    };
+
+    GlslOptimizer();
+    explicit GlslOptimizer(Options options);
+
+    /**
+     * @brief Returns the optimized form of one fully #include-expanded shader.
+     */
+    std::string optimize(std::string_view source, Stats* stats = nullptr) const;
+
+  private:
+    Options m_options;
+};
+
+#endif // LEARNOPENGL_GLSL_OPTIMIZER_H
@@ -0,0 +1,269 @@
+//
+// Created by pieandcoffe on 17/10/2026.
+//
+
+// Build-time tool: expands every shader under a directory with
+// ShaderPreprocessor, shrinks each stage with GlslOptimizer, optionally
+// validates the result with glslangValidator, and writes a header holding
+// it as constexpr data sorted by path.
+//
+//   shader_embed <shader dir> <output header> [--no-optimize] [--validator <glslangValidator>]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "glsl_optimizer.h"
+#include "shader/preprocessor.h"
+
+namespace
+{
+    struct Shader
+    {
+        std::string key; ///< "<dir name>/<relative path>", the path ShaderStage is given.
+        std::string source;
+        std::filesystem::path file;
+        std::uintmax_t fileBytes; ///< Size of the file itself, before #include expansion.
+    };
+
+    bool isStageExtension(const std::string& extension)
+    {
+        return extension == ".vert" || extension == ".frag" || extension == ".geom" || extension == ".tesc" ||
+               extension == ".tese" || extension == ".comp";
+    }
+
+    bool isShaderExtension(const std::string& extension)
+    {
+        return isStageExtension(extension) || extension == ".glsl";
+    }
+
+    /**
+     * @brief Emits @p text as a sequence of C++ string literals, one per line.
+     */
+    void writeLiteral(std::ostream& out, const std::string_view text)
+    {
+        if (text.empty())
+        {
+            out << "\"\"";
+            return;
+        }
+
+        bool lineStart = true;
+        for (const char c : text)
+        {
+            if (lineStart)
+            {
+                out << "\n        \"";
+                lineStart = false;
+            }
+            switch (c)
+            {
+                case '\\': out << "\\\\"; break;
+                case '"': out << "\\\""; break;
+                case '\t': out << "\\t"; break;
+                case '\r': out << "\\r"; break;
+                case '\n':
+                    out << "\\n\"";
+                    lineStart = true;
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20 || static_cast<unsigned char>(c) >= 0x7F)
+                    {
+                        // Three octal digits never merge with a following character
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\%03o", static_cast<unsigned char>(c));
+                        out << escaped;
+                    }
+                    else
+                    {
+                        out << c;
+                    }
+            }
+        }
+        if (!lineStart)
+        {
+            out << '"';
+        }
+    }
+
+    /**
+     * @brief Runs glslangValidator on the expanded source. Includes are
+     *        already pasted in, so the validator never sees #include.
+     */
+    bool validate(const std::string& validator, const Shader& shader, const std::filesystem::path& scratch)
+    {
+        const std::filesystem::path file = scratch / ("validate" + shader.file.extension().string());
+        {
+            std::ofstream out(file, std::ios::binary | std::ios::trunc);
+            out << shader.source;
+        }
+
+        const std::string command = "\"" + validator + "\" \"" + file.string() + "\"";
+        if (std::system(command.c_str()) != 0)
+        {
+            std::cerr << "[shader_embed] " << shader.key << " failed validation" << std::endl;
+            return false;
+        }
+        return true;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> positional;
+    std::string              validator;
+    bool                     optimize = true;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (argument == "--validator" && i + 1 < argc)
+        {
+            validator = argv[++i];
+        }
+        else if (argument == "--no-optimize")
+        {
+            optimize = false;
+        }
+        else
+        {
+            positional.emplace_back(argument);
+        }
+    }
+
+    if (positional.size() != 2)
+    {
+        std::cerr << "usage: shader_embed <shader dir> <output header> [--no-optimize] "
+                     "[--validator <glslangValidator>]\n";
+        return 2;
+    }
+
+    const std::filesystem::path directory = ShaderPreprocessor::normalize(positional[0]);
+    const std::filesystem::path output    = positional[1];
+
+    ShaderPreprocessor  preprocessor {directory};
+    std::vector<Shader> shaders;
+
+    try
+    {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+        {
+            if (!entry.is_regular_file() || !isShaderExtension(entry.path().extension().string()))
+            {
+                continue;
+            }
+
+            const std::filesystem::path relative = entry.path().lexically_relative(directory);
+            const std::string key = (directory.filename() / relative).generic_string();
+            shaders.push_back({key, preprocessor.process(entry.path()), entry.path(), entry.file_size()});
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[shader_embed] " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::sort(shaders.begin(), shaders.end(), [](const Shader& a, const Shader& b) { return a.key < b.key; });
+
+    if (optimize)
+    {
+        const GlslOptimizer optimizer;
+        GlslOptimizer::Stats total;
+        for (Shader& shader : shaders)
+        {
+            // Headers meant for #include only have no main() and would lose every function
+            if (!isStageExtension(shader.file.extension().string()))
+            {
+                continue;
+            }
+
+            GlslOptimizer::Stats stats;
+            shader.source = optimizer.optimize(shader.source, &stats);
+            total.inputBytes += stats.inputBytes;
+            total.outputBytes += stats.outputBytes;
+            total.foldedConditionals += stats.foldedConditionals;
+            total.removedFunctions += stats.removedFunctions;
+            total.renamedIdentifiers += stats.renamedIdentifiers;
+        }
+        std::cout << "[shader_embed] optimized " << total.inputBytes << " -> " << total.outputBytes << " bytes, "
+                  << total.foldedConditionals << " conditionals folded, " << total.removedFunctions
+                  << " functions removed, " << total.renamedIdentifiers << " identifiers renamed\n";
+    }
+
+    if (!validator.empty())
+    {
+        const std::filesystem::path scratch = output.parent_path() / "shader_embed_validate";
+        std::filesystem::create_directories(scratch);
+
+        bool valid = true;
+        for (const Shader& shader : shaders)
+        {
+            // Headers meant for #include only are checked through their includers
+            if (isStageExtension(shader.file.extension().string()))
+            {
+                valid = validate(validator, shader, scratch) && valid;
+            }
+        }
+        if (!valid)
+        {
+            return 1;
+        }
+    }
+
+    std::ostringstream out;
+    out << "// Generated by shader_embed from " << directory.generic_string() << ". Do not edit.\n\n"
+        << "#ifndef LEARNOPENGL_EMBEDDED_SHADERS_H\n"
+        << "#define LEARNOPENGL_EMBEDDED_SHADERS_H\n\n"
+        << "#include <cstddef>\n"
+        << "#include <string_view>\n\n"
+        << "namespace EmbeddedShaders\n{\n"
+        << "    struct File\n    {\n"
+        << "        std::string_view path;\n"
+        << "        std::string_view source;\n"
+        << "        std::size_t      fileBytes;\n"
+        << "    };\n\n"
+        << "    // Sorted by path\n"
+        << "    inline constexpr File kFiles[] = {\n";
+    for (const Shader& shader : shaders)
+    {
+        out << "        {\"" << shader.key << "\",";
+        writeLiteral(out, shader.source);
+        out << ",\n        " << shader.fileBytes << "},\n";
+    }
+    if (shaders.empty())
+    {
+        out << "        {\"\", \"\", 0},\n";
+    }
+    out << "    };\n"
+        << "} // namespace EmbeddedShaders\n\n"
+        << "#endif // LEARNOPENGL_EMBEDDED_SHADERS_H\n";
+
+    // Leave the header untouched when nothing changed, so dependents are not rebuilt
+    const std::string text = out.str();
+    {
+        std::ifstream existing(output, std::ios::binary);
+        const std::string previous((std::istreambuf_iterator<char>(existing)), std::istreambuf_iterator<char>());
+        if (previous == text)
+        {
+            return 0;
+        }
+    }
+
+    std::filesystem::create_directories(output.parent_path());
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    file << text;
+    if (!file)
+    {
+        std::cerr << "[shader_embed] failed to write " << output << std::endl;
+        return 1;
+    }
+    return 0;
+}